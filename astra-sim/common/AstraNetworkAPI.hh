@@ -6,6 +6,8 @@ LICENSE file in the root directory of this source tree.
 #ifndef __ASTRA_NETWORK_API_HH__
 #define __ASTRA_NETWORK_API_HH__
 
+#include <vector>
+
 #include "astra-sim/system/Common.hh"
 
 namespace AstraSim {
@@ -51,6 +53,26 @@ class AstraNetworkAPI {
                          void (*msg_handler)(void* fun_arg),
                          void* fun_arg) = 0;
 
+    // 批量发送接口：在同一时刻依次发送 messages 中的所有消息
+    // （peer 为目的节点），效果与按顺序逐条调用 sim_send 相同。
+    // 默认实现逐条调用 sim_send，后端可重写以减少逐条调用的开销。
+    virtual int sim_send_batch(std::vector<sim_message>& messages) {
+        for (auto& msg : messages) {
+            sim_send(msg.buffer, msg.count, msg.type, msg.peer, msg.tag,
+                     &msg.request, msg.msg_handler, msg.fun_arg);
+        }
+        return 0;
+    }
+
+    // 批量接收接口，peer 为源节点，其余同 sim_send_batch
+    virtual int sim_recv_batch(std::vector<sim_message>& messages) {
+        for (auto& msg : messages) {
+            sim_recv(msg.buffer, msg.count, msg.type, msg.peer, msg.tag,
+                     &msg.request, msg.msg_handler, msg.fun_arg);
+        }
+        return 0;
+    }
+
     /*
      * sim_schedule用于在网络后端安排一个事件。
      * delta: 事件相对当前时间的延迟。
@@ -61,6 +83,28 @@ class AstraNetworkAPI {
                               void (*fun_ptr)(void* fun_arg),
                               void* fun_arg) = 0;
 
+    /*
+     * sim_schedule 的整数版本，delta 以纳秒为单位。
+     * 默认实现经由 timespec_t 转换后调用 sim_schedule；后端可重写以避免
+     * 浮点运算。Sys 只通过该接口调度事件。
+     */
+    virtual void sim_schedule_ns(Tick delta,
+                                 void (*fun_ptr)(void* fun_arg),
+                                 void* fun_arg) {
+        sim_schedule(ns_to_timespec(delta), fun_ptr, fun_arg);
+    }
+
+    /*
+     * 截至目前已排入绝对时刻 time_ns 的后端事件总数，包括 sim_schedule
+     * 事件和后端自行安排的消息到达等；所有 rank 共享同一计数。两次查询
+     * 结果相同说明期间没有新事件排入该时刻，Sys 据此把同一时刻的事件
+     * 分派并入已排队的分派事件而不改变事件顺序。无法给出该计数的后端
+     * 返回 -1（默认），Sys 此时只在一次后端回调之内合并。
+     */
+    virtual int64_t sim_scheduled_events_ns(Tick time_ns) {
+        return -1;
+    }
+
     // 获取网络后端类型，默认为未指定
     virtual BackendType get_backend_type() {
         return BackendType::NotSpecified;
@@ -80,11 +124,22 @@ class AstraNetworkAPI {
     // 获取当前模拟的绝对时间（虚函数，需子类实现）
     virtual timespec_t sim_get_time() = 0;
 
+    // 以整数纳秒表示的当前模拟时间，默认由 sim_get_time 转换而来；
+    // 后端可重写以避免浮点运算
+    virtual Tick sim_get_time_ns() {
+        return timespec_to_ns(sim_get_time());
+    }
+
     // 获取指定维度上的带宽，默认实现返回-1，子类可根据需求重写
     virtual double get_BW_at_dimension(int dim) {
         return -1;
     };
 
+    // 获取指定维度上单条链路的延迟（ns），默认返回-1表示未知
+    virtual double get_latency_at_dimension(int dim) {
+        return -1;
+    };
+
     // 通知网络后端当前节点工作负载已完成
     // 每个rank有一个网络处理器实现，当实现此函数时，需确认所有rank均已完成
     virtual void sim_notify_finished(){
@@ -58,6 +58,36 @@ struct timespec_t {
     long double time_val; ///< 时间值，使用长双精度浮点数表示，以提高精度
 };
 
+/**
+ * @brief 将 timespec_t 转换为整数纳秒（Tick）
+ *
+ * 供只实现了 AstraNetworkAPI 中 timespec_t 接口的后端使用。
+ */
+inline Tick timespec_to_ns(const timespec_t& time) {
+    switch (time.time_res) {
+    case SE:
+        return static_cast<Tick>(time.time_val * 1e9);
+    case MS:
+        return static_cast<Tick>(time.time_val * 1e6);
+    case US:
+        return static_cast<Tick>(time.time_val * 1e3);
+    case FS:
+        return static_cast<Tick>(time.time_val / 1e6);
+    default:
+        return static_cast<Tick>(time.time_val);
+    }
+}
+
+/**
+ * @brief 将整数纳秒（Tick）转换为 timespec_t
+ */
+inline timespec_t ns_to_timespec(Tick ns) {
+    timespec_t time;
+    time.time_res = NS;
+    time.time_val = static_cast<long double>(ns);
+    return time;
+}
+
 /**
  * @struct sim_request
  * @brief 存储模拟请求的信息。
@@ -74,6 +104,23 @@ struct sim_request {
     uint32_t layerNum;   ///< 计算层编号（用于标识计算的层次）
 };
 
+/**
+ * @struct sim_message
+ * @brief sim_send_batch() / sim_recv_batch() 中的一条消息。
+ *
+ * 字段与 sim_send() / sim_recv() 的参数一一对应。
+ */
+struct sim_message {
+    void* buffer;                        ///< 数据缓冲区
+    uint64_t count;                      ///< 数据数量
+    int type;                            ///< 数据类型标识
+    int peer;                            ///< 发送时为目的 Rank，接收时为源 Rank
+    int tag;                             ///< 消息标签
+    sim_request request;                 ///< 请求信息
+    void (*msg_handler)(void* fun_arg);  ///< 完成回调
+    void* fun_arg;                       ///< 回调参数
+};
+
 /**
  * @class MetaData
  * @brief 用于存储元数据，例如时间戳。
@@ -125,7 +172,13 @@ enum class CollectiveImplType {
     DoubleBinaryTree,                ///< 双二叉树（Double Binary Tree）
     HalvingDoubling,                 ///< 二分合并（Halving-Doubling）
     OneHalvingDoubling,              ///< 单层二分合并（One Halving-Doubling）
-    ChakraImpl                       ///< 使用 Chakra 框架实现的集合通信
+    ChakraImpl,                      ///< 使用 Chakra 框架实现的集合通信
+    Bruck,                           ///< Bruck All-to-All（log2 N 步）
+    PairwiseExchange,                ///< 成对交换 All-to-All（N-1 步）
+    PipelinedRing,                   ///< 阶段内分片流水的环形拓扑
+    PipelinedDoubleBinaryTree,       ///< 阶段内分片流水的双二叉树
+    InNetworkReduction,              ///< 交换机内归约（类似 SHARP）
+    Auto                             ///< 由 CollectiveTuner 按阶段自动选择
 };
 
 /**
@@ -148,6 +201,15 @@ enum class SchedulingPolicy {
     None          ///< 无调度策略
 };
 
+/**
+ * @enum ChunkSizingPolicy
+ * @brief 定义集合通信切分数据块（chunk）的策略。
+ */
+enum class ChunkSizingPolicy {
+    Fixed = 0,    ///< 按 preferred-dataset-splits 固定切分
+    Adaptive      ///< 根据各维度带宽与集合通信大小自适应切分
+};
+
 /**
  * @enum IntraDimensionScheduling
  * @brief 定义同一维度内的任务调度策略。
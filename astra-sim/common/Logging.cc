@@ -1,5 +1,7 @@
 #include "astra-sim/common/Logging.hh"  // 引入 Logging.hh 头文件
 
+#include <algorithm>  // std::find、std::min
+
 namespace AstraSim {  // 进入 AstraSim 命名空间
 
 /**
@@ -11,19 +13,46 @@ namespace AstraSim {  // 进入 AstraSim 命名空间
  */
 std::unordered_set<spdlog::sink_ptr> LoggerFactory::default_sinks;
 
+std::unordered_map<std::string, std::shared_ptr<spdlog::logger>>
+    LoggerFactory::loggers;
+
+std::unordered_set<std::string> LoggerFactory::own_loggers;
+
+uint64_t LoggerFactory::generation = 1;
+
 /**
  * @brief 获取（或创建）指定名称的 logger。
  * 
  * @param logger_name 要获取的 logger 名称。
  * @return 返回一个 `spdlog::logger` 的共享指针。
  * 
- * 该方法首先检查 `spdlog` 是否已存在指定名称的 logger：
- * - **如果已存在**，直接返回该 logger。
- * - **如果不存在**，则创建一个 **异步的空日志（null_sink_mt）**，并设置日志级别。
+ * 解析结果会被缓存，之后的调用只需一次哈希查找；init()/shutdown()
+ * 会清空缓存。热点路径应使用 LoggerHandle，连哈希查找也可以省去。
+ */
+std::shared_ptr<spdlog::logger> LoggerFactory::get_logger(
+    const std::string& logger_name) {
+    auto it = loggers.find(logger_name);
+    if (it != loggers.end()) {
+        return it->second;
+    }
+    auto logger = resolve_logger(logger_name);
+    loggers.emplace(logger_name, logger);
+    return logger;
+}
+
+/**
+ * @brief 查找或创建 logger，并附加默认的日志输出。
+ *
+ * - **如果 spdlog 中已存在**（例如由配置文件定义），直接使用该 logger。
+ * - **如果不存在**，则创建一个 **异步的空日志（null_sink_mt）**。
  * - 如果 `ENABLE_DEFAULT_SINK_FOR_OTHER_LOGGERS` 设为 `true`，
  *   则会为该 logger **附加默认的日志输出**（如终端、文件）。
+ *
+ * 由这里创建的 logger 的级别设为默认输出中最低的级别（没有默认输出时
+ * 为 off），这样 should_log() 能准确反映消息是否会被输出，
+ * ASTRA_LOG_* 可以跳过不会输出的消息的格式化。
  */
-std::shared_ptr<spdlog::logger> LoggerFactory::get_logger(
+std::shared_ptr<spdlog::logger> LoggerFactory::resolve_logger(
     const std::string& logger_name) {
     constexpr bool ENABLE_DEFAULT_SINK_FOR_OTHER_LOGGERS = true;  // 是否为新创建的 logger 添加默认 sink
 
@@ -32,8 +61,8 @@ std::shared_ptr<spdlog::logger> LoggerFactory::get_logger(
     if (logger == nullptr) {
         // 如果 logger 不存在，则创建一个 "null_sink_mt" 日志（即不会输出任何日志）
         logger = spdlog::create_async<spdlog::sinks::null_sink_mt>(logger_name);
-        logger->set_level(spdlog::level::trace);  // 设置日志级别为 trace（最详细）
         logger->flush_on(spdlog::level::info);    // 在 info 级别时自动刷新日志缓冲
+        own_loggers.insert(logger_name);
     }
 
     // 如果不启用默认 sink，则直接返回 logger
@@ -43,10 +72,15 @@ std::shared_ptr<spdlog::logger> LoggerFactory::get_logger(
 
     // 将默认 sinks 添加到 logger 中（避免重复添加）
     auto& logger_sinks = logger->sinks();
+    auto level = spdlog::level::off;
     for (auto sink : default_sinks) {
         if (std::find(logger_sinks.begin(), logger_sinks.end(), sink) == logger_sinks.end()) {
             logger_sinks.push_back(sink);
         }
+        level = std::min(level, sink->level());
+    }
+    if (own_loggers.count(logger_name) != 0) {
+        logger->set_level(level);
     }
 
     return logger;
@@ -66,6 +100,10 @@ void LoggerFactory::init(const std::string& log_config_path) {
         spdlog_setup::from_file(log_config_path);  // 从指定的配置文件初始化日志
     }
     init_default_components();  // 初始化默认的日志组件
+
+    // 之前解析的 logger 需要重新附加默认输出
+    loggers.clear();
+    generation++;
 }
 
 /**
@@ -78,6 +116,9 @@ void LoggerFactory::init(const std::string& log_config_path) {
  */
 void LoggerFactory::shutdown(void) {
     default_sinks.clear();  // 清空默认的日志输出设备
+    loggers.clear();        // 清空已解析的 logger
+    own_loggers.clear();
+    generation++;
     spdlog::drop_all();     // 删除所有注册的日志器
     spdlog::shutdown();     // 彻底关闭 spdlog
 }
@@ -14,10 +14,58 @@
 #include "spdlog/sinks/stdout_color_sinks.h"  // 控制台日志输出
 #include "spdlog/spdlog.h"                    // spdlog 核心功能
 #include "spdlog_setup/conf.h"                 // 允许从文件加载日志配置
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+
+/**
+ * @brief 编译期保留的最低日志级别（取值为 SPDLOG_LEVEL_*）。
+ *
+ * 低于该级别的 ASTRA_LOG_* 调用在编译期被整体去掉，参数也不会被求值。
+ * Release 构建由 CMake 设为 SPDLOG_LEVEL_DEBUG（trace-enabled 的输出为 debug
+ * 级别），其余构建默认保留全部级别。
+ */
+#ifndef ASTRA_LOG_ACTIVE_LEVEL
+#define ASTRA_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+/**
+ * @brief 仅在 logger 启用该级别时才格式化并输出日志。
+ *
+ * 参数（例如 node->name()）只在级别启用时求值。logger 可以是
+ * LoggerHandle 或 std::shared_ptr<spdlog::logger>。
+ */
+#define ASTRA_LOG(logger, level, ...)                                 \
+    do {                                                              \
+        const auto& astra_log_logger_ = (logger);                     \
+        if (astra_log_logger_->should_log(level)) {                   \
+            astra_log_logger_->log(level, __VA_ARGS__);               \
+        }                                                             \
+    } while (0)
+
+#if ASTRA_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define ASTRA_LOG_TRACE(logger, ...) \
+    ASTRA_LOG(logger, spdlog::level::trace, __VA_ARGS__)
+#else
+#define ASTRA_LOG_TRACE(logger, ...) (void)0
+#endif
+
+#if ASTRA_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define ASTRA_LOG_DEBUG(logger, ...) \
+    ASTRA_LOG(logger, spdlog::level::debug, __VA_ARGS__)
+#else
+#define ASTRA_LOG_DEBUG(logger, ...) (void)0
+#endif
+
+#if ASTRA_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define ASTRA_LOG_INFO(logger, ...) \
+    ASTRA_LOG(logger, spdlog::level::info, __VA_ARGS__)
+#else
+#define ASTRA_LOG_INFO(logger, ...) (void)0
+#endif
 
 namespace AstraSim {
 
@@ -55,16 +103,75 @@ class LoggerFactory {
      */
     static void shutdown(void);
 
+    /**
+     * @brief 日志配置的版本号，每次 init()/shutdown() 时递增。
+     *
+     * LoggerHandle 据此判断缓存的 logger 是否需要重新获取。
+     */
+    static uint64_t get_generation() {
+        return generation;
+    }
+
   private:
     /**
      * @brief 初始化默认日志组件（控制台输出、文件输出等）。
      */
     static void init_default_components();
 
+    /**
+     * @brief 创建或查找 logger，并附加默认输出组件
+     */
+    static std::shared_ptr<spdlog::logger> resolve_logger(
+        const std::string& logger_name);
+
     /**
      * @brief 存储默认的日志输出组件。
      */
     static std::unordered_set<spdlog::sink_ptr> default_sinks;
+
+    /**
+     * @brief 已解析的 logger（名称 -> logger），避免每次都查询 spdlog 注册表。
+     */
+    static std::unordered_map<std::string, std::shared_ptr<spdlog::logger>>
+        loggers;
+
+    /**
+     * @brief 由 LoggerFactory 创建（而非配置文件定义）的 logger 名称。
+     */
+    static std::unordered_set<std::string> own_loggers;
+
+    static uint64_t generation;
+};
+
+/**
+ * @class LoggerHandle
+ * @brief 某个组件的 logger 句柄，只在第一次使用及日志系统重新初始化后
+ *        解析一次 logger。
+ *
+ * 通常定义为源文件中的静态变量，例如
+ * `static LoggerHandle logger("workload");`，然后配合 ASTRA_LOG_* 使用。
+ */
+class LoggerHandle {
+  public:
+    explicit LoggerHandle(std::string logger_name)
+        : logger_name(std::move(logger_name)), generation(0) {}
+
+    const std::shared_ptr<spdlog::logger>& get() const {
+        if (logger == nullptr || generation != LoggerFactory::get_generation()) {
+            logger = LoggerFactory::get_logger(logger_name);
+            generation = LoggerFactory::get_generation();
+        }
+        return logger;
+    }
+
+    spdlog::logger* operator->() const {
+        return get().get();
+    }
+
+  private:
+    std::string logger_name;
+    mutable std::shared_ptr<spdlog::logger> logger;
+    mutable uint64_t generation;
 };
 
 }  // namespace AstraSim
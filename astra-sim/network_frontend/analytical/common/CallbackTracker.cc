@@ -88,6 +88,37 @@ CallbackTrackerEntry* CallbackTracker::create_new_entry(
     return &(entry->second);
 }
 
+/**
+ * @brief 查找指定的回调条目，若不存在则创建新的空条目（仅需一次查找）
+ * @param tag 消息标签
+ * @param src 源节点 ID
+ * @param dest 目标节点 ID
+ * @param chunk_size 数据块大小
+ * @param chunk_id 数据块 ID
+ * @return 返回指向已有或新建 `CallbackTrackerEntry` 的指针
+ */
+CallbackTrackerEntry* CallbackTracker::search_or_create_entry(
+    const int tag,
+    const int src,
+    const int dest,
+    const ChunkSize chunk_size,
+    const int chunk_id) noexcept {
+
+    // 参数合法性检查
+    assert(tag >= 0);
+    assert(src >= 0);
+    assert(dest >= 0);
+    assert(chunk_size > 0);
+    assert(chunk_id >= 0);
+
+    // 生成唯一键值 (tag, src, dest, chunk_size, chunk_id)
+    const auto key = std::make_tuple(tag, src, dest, chunk_size, chunk_id);
+
+    // 已存在则返回原条目，否则原地构造新条目
+    const auto entry = tracker.try_emplace(key).first;
+    return &(entry->second);
+}
+
 /**
  * @brief 删除指定的回调条目
  * @param tag 消息标签
@@ -119,3 +150,11 @@ void CallbackTracker::pop_entry(const int tag,
     // 从 tracker 中删除该条目
     tracker.erase(entry);
 }
+
+/**
+ * @brief 检查是否所有收发都已匹配并完成
+ * @return 没有任何跟踪中的条目时返回 true
+ */
+bool CallbackTracker::empty() const noexcept {
+    return tracker.empty();
+}
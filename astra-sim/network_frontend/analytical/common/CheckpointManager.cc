@@ -0,0 +1,102 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/CheckpointManager.hh"
+#include "astra-sim/common/Logging.hh"
+#include "astra-sim/system/Checkpoint.hh"
+#include "common/CommonNetworkApi.hh"
+
+using namespace AstraSim;
+using namespace AstraSimAnalytical;
+
+/**
+ * @brief CheckpointManager 构造函数
+ * @param event_queue 驱动仿真的事件队列
+ * @param systems 所有 NPU 的 Sys，按 NPU ID 排列
+ * @param workload_configuration 工作负载配置前缀
+ * @param save_path 检查点输出文件，为空表示不保存
+ * @param save_tick 在该时刻之后的第一个静止时刻写出检查点
+ * @param restore_path 用于恢复的检查点文件，为空表示从 0 时刻开始
+ */
+CheckpointManager::CheckpointManager(std::shared_ptr<EventQueue> event_queue,
+                                     std::vector<Sys*> systems,
+                                     std::string workload_configuration,
+                                     std::string save_path,
+                                     const EventTime save_tick,
+                                     std::string restore_path) noexcept
+    : event_queue(std::move(event_queue)),
+      systems(std::move(systems)),
+      workload_configuration(std::move(workload_configuration)),
+      save_path(std::move(save_path)),
+      save_tick(save_tick),
+      restore_path(std::move(restore_path)) {
+    // 已完成节点的列表只在需要写出检查点时记录，避免普通运行的内存开销
+    if (!this->save_path.empty()) {
+        for (auto* const system : this->systems) {
+            system->workload->record_finished_nodes = true;
+        }
+    }
+}
+
+/**
+ * @brief 从检查点恢复，或者从头启动所有 NPU 的 workload
+ */
+void CheckpointManager::start() noexcept {
+    if (restore_path.empty()) {
+        for (auto* const system : systems) {
+            system->workload->fire();
+        }
+        return;
+    }
+
+    const auto checkpoint = Checkpoint(restore_path);
+
+    // 先用一个空事件把时钟推进到检查点时刻，恢复出的事件都在此之后
+    const auto tick = static_cast<EventTime>(checkpoint.get_tick());
+    if (tick > event_queue->get_current_time()) {
+        event_queue->schedule_event(tick, advance_clock, nullptr);
+        event_queue->proceed();
+    }
+
+    checkpoint.restore(systems, workload_configuration);
+}
+
+/**
+ * @brief 运行事件队列直到仿真结束，并在需要时写出检查点
+ */
+void CheckpointManager::run() noexcept {
+    auto save_pending = !save_path.empty();
+
+    while (!event_queue->finished()) {
+        // 两次 proceed() 之间，当前时刻的事件（包括零延迟回调）都已处理完
+        if (save_pending && event_queue->get_current_time() >= save_tick &&
+            is_network_idle() && Checkpoint::is_quiescent(systems)) {
+            Checkpoint::save(save_path, systems, workload_configuration);
+            save_pending = false;
+        }
+        event_queue->proceed();
+    }
+
+    if (save_pending) {
+        LoggerFactory::get_logger("network")
+            ->warn("no quiescent point after tick {}, checkpoint {} is not "
+                   "written",
+                   save_tick, save_path);
+    }
+}
+
+/**
+ * @brief 空事件，仅用于推进时钟
+ * @param arg 未使用
+ */
+void CheckpointManager::advance_clock(void* const arg) noexcept {}
+
+/**
+ * @brief 判断网络后端是否没有未完成的收发
+ * @return 回调追踪器为空时返回 true
+ */
+bool CheckpointManager::is_network_idle() noexcept {
+    return CommonNetworkApi::get_callback_tracker().empty();
+}
@@ -52,7 +52,14 @@ void CmdLineParser::define_options() noexcept {
         ("injection-scale", "Injection scale",
          cxxopts::value<double>()->default_value("1")) // 数据注入速率缩放比例，默认为 1
         ("rendezvous-protocol", "Whether to enable rendezvous protocol",
-         cxxopts::value<bool>()->default_value("false")); // 是否启用 rendezvous 协议，默认为 false
+         cxxopts::value<bool>()->default_value("false")) // 是否启用 rendezvous 协议，默认为 false
+        ("checkpoint-save", "Checkpoint file to write",
+         cxxopts::value<std::string>()->default_value("")) // 检查点输出文件，默认不保存
+        ("checkpoint-tick",
+         "Write the checkpoint at the first quiescent point after this tick",
+         cxxopts::value<uint64_t>()->default_value("0")) // 检查点时刻（ns）
+        ("checkpoint-restore", "Checkpoint file to restore the simulation from",
+         cxxopts::value<std::string>()->default_value("")); // 用于恢复仿真的检查点文件，默认从头开始
 }
 
 /**
@@ -20,10 +20,12 @@ using namespace NetworkAnalytical;
  * 这些变量在所有 `CommonNetworkApi` 实例中共享
  */
 std::shared_ptr<EventQueue> CommonNetworkApi::event_queue = nullptr; // 事件队列指针
+std::map<Tick, int64_t> CommonNetworkApi::scheduled_events; // 各时刻已排入的事件数
 ChunkIdGenerator CommonNetworkApi::chunk_id_generator = {}; // 用于生成数据块唯一 ID
 CallbackTracker CommonNetworkApi::callback_tracker = {}; // 追踪回调事件
 int CommonNetworkApi::dims_count = -1; // 维度数，初始化为 -1
 std::vector<Bandwidth> CommonNetworkApi::bandwidth_per_dim = {}; // 每个维度的带宽存储
+std::vector<Latency> CommonNetworkApi::latency_per_dim = {}; // 每个维度的链路延迟
 
 /**
  * @brief 设置全局事件队列
@@ -37,6 +39,15 @@ void CommonNetworkApi::set_event_queue(
     CommonNetworkApi::event_queue = std::move(event_queue_ptr);
 }
 
+/**
+ * @brief 设置每个维度的链路延迟
+ * @param latencies 每个维度的链路延迟（ns）
+ */
+void CommonNetworkApi::set_latency_per_dim(
+    std::vector<Latency> latencies) noexcept {
+    CommonNetworkApi::latency_per_dim = std::move(latencies);
+}
+
 /**
  * @brief 获取回调追踪器
  * @return 返回全局 CallbackTracker 引用
@@ -79,6 +90,56 @@ void CommonNetworkApi::process_chunk_arrival(void* args) noexcept {
     }
 }
 
+/**
+ * @brief 处理同一时刻到达的一批数据块
+ * @param args 指向 `std::vector<ChunkArrivalArg>` 的指针
+ */
+void CommonNetworkApi::process_chunk_arrivals(void* args) noexcept {
+    assert(args != nullptr);
+
+    auto* const arrivals = static_cast<std::vector<ChunkArrivalArg>*>(args);
+    for (auto& arrival : *arrivals) {
+        process_chunk_arrival(static_cast<void*>(&arrival));
+    }
+    delete arrivals;
+}
+
+/**
+ * @brief 依次调用一组回调函数
+ * @param args 指向 `std::vector<Callback>` 的指针
+ */
+void CommonNetworkApi::invoke_callbacks(void* args) noexcept {
+    assert(args != nullptr);
+
+    auto* const callbacks = static_cast<std::vector<Callback>*>(args);
+    for (const auto& [msg_handler, fun_arg] : *callbacks) {
+        (*msg_handler)(fun_arg);
+    }
+    delete callbacks;
+}
+
+/**
+ * @brief 在回调追踪器中登记发送回调
+ * @return 为该次发送分配的数据块 ID
+ */
+int CommonNetworkApi::register_send(const int tag,
+                                    const int src,
+                                    const int dst,
+                                    const uint64_t count,
+                                    void (*msg_handler)(void*),
+                                    void* const fun_arg) noexcept {
+    // 生成唯一的发送数据块 ID
+    const auto chunk_id =
+        chunk_id_generator.create_send_chunk_id(tag, src, dst, count);
+
+    // 无论接收是否已调用，都只需一次查找即可注册发送回调
+    auto* const entry =
+        callback_tracker.search_or_create_entry(tag, src, dst, count, chunk_id);
+    entry->register_send_callback(msg_handler, fun_arg);
+
+    return chunk_id;
+}
+
 /**
  * @brief CommonNetworkApi 构造函数
  * @param rank 该节点的排名 ID
@@ -93,12 +154,15 @@ CommonNetworkApi::CommonNetworkApi(const int rank) noexcept
  * @return 当前时间，以 ASTRA-sim 格式表示
  */
 timespec_t CommonNetworkApi::sim_get_time() {
-    // 获取当前事件队列时间
-    const auto current_time = event_queue->get_current_time();
+    return ns_to_timespec(sim_get_time_ns());
+}
 
-    // 转换时间格式并返回
-    const auto astra_sim_time = static_cast<double>(current_time);
-    return {NS, astra_sim_time};
+/**
+ * @brief 获取当前的仿真时间（整数纳秒）
+ * @return 事件队列的当前时间
+ */
+Tick CommonNetworkApi::sim_get_time_ns() {
+    return event_queue->get_current_time();
 }
 
 /**
@@ -111,18 +175,41 @@ void CommonNetworkApi::sim_schedule(const timespec_t delta,
                                     void (*fun_ptr)(void*),
                                     void* const fun_arg) {
     assert(delta.time_res == NS); // 确保时间单位是纳秒
-    assert(fun_ptr != nullptr); // 确保函数指针有效
+    sim_schedule_ns(timespec_to_ns(delta), fun_ptr, fun_arg);
+}
 
-    // 计算事件的绝对触发时间
-    const auto current_time = sim_get_time();
-    const auto event_time = current_time.time_val + delta.time_val;
-    const auto event_time_ns = static_cast<EventTime>(event_time);
+/**
+ * @brief 调度事件
+ * @param delta 事件触发的时间间隔（纳秒）
+ * @param fun_ptr 事件回调函数指针
+ * @param fun_arg 事件回调函数参数
+ */
+void CommonNetworkApi::sim_schedule_ns(const Tick delta,
+                                       void (*fun_ptr)(void*),
+                                       void* const fun_arg) {
+    assert(fun_ptr != nullptr); // 确保函数指针有效
 
-    // 确保事件时间不早于当前时间
-    assert(event_time_ns >= event_queue->get_current_time());
+    // 计算事件的绝对触发时间，整数运算，不会晚于当前时间
+    const auto event_time_ns = event_queue->get_current_time() + delta;
 
     // 将事件加入事件队列
     event_queue->schedule_event(event_time_ns, fun_ptr, fun_arg);
+
+    // 记录该时刻排入的事件数，已经过去的时刻不再需要
+    scheduled_events.erase(
+        scheduled_events.begin(),
+        scheduled_events.lower_bound(event_queue->get_current_time()));
+    scheduled_events[event_time_ns]++;
+}
+
+/**
+ * @brief 查询经由 sim_schedule_ns 排入指定时刻的事件数
+ * @param time_ns 事件的绝对时刻（纳秒）
+ * @return 已排入该时刻的事件数
+ */
+int64_t CommonNetworkApi::scheduled_events_at(const Tick time_ns) noexcept {
+    const auto it = scheduled_events.find(time_ns);
+    return it == scheduled_events.end() ? 0 : it->second;
 }
 
 /**
@@ -162,8 +249,7 @@ int CommonNetworkApi::sim_recv(void* const buffer,
             callback_tracker.pop_entry(tag, src, dst, count, chunk_id);
 
             // 调度回调
-            const auto delta = timespec_t{NS, 0};
-            sim_schedule(delta, msg_handler, fun_arg);
+            sim_schedule_ns(0, msg_handler, fun_arg);
         } else {
             // 传输未完成，注册接收回调
             entry.value()->register_recv_callback(msg_handler, fun_arg);
@@ -178,6 +264,43 @@ int CommonNetworkApi::sim_recv(void* const buffer,
     return 0; // 返回成功状态
 }
 
+/**
+ * @brief 批量接收数据
+ *
+ * 与逐条调用 `sim_recv()` 等价；其中数据已经到达的接收不再各自调度
+ * 一个零延迟事件，而是合并为一个事件按顺序触发回调。
+ *
+ * @param messages 待接收的消息（peer 为源节点）
+ * @return 操作状态
+ */
+int CommonNetworkApi::sim_recv_batch(std::vector<sim_message>& messages) {
+    const auto dst = sim_comm_get_rank();
+    auto ready = std::make_unique<std::vector<Callback>>();
+
+    for (const auto& msg : messages) {
+        const auto src = msg.peer;
+        const auto chunk_id = chunk_id_generator.create_recv_chunk_id(
+            msg.tag, src, dst, msg.count);
+
+        auto* const entry = callback_tracker.search_or_create_entry(
+            msg.tag, src, dst, msg.count, chunk_id);
+        if (entry->is_transmission_finished()) {
+            // 传输已完成，回调在批量事件中触发
+            callback_tracker.pop_entry(msg.tag, src, dst, msg.count, chunk_id);
+            ready->emplace_back(msg.msg_handler, msg.fun_arg);
+        } else {
+            entry->register_recv_callback(msg.msg_handler, msg.fun_arg);
+        }
+    }
+
+    if (!ready->empty()) {
+        sim_schedule_ns(0, CommonNetworkApi::invoke_callbacks,
+                        static_cast<void*>(ready.release()));
+    }
+
+    return 0;
+}
+
 /**
  * @brief 获取指定维度的带宽
  * @param dim 维度索引
@@ -189,3 +312,17 @@ double CommonNetworkApi::get_BW_at_dimension(const int dim) {
     // 返回指定维度的带宽
     return bandwidth_per_dim[dim];
 }
+
+/**
+ * @brief 获取指定维度的链路延迟
+ * @param dim 维度索引
+ * @return 该维度的链路延迟（ns），未设置时返回 -1
+ */
+double CommonNetworkApi::get_latency_at_dimension(const int dim) {
+    assert(0 <= dim && dim < dims_count); // 确保维度索引合法
+
+    if (static_cast<size_t>(dim) >= latency_per_dim.size()) {
+        return -1;
+    }
+    return latency_per_dim[dim];
+}
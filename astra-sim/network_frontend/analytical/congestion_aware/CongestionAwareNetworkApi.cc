@@ -73,23 +73,9 @@ int CongestionAwareNetworkApi::sim_send(void* const buffer,
     // 获取当前节点 ID（源节点）
     const auto src = sim_comm_get_rank();
 
-    // 生成唯一的发送数据块 ID
+    // 生成唯一的发送数据块 ID，并在回调追踪器中注册发送回调
     const auto chunk_id =
-        CongestionAwareNetworkApi::chunk_id_generator.create_send_chunk_id(
-            tag, src, dst, count);
-
-    // 在回调追踪器中查找该数据块的回调条目
-    const auto entry =
-        callback_tracker.search_entry(tag, src, dst, count, chunk_id);
-    if (entry.has_value()) {
-        // 如果接收操作已经被调用，则直接注册发送回调
-        entry.value()->register_send_callback(msg_handler, fun_arg);
-    } else {
-        // 如果接收操作尚未调用，则创建新的条目，并注册发送回调
-        auto* const new_entry =
-            callback_tracker.create_new_entry(tag, src, dst, count, chunk_id);
-        new_entry->register_send_callback(msg_handler, fun_arg);
-    }
+        register_send(tag, src, dst, count, msg_handler, fun_arg);
 
     // 创建数据块传输参数
     auto chunk_arrival_arg = std::tuple(tag, src, dst, count, chunk_id);
@@ -109,3 +95,37 @@ int CongestionAwareNetworkApi::sim_send(void* const buffer,
 
     return 0; // 返回成功状态
 }
+
+/**
+ * @brief 批量发送数据
+ *
+ * 先在一次遍历中把所有回调登记到回调追踪器，再按顺序把数据块交给
+ * 拓扑；拥塞由拓扑中的链路模型处理，因此每个数据块仍单独注入。
+ *
+ * @param messages 待发送的消息（peer 为目标节点）
+ * @return 操作状态（0 表示成功）
+ */
+int CongestionAwareNetworkApi::sim_send_batch(
+    std::vector<sim_message>& messages) {
+    const auto src = sim_comm_get_rank();
+
+    std::vector<int> chunk_ids;
+    chunk_ids.reserve(messages.size());
+    for (const auto& msg : messages) {
+        chunk_ids.push_back(register_send(msg.tag, src, msg.peer, msg.count,
+                                          msg.msg_handler, msg.fun_arg));
+    }
+
+    for (size_t i = 0; i < messages.size(); i++) {
+        const auto& msg = messages[i];
+        auto* const arg = new ChunkArrivalArg(msg.tag, src, msg.peer,
+                                              msg.count, chunk_ids[i]);
+        auto chunk = std::make_unique<Chunk>(
+            msg.count, topology->route(src, msg.peer),
+            CongestionAwareNetworkApi::process_chunk_arrival,
+            static_cast<void*>(arg));
+        topology->send(std::move(chunk));
+    }
+
+    return 0;
+}
@@ -73,23 +73,9 @@ int CongestionUnawareNetworkApi::sim_send(void* const buffer,
     // 获取当前节点 ID（源节点）
     const auto src = sim_comm_get_rank();
 
-    // 生成唯一的发送数据块 ID
+    // 生成唯一的发送数据块 ID，并在回调追踪器中注册发送回调
     const auto chunk_id =
-        CongestionUnawareNetworkApi::chunk_id_generator.create_send_chunk_id(
-            tag, src, dst, count);
-
-    // 在回调追踪器中查找该数据块的回调条目
-    const auto entry =
-        callback_tracker.search_entry(tag, src, dst, count, chunk_id);
-    if (entry.has_value()) {
-        // 如果 `recv` 操作已经被调用，则直接注册发送回调
-        entry.value()->register_send_callback(msg_handler, fun_arg);
-    } else {
-        // 如果 `recv` 操作尚未调用，则创建新的条目，并注册发送回调
-        auto* const new_entry =
-            callback_tracker.create_new_entry(tag, src, dst, count, chunk_id);
-        new_entry->register_send_callback(msg_handler, fun_arg);
-    }
+        register_send(tag, src, dst, count, msg_handler, fun_arg);
 
     // 创建数据块传输参数
     auto chunk_arrival_arg = std::tuple(tag, src, dst, count, chunk_id);
@@ -98,12 +84,71 @@ int CongestionUnawareNetworkApi::sim_send(void* const buffer,
 
     // 计算发送通信延迟（单位：纳秒，符合 AstraSim 时间格式）
     const auto send_delay_ns = topology->send(src, dst, count); // 获取拓扑发送延迟
-    const auto send_delay = static_cast<double>(send_delay_ns);
-    const auto delta = timespec_t({NS, send_delay}); // 生成时间间隔对象
 
-    // 发送完成后，在 `send_delay` 之后触发 `process_chunk_arrival` 事件
-    sim_schedule(delta, CongestionUnawareNetworkApi::process_chunk_arrival,
-                 arg_ptr);
+    // 发送完成后，在 `send_delay_ns` 之后触发 `process_chunk_arrival` 事件
+    sim_schedule_ns(send_delay_ns,
+                    CongestionUnawareNetworkApi::process_chunk_arrival,
+                    arg_ptr);
 
     return 0; // 返回成功状态
 }
+
+/**
+ * @brief 批量发送数据（非拥塞感知）
+ *
+ * 所有消息的回调在一次遍历中登记到回调追踪器；到达时间相同的消息
+ * 只调度一个事件，在该事件中按发送顺序依次处理。
+ *
+ * @param messages 待发送的消息（peer 为目标节点）
+ * @return 操作状态（0 表示成功）
+ */
+int CongestionUnawareNetworkApi::sim_send_batch(
+    std::vector<sim_message>& messages) {
+    const auto src = sim_comm_get_rank();
+
+    // (发送延迟, 该时刻到达的数据块)，一个批次中不同的延迟通常很少
+    std::vector<std::pair<EventTime, std::vector<ChunkArrivalArg>*>> arrivals;
+
+    for (const auto& msg : messages) {
+        const auto dst = msg.peer;
+        const auto chunk_id =
+            register_send(msg.tag, src, dst, msg.count, msg.msg_handler,
+                          msg.fun_arg);
+        const auto send_delay_ns = topology->send(src, dst, msg.count);
+
+        std::vector<ChunkArrivalArg>* group = nullptr;
+        for (auto& [delay, chunks] : arrivals) {
+            if (delay == send_delay_ns) {
+                group = chunks;
+                break;
+            }
+        }
+        if (group == nullptr) {
+            group = new std::vector<ChunkArrivalArg>();
+            arrivals.emplace_back(send_delay_ns, group);
+        }
+        group->emplace_back(msg.tag, src, dst, msg.count, chunk_id);
+    }
+
+    for (const auto& [send_delay_ns, chunks] : arrivals) {
+        sim_schedule_ns(send_delay_ns,
+                        CongestionUnawareNetworkApi::process_chunk_arrivals,
+                        static_cast<void*>(chunks));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 查询已排入指定时刻的事件数
+ *
+ * 该后端的所有事件（包括数据块到达）都经由 sim_schedule_ns 调度，
+ * 因此该计数是完整的。
+ *
+ * @param time_ns 事件的绝对时刻（纳秒）
+ * @return 已排入该时刻的事件数
+ */
+int64_t CongestionUnawareNetworkApi::sim_scheduled_events_ns(
+    const Tick time_ns) {
+    return scheduled_events_at(time_ns);
+}
@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "astra-sim/common/Logging.hh" // 日志管理
+#include "common/CheckpointManager.hh" // 检查点保存与恢复
 #include "common/CmdLineParser.hh" // 解析命令行参数
 #include "congestion_unaware/CongestionUnawareNetworkApi.hh" // 非拥塞感知网络 API
 #include <astra-network-analytical/common/EventQueue.h> // 事件队列管理
@@ -49,6 +50,12 @@ int main(int argc, char* argv[]) {
     const auto injection_scale = cmd_line_parser.get<double>("injection-scale"); // 数据注入速率
     const auto rendezvous_protocol =
         cmd_line_parser.get<bool>("rendezvous-protocol"); // 是否启用 rendezvous 协议
+    const auto checkpoint_save =
+        cmd_line_parser.get<std::string>("checkpoint-save"); // 检查点输出文件
+    const auto checkpoint_tick =
+        cmd_line_parser.get<uint64_t>("checkpoint-tick"); // 检查点时刻
+    const auto checkpoint_restore =
+        cmd_line_parser.get<std::string>("checkpoint-restore"); // 用于恢复的检查点文件
 
     // 初始化日志系统
     AstraSim::LoggerFactory::init(logging_configuration);
@@ -68,6 +75,8 @@ int main(int argc, char* argv[]) {
     // 设置非拥塞感知网络 API
     CongestionUnawareNetworkApi::set_event_queue(event_queue);
     CongestionUnawareNetworkApi::set_topology(topology);
+    CongestionUnawareNetworkApi::set_latency_per_dim(
+        network_parser.get_latencies_per_dim());
 
     // 创建 ASTRA-sim 相关资源
     auto network_apis =
@@ -97,15 +106,13 @@ int main(int argc, char* argv[]) {
         systems.push_back(system);
     }
 
-    // 触发所有 `Sys` 实例的 workload
-    for (int i = 0; i < npus_count; i++) {
-        systems[i]->workload->fire();
-    }
-
-    // 运行 ASTRA-sim 仿真，事件队列驱动整个仿真进程
-    while (!event_queue->finished()) {
-        event_queue->proceed();
-    }
+    // 触发所有 `Sys` 实例的 workload（或从检查点恢复），
+    // 然后由事件队列驱动整个仿真进程
+    auto checkpoint_manager =
+        CheckpointManager(event_queue, systems, workload_configuration,
+                          checkpoint_save, checkpoint_tick, checkpoint_restore);
+    checkpoint_manager.start();
+    checkpoint_manager.run();
 
     // 终止仿真
     AstraSim::LoggerFactory::shutdown();
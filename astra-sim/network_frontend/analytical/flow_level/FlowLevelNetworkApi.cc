@@ -0,0 +1,100 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "flow_level/FlowLevelNetworkApi.hh" // 流级网络 API 头文件
+#include <cassert> // 断言库，用于运行时检查
+
+using namespace AstraSim;
+using namespace AstraSimAnalytical;
+using namespace AstraSimAnalyticalFlowLevel;
+using namespace NetworkAnalytical;
+
+/**
+ * @class FlowLevelNetworkApi
+ * @brief 该类继承自 `CommonNetworkApi`，把每条消息作为一个流交给
+ * `FlowNetwork`，由其按 max-min 公平共享链路带宽。
+ */
+
+/**
+ * @brief 静态变量定义
+ * `network` 在所有 `FlowLevelNetworkApi` 实例间共享。
+ */
+std::shared_ptr<FlowNetwork> FlowLevelNetworkApi::network;
+
+/**
+ * @brief 设置流级网络
+ * @param network_ptr 指向 `FlowNetwork` 对象的共享指针
+ */
+void FlowLevelNetworkApi::set_network(
+    std::shared_ptr<FlowNetwork> network_ptr) noexcept {
+    assert(network_ptr != nullptr); // 确保网络对象指针不为空
+
+    FlowLevelNetworkApi::network = std::move(network_ptr);
+
+    // 设置基于拓扑的网络参数
+    FlowLevelNetworkApi::dims_count = network->get_dims_count();
+    FlowLevelNetworkApi::bandwidth_per_dim = network->get_bandwidth_per_dim();
+}
+
+/**
+ * @brief 构造函数
+ * @param rank 当前节点的 ID
+ */
+FlowLevelNetworkApi::FlowLevelNetworkApi(const int rank) noexcept
+    : CommonNetworkApi(rank) {
+    assert(rank >= 0); // 确保 rank 合法
+}
+
+/**
+ * @brief 发送数据：注册发送回调，并把消息作为一个流注入网络
+ * @return 操作状态（0 表示成功）
+ */
+int FlowLevelNetworkApi::sim_send(void* const buffer,
+                                  const uint64_t count,
+                                  const int type,
+                                  const int dst,
+                                  const int tag,
+                                  sim_request* const request,
+                                  void (*msg_handler)(void*),
+                                  void* const fun_arg) {
+    // 获取当前节点 ID（源节点）
+    const auto src = sim_comm_get_rank();
+
+    // 生成唯一的发送数据块 ID，并在回调追踪器中注册发送回调
+    const auto chunk_id =
+        register_send(tag, src, dst, count, msg_handler, fun_arg);
+
+    // 流完成后触发 `process_chunk_arrival`
+    auto* const arg = new ChunkArrivalArg(tag, src, dst, count, chunk_id);
+    network->add_flow({src, dst, count,
+                       FlowLevelNetworkApi::process_chunk_arrival,
+                       static_cast<void*>(arg)});
+
+    return 0; // 返回成功状态
+}
+
+/**
+ * @brief 批量发送数据，整批流只触发一次速率重新计算
+ * @param messages 待发送的消息（peer 为目标节点）
+ * @return 操作状态（0 表示成功）
+ */
+int FlowLevelNetworkApi::sim_send_batch(std::vector<sim_message>& messages) {
+    const auto src = sim_comm_get_rank();
+
+    std::vector<FlowNetwork::FlowRequest> requests;
+    requests.reserve(messages.size());
+    for (const auto& msg : messages) {
+        const auto chunk_id = register_send(msg.tag, src, msg.peer, msg.count,
+                                            msg.msg_handler, msg.fun_arg);
+        auto* const arg =
+            new ChunkArrivalArg(msg.tag, src, msg.peer, msg.count, chunk_id);
+        requests.push_back({src, msg.peer, msg.count,
+                            FlowLevelNetworkApi::process_chunk_arrival,
+                            static_cast<void*>(arg)});
+    }
+    network->add_flows(requests);
+
+    return 0;
+}
@@ -0,0 +1,400 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "flow_level/FlowNetwork.hh" // 流级网络模型
+#include <algorithm> // std::find
+#include <cassert> // 断言库，用于运行时检查
+#include <cmath> // std::ceil
+#include <functional> // std::greater
+#include <limits> // std::numeric_limits
+#include <queue> // std::priority_queue
+
+using namespace NetworkAnalytical;
+using namespace AstraSimAnalyticalFlowLevel;
+
+namespace {
+
+/**
+ * @brief 将带宽从 GB/s 转换为 B/ns（与分析型后端的换算方式一致）
+ */
+double bw_GBps_to_Bpns(const Bandwidth bw_GBps) noexcept {
+    return bw_GBps * static_cast<double>(1 << 30) / 1'000'000'000;
+}
+
+}  // namespace
+
+/**
+ * @brief 构造函数，读取与其他分析型后端相同的网络配置
+ * @param network_parser 解析后的网络配置
+ * @param event_queue 驱动仿真的事件队列
+ */
+FlowNetwork::FlowNetwork(const NetworkParser& network_parser,
+                         std::shared_ptr<EventQueue> event_queue) noexcept
+    : event_queue(std::move(event_queue)),
+      epoch(0) {
+    assert(this->event_queue != nullptr);
+
+    dims_count = network_parser.get_dims_count();
+    npus_count_per_dim = network_parser.get_npus_counts_per_dim();
+    bandwidth_per_dim = network_parser.get_bandwidths_per_dim();
+    latency_per_dim = network_parser.get_latencies_per_dim();
+    topology_per_dim = network_parser.get_topologies_per_dim();
+
+    // NPU ID 按维度展开：第 d 维坐标为 (id / stride_d) % npus_count_per_dim[d]
+    npus_count = 1;
+    for (auto dim = 0; dim < dims_count; dim++) {
+        stride_per_dim.push_back(npus_count);
+        npus_count *= npus_count_per_dim[dim];
+    }
+
+    // 交换机节点的 ID 排在所有 NPU 之后
+    next_switch_id = npus_count;
+}
+
+int FlowNetwork::get_npus_count() const noexcept {
+    return npus_count;
+}
+
+int FlowNetwork::get_dims_count() const noexcept {
+    return dims_count;
+}
+
+std::vector<int> FlowNetwork::get_npus_count_per_dim() const noexcept {
+    return npus_count_per_dim;
+}
+
+std::vector<Bandwidth> FlowNetwork::get_bandwidth_per_dim() const noexcept {
+    return bandwidth_per_dim;
+}
+
+/**
+ * @brief 查找两个节点之间的单向链路，不存在时按需创建
+ *
+ * 链路只在第一次被路由使用时创建，因此全连接维度不会预先分配
+ * O(N^2) 条链路。
+ */
+int FlowNetwork::get_link(const int from, const int to, const int dim) noexcept {
+    const auto key = (static_cast<uint64_t>(from) << 32) |
+                     static_cast<uint64_t>(static_cast<uint32_t>(to));
+    const auto it = link_ids.find(key);
+    if (it != link_ids.end()) {
+        return it->second;
+    }
+
+    const auto id = static_cast<int>(links.size());
+    links.push_back(
+        {bw_GBps_to_Bpns(bandwidth_per_dim[dim]), latency_per_dim[dim], {}});
+    link_mark.push_back(0);
+    residual.push_back(0);
+    unfixed.push_back(0);
+    link_ids.emplace(key, id);
+    return id;
+}
+
+/**
+ * @brief 获取 `npu` 所在的第 `dim` 维分组的交换机节点
+ */
+int FlowNetwork::get_switch(const int npu, const int dim) noexcept {
+    const auto stride = stride_per_dim[dim];
+    const auto coord = (npu / stride) % npus_count_per_dim[dim];
+    const auto key = std::make_pair(dim, npu - coord * stride);
+    const auto it = switch_ids.find(key);
+    if (it != switch_ids.end()) {
+        return it->second;
+    }
+    const auto id = next_switch_id++;
+    switch_ids.emplace(key, id);
+    return id;
+}
+
+/**
+ * @brief 按维度从低到高计算 `src` 到 `dest` 的路由
+ */
+void FlowNetwork::build_route(const int src,
+                              const int dest,
+                              std::vector<int>& route) noexcept {
+    auto current = src;
+    for (auto dim = 0; dim < dims_count; dim++) {
+        const auto stride = stride_per_dim[dim];
+        const auto size = npus_count_per_dim[dim];
+        auto current_coord = (current / stride) % size;
+        const auto dest_coord = (dest / stride) % size;
+        if (current_coord == dest_coord) {
+            continue;
+        }
+
+        switch (topology_per_dim[dim]) {
+        case TopologyBuildingBlock::Ring: {
+            // 双向环，选择跳数较少的方向
+            const auto forward = (dest_coord - current_coord + size) % size;
+            const auto step = (forward <= size - forward) ? 1 : -1;
+            while (current_coord != dest_coord) {
+                const auto next_coord = (current_coord + step + size) % size;
+                const auto next = current + (next_coord - current_coord) * stride;
+                route.push_back(get_link(current, next, dim));
+                current = next;
+                current_coord = next_coord;
+            }
+            break;
+        }
+        case TopologyBuildingBlock::FullyConnected: {
+            // 每对 NPU 之间有一条直连链路
+            const auto next = current + (dest_coord - current_coord) * stride;
+            route.push_back(get_link(current, next, dim));
+            current = next;
+            break;
+        }
+        case TopologyBuildingBlock::Switch: {
+            // 上行链路到交换机，再经下行链路到目标 NPU
+            const auto switch_id = get_switch(current, dim);
+            const auto next = current + (dest_coord - current_coord) * stride;
+            route.push_back(get_link(current, switch_id, dim));
+            route.push_back(get_link(switch_id, next, dim));
+            current = next;
+            break;
+        }
+        default:
+            // 不支持的拓扑类型
+            assert(false);
+        }
+    }
+    assert(current == dest);
+}
+
+/**
+ * @brief 从流池中取出一个空闲的流
+ */
+int FlowNetwork::allocate_flow() noexcept {
+    if (!free_flows.empty()) {
+        const auto id = free_flows.back();
+        free_flows.pop_back();
+        return id;
+    }
+    flows.emplace_back();
+    flow_mark.push_back(0);
+    return static_cast<int>(flows.size()) - 1;
+}
+
+/**
+ * @brief 在当前时刻注入一个流
+ */
+void FlowNetwork::add_flow(const FlowRequest& request) noexcept {
+    add_flows({request});
+}
+
+/**
+ * @brief 在当前时刻注入一批流，整批只重新计算一次速率
+ */
+void FlowNetwork::add_flows(const std::vector<FlowRequest>& requests) noexcept {
+    const auto now = event_queue->get_current_time();
+    std::vector<int> seed_links;
+
+    for (const auto& request : requests) {
+        assert(0 <= request.src && request.src < npus_count);
+        assert(0 <= request.dest && request.dest < npus_count);
+        assert(request.size > 0);
+
+        // 发给自身的消息不经过任何链路，直接送达
+        if (request.src == request.dest) {
+            event_queue->schedule_event(now, request.callback,
+                                        request.callback_arg);
+            continue;
+        }
+
+        const auto id = allocate_flow();
+        auto& flow = flows[id];
+        flow.route.clear();
+        build_route(request.src, request.dest, flow.route);
+        flow.remaining = static_cast<double>(request.size);
+        flow.rate = 0;
+        flow.last_update = now;
+        flow.finish_time = std::numeric_limits<EventTime>::max();
+        flow.latency = 0;
+        flow.callback = request.callback;
+        flow.callback_arg = request.callback_arg;
+
+        for (const auto link : flow.route) {
+            flow.latency += links[link].latency;
+            links[link].flows.push_back(id);
+            seed_links.push_back(link);
+        }
+    }
+
+    if (!seed_links.empty()) {
+        reallocate(seed_links);
+    }
+}
+
+/**
+ * @brief 重新计算与 `seed_links` 相连的所有流的速率（max-min 公平）
+ *
+ * 先沿“链路-流”二部图找出受影响的连通分量，只有这些流的速率会变化；
+ * 再用渐进填充求解：每次取当前公平份额最小的瓶颈链路，把经过它且
+ * 尚未确定速率的流固定为该份额。份额只会单调增加，因此用惰性最小堆
+ * 维护各链路的份额，过期的堆元素直接跳过。
+ */
+void FlowNetwork::reallocate(const std::vector<int>& seed_links) noexcept {
+    const auto now = event_queue->get_current_time();
+
+    // 1. 找出受影响的链路和流
+    const auto visit_epoch = ++epoch;
+    std::vector<int> component_links;
+    std::vector<int> component_flows;
+    for (const auto link : seed_links) {
+        if (link_mark[link] != visit_epoch) {
+            link_mark[link] = visit_epoch;
+            component_links.push_back(link);
+        }
+    }
+    for (size_t i = 0; i < component_links.size(); i++) {
+        for (const auto flow_id : links[component_links[i]].flows) {
+            if (flow_mark[flow_id] == visit_epoch) {
+                continue;
+            }
+            flow_mark[flow_id] = visit_epoch;
+            component_flows.push_back(flow_id);
+            for (const auto link : flows[flow_id].route) {
+                if (link_mark[link] != visit_epoch) {
+                    link_mark[link] = visit_epoch;
+                    component_links.push_back(link);
+                }
+            }
+        }
+    }
+
+    // 2. 按旧速率推进到当前时刻
+    for (const auto flow_id : component_flows) {
+        auto& flow = flows[flow_id];
+        if (flow.rate > 0) {
+            const auto elapsed = static_cast<double>(now - flow.last_update);
+            flow.remaining = std::max(0.0, flow.remaining - flow.rate * elapsed);
+            finish_times.erase({flow.finish_time, flow_id});
+        }
+        flow.last_update = now;
+    }
+
+    // 3. 渐进填充
+    using Share = std::pair<double, int>;
+    std::priority_queue<Share, std::vector<Share>, std::greater<Share>> shares;
+    for (const auto link : component_links) {
+        residual[link] = links[link].capacity;
+        unfixed[link] = static_cast<int>(links[link].flows.size());
+        if (unfixed[link] > 0) {
+            shares.emplace(residual[link] / unfixed[link], link);
+        }
+    }
+
+    const auto fixed_epoch = ++epoch;
+    // 份额单调不减；浮点误差可能让剩余带宽略低于 0，份额被截成 0，
+    // 此时沿用上一个瓶颈的份额
+    double last_share = 0;
+    while (!shares.empty()) {
+        const auto [share, link] = shares.top();
+        shares.pop();
+        if (unfixed[link] == 0 ||
+            share != std::max(0.0, residual[link]) / unfixed[link]) {
+            // 过期的份额
+            continue;
+        }
+        for (const auto flow_id : links[link].flows) {
+            if (flow_mark[flow_id] == fixed_epoch) {
+                continue;
+            }
+            flow_mark[flow_id] = fixed_epoch;
+            last_share = std::max(last_share, share);
+            flows[flow_id].rate = last_share;
+            for (const auto other : flows[flow_id].route) {
+                residual[other] -= last_share;
+                unfixed[other]--;
+                if (unfixed[other] > 0) {
+                    shares.emplace(
+                        std::max(0.0, residual[other]) / unfixed[other], other);
+                }
+            }
+        }
+    }
+
+    // 4. 按新速率更新完成时间
+    // 速率为 0（带宽为 0 的链路）或完成时间超出时间范围的流暂不调度，
+    // 下次重新计算其所在链路的速率时再更新
+    for (const auto flow_id : component_flows) {
+        auto& flow = flows[flow_id];
+        flow.finish_time = std::numeric_limits<EventTime>::max();
+        if (flow.rate <= 0) {
+            flow.rate = 0;
+            continue;
+        }
+        const auto duration = std::ceil(flow.remaining / flow.rate);
+        if (duration >= static_cast<double>(flow.finish_time - now)) {
+            flow.rate = 0;
+            continue;
+        }
+        flow.finish_time = now + static_cast<EventTime>(duration);
+        finish_times.emplace(flow.finish_time, flow_id);
+    }
+
+    if (!finish_times.empty()) {
+        schedule_wake_up(finish_times.begin()->first);
+    }
+}
+
+/**
+ * @brief 在指定时刻调度一次唤醒（同一时刻只调度一次）
+ */
+void FlowNetwork::schedule_wake_up(const EventTime time) noexcept {
+    if (wake_ups.insert(time).second) {
+        event_queue->schedule_event(time, FlowNetwork::wake_up,
+                                    static_cast<void*>(this));
+    }
+}
+
+/**
+ * @brief 唤醒回调，处理当前时刻完成的流
+ */
+void FlowNetwork::wake_up(void* const network) noexcept {
+    assert(network != nullptr);
+    static_cast<FlowNetwork*>(network)->process_finished_flows();
+}
+
+/**
+ * @brief 移除当前时刻完成传输的流，并在路径时延之后通知接收方
+ *
+ * 速率变化后之前调度的唤醒可能已过期，此时没有流完成，只需按最早
+ * 的完成时间重新调度。
+ */
+void FlowNetwork::process_finished_flows() noexcept {
+    const auto now = event_queue->get_current_time();
+    wake_ups.erase(now);
+
+    std::vector<int> seed_links;
+    while (!finish_times.empty() && finish_times.begin()->first <= now) {
+        const auto flow_id = finish_times.begin()->second;
+        finish_times.erase(finish_times.begin());
+
+        auto& flow = flows[flow_id];
+        for (const auto link : flow.route) {
+            auto& link_flows = links[link].flows;
+            const auto it =
+                std::find(link_flows.begin(), link_flows.end(), flow_id);
+            assert(it != link_flows.end());
+            *it = link_flows.back();
+            link_flows.pop_back();
+            seed_links.push_back(link);
+        }
+
+        // 最后一个字节在路径时延之后到达目的节点
+        const auto arrival = now + static_cast<EventTime>(flow.latency);
+        event_queue->schedule_event(arrival, flow.callback, flow.callback_arg);
+
+        flow.rate = 0;
+        free_flows.push_back(flow_id);
+    }
+
+    if (!seed_links.empty()) {
+        reallocate(seed_links);
+    } else if (!finish_times.empty()) {
+        schedule_wake_up(finish_times.begin()->first);
+    }
+}
@@ -55,6 +55,24 @@ class CallbackTracker {
                                            ChunkSize chunk_size,
                                            int chunk_id) noexcept;
 
+    /**
+     * Search the entry identified by (tag, src, dest, chunk_size, chunk_id)
+     * tuple, creating an empty one if it does not exist yet. This needs a
+     * single map lookup instead of search_entry() + create_new_entry().
+     *
+     * @param tag tag of the sim_send() or sim_recv() call
+     * @param src src NPU ID of the sim_send() or sim_recv() call
+     * @param dest dest NPU ID of the sim_send() or sim_recv() call
+     * @param chunk_size chunk size of the sim_send() or sim_recv() call
+     * @param chunk_id id of the chunk
+     * @return the existing or created entry
+     */
+    CallbackTrackerEntry* search_or_create_entry(int tag,
+                                                 int src,
+                                                 int dest,
+                                                 ChunkSize chunk_size,
+                                                 int chunk_id) noexcept;
+
     /**
      * Remove the entry identified by (tag, src, dest, chunk_size, chunk_id)
      * tuple.
@@ -71,6 +89,14 @@ class CallbackTracker {
                    ChunkSize chunk_size,
                    int chunk_id) noexcept;
 
+    /**
+     * Check whether every sim_send() and sim_recv() call has been matched and
+     * finished.
+     *
+     * @return true if no entry is being tracked
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
   private:
     /// map from (tag, src, dest, chunk_size, chunk_id) tuple to
     /// CallbackTrackerEntry
@@ -0,0 +1,70 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "astra-sim/system/Sys.hh"
+#include <astra-network-analytical/common/EventQueue.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace AstraSimAnalytical {
+
+/**
+ * CheckpointManager drives the simulation loop of the analytical frontends
+ * and saves or restores an AstraSim::Checkpoint on request.
+ */
+class CheckpointManager {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param event_queue event queue that drives the simulation
+     * @param systems Sys of every NPU, indexed by NPU id
+     * @param workload_configuration workload configuration prefix
+     * @param save_path checkpoint file to write, empty to disable saving
+     * @param save_tick the checkpoint is written at the first quiescent
+     *                  point at or after this tick
+     * @param restore_path checkpoint file to start from, empty to start
+     *                     from tick 0
+     */
+    CheckpointManager(std::shared_ptr<EventQueue> event_queue,
+                      std::vector<AstraSim::Sys*> systems,
+                      std::string workload_configuration,
+                      std::string save_path,
+                      EventTime save_tick,
+                      std::string restore_path) noexcept;
+
+    /**
+     * Restore the checkpoint if one is given, otherwise fire the workload of
+     * every NPU.
+     */
+    void start() noexcept;
+
+    /**
+     * Run the event queue until the simulation finishes, saving the
+     * checkpoint once the simulation becomes quiescent after save_tick.
+     */
+    void run() noexcept;
+
+  private:
+    /// no-op event used to advance the clock to the checkpoint tick
+    static void advance_clock(void* arg) noexcept;
+
+    /// true if the network backend has no outstanding send/recv
+    [[nodiscard]] static bool is_network_idle() noexcept;
+
+    std::shared_ptr<EventQueue> event_queue;
+    std::vector<AstraSim::Sys*> systems;
+    std::string workload_configuration;
+    std::string save_path;
+    EventTime save_tick;
+    std::string restore_path;
+};
+
+}  // namespace AstraSimAnalytical
@@ -10,7 +10,10 @@ LICENSE file in the root directory of this source tree.
 #include <astra-network-analytical/common/EventQueue.h>
 #include <astra-sim/common/AstraNetworkAPI.hh>
 #include <astra-sim/system/Common.hh>
+#include <map>
 #include <memory>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 using namespace AstraSim;
@@ -25,6 +28,12 @@ namespace AstraSimAnalytical {
  */
 class CommonNetworkApi : public AstraNetworkAPI {
   public:
+    /// (tag, src, dest, chunk_size, chunk_id) of an arriving chunk
+    using ChunkArrivalArg = std::tuple<int, int, int, uint64_t, int>;
+
+    /// message handler and its argument
+    using Callback = std::pair<void (*)(void*), void*>;
+
     /**
      * Set the event queue to be used.
      *
@@ -33,6 +42,13 @@ class CommonNetworkApi : public AstraNetworkAPI {
     static void set_event_queue(
         std::shared_ptr<EventQueue> event_queue_ptr) noexcept;
 
+    /**
+     * Set the link latency of each network dimension.
+     *
+     * @param latencies link latency (ns) per dimension
+     */
+    static void set_latency_per_dim(std::vector<Latency> latencies) noexcept;
+
     /**
      * Get the reference to the callback tracker.
      *
@@ -47,6 +63,20 @@ class CommonNetworkApi : public AstraNetworkAPI {
      */
     static void process_chunk_arrival(void* args) noexcept;
 
+    /**
+     * Callback to be invoked when several chunks arrive at the same time.
+     *
+     * @param args pointer to a std::vector<ChunkArrivalArg>
+     */
+    static void process_chunk_arrivals(void* args) noexcept;
+
+    /**
+     * Invoke a list of message handlers in order.
+     *
+     * @param args pointer to a std::vector<Callback>
+     */
+    static void invoke_callbacks(void* args) noexcept;
+
     /**
      * Constructor.
      *
@@ -55,17 +85,29 @@ class CommonNetworkApi : public AstraNetworkAPI {
     explicit CommonNetworkApi(int rank) noexcept;
 
     /**
-     * Implement sim_get_time of AstraNetworkAPI.
+     * Implement sim_get_time of AstraNetworkAPI, through sim_get_time_ns.
      */
     [[nodiscard]] timespec_t sim_get_time() override;
 
     /**
-     * Implement sim_schedule of AstraNetworkAPI.
+     * Implement sim_get_time_ns of AstraNetworkAPI.
+     */
+    [[nodiscard]] Tick sim_get_time_ns() override;
+
+    /**
+     * Implement sim_schedule of AstraNetworkAPI, through sim_schedule_ns.
      */
     void sim_schedule(timespec_t delta,
                       void (*fun_ptr)(void* fun_arg),
                       void* fun_arg) override;
 
+    /**
+     * Implement sim_schedule_ns of AstraNetworkAPI.
+     */
+    void sim_schedule_ns(Tick delta,
+                         void (*fun_ptr)(void* fun_arg),
+                         void* fun_arg) override;
+
     /**
      * Implement sim_recv of AstraNetworkAPI.
      */
@@ -78,15 +120,52 @@ class CommonNetworkApi : public AstraNetworkAPI {
                  void (*msg_handler)(void* fun_arg),
                  void* fun_arg) override;
 
+    /**
+     * Implement sim_recv_batch of AstraNetworkAPI.
+     * Receives whose chunk has already arrived are completed by a single
+     * scheduled event.
+     */
+    int sim_recv_batch(std::vector<sim_message>& messages) override;
+
     /**
      * Implement get_BW_at_dimension of AstraNetworkAPI.
      */
     double get_BW_at_dimension(int dim) override;
 
+    /**
+     * Implement get_latency_at_dimension of AstraNetworkAPI.
+     */
+    double get_latency_at_dimension(int dim) override;
+
   protected:
+    /**
+     * Register the send callback of a chunk in the callback tracker.
+     *
+     * @return chunk id assigned to the send
+     */
+    static int register_send(int tag,
+                             int src,
+                             int dst,
+                             uint64_t count,
+                             void (*msg_handler)(void*),
+                             void* fun_arg) noexcept;
+
+    /**
+     * Number of events scheduled so far through sim_schedule_ns for the
+     * absolute time `time_ns`.
+     *
+     * @param time_ns absolute event time (ns)
+     * @return number of events scheduled for that time
+     */
+    static int64_t scheduled_events_at(Tick time_ns) noexcept;
+
     /// event queue
     static std::shared_ptr<EventQueue> event_queue;
 
+    /// events scheduled through sim_schedule_ns per event time, kept until
+    /// the time has passed
+    static std::map<Tick, int64_t> scheduled_events;
+
     /// chunk id generator
     static ChunkIdGenerator chunk_id_generator;
 
@@ -96,6 +175,9 @@ class CommonNetworkApi : public AstraNetworkAPI {
     /// bandwidth per each network dimension of the topology
     static std::vector<Bandwidth> bandwidth_per_dim;
 
+    /// link latency per each network dimension, empty if not set
+    static std::vector<Latency> latency_per_dim;
+
     /// number of network dimensions of the topology
     static int dims_count;
 };
@@ -43,6 +43,11 @@ class CongestionAwareNetworkApi final : public CommonNetworkApi {
                  void (*msg_handler)(void* fun_arg),
                  void* fun_arg) override;
 
+    /**
+     * Implement sim_send_batch of AstraNetworkAPI.
+     */
+    int sim_send_batch(std::vector<sim_message>& messages) override;
+
   private:
     /// topology
     static std::shared_ptr<Topology> topology;
@@ -49,6 +49,18 @@ class CongestionUnawareNetworkApi final : public CommonNetworkApi {
                  void (*msg_handler)(void* fun_arg),
                  void* fun_arg) override;
 
+    /**
+     * Implement sim_send_batch of AstraNetworkAPI.
+     */
+    int sim_send_batch(std::vector<sim_message>& messages) override;
+
+    /**
+     * Implement sim_scheduled_events_ns of AstraNetworkAPI.
+     * Every event of this backend, chunk arrivals included, is scheduled
+     * through sim_schedule_ns, so its per-time count is complete.
+     */
+    int64_t sim_scheduled_events_ns(Tick time_ns) override;
+
   private:
     /// topology
     static std::shared_ptr<Topology> topology;
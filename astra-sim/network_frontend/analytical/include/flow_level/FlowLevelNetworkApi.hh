@@ -0,0 +1,62 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/CommonNetworkApi.hh"
+#include "flow_level/FlowNetwork.hh"
+#include <memory>
+#include <vector>
+
+using namespace AstraSim;
+using namespace AstraSimAnalytical;
+using namespace NetworkAnalytical;
+
+namespace AstraSimAnalyticalFlowLevel {
+
+/**
+ * FlowLevelNetworkApi is a AstraNetworkAPI
+ * implemented for the flow-level (max-min fair) network model.
+ */
+class FlowLevelNetworkApi final : public CommonNetworkApi {
+  public:
+    /**
+     * Set the flow-level network to be used.
+     *
+     * @param network_ptr pointer to the network
+     */
+    static void set_network(std::shared_ptr<FlowNetwork> network_ptr) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param rank id of the API
+     */
+    explicit FlowLevelNetworkApi(int rank) noexcept;
+
+    /**
+     * Implement sim_send of AstraNetworkAPI.
+     */
+    int sim_send(void* buffer,
+                 uint64_t count,
+                 int type,
+                 int dst,
+                 int tag,
+                 sim_request* request,
+                 void (*msg_handler)(void* fun_arg),
+                 void* fun_arg) override;
+
+    /**
+     * Implement sim_send_batch of AstraNetworkAPI.
+     * All flows of the batch are injected with a single rate recomputation.
+     */
+    int sim_send_batch(std::vector<sim_message>& messages) override;
+
+  private:
+    /// flow-level network
+    static std::shared_ptr<FlowNetwork> network;
+};
+
+}  // namespace AstraSimAnalyticalFlowLevel
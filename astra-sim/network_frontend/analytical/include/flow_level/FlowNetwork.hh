@@ -0,0 +1,188 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <astra-network-analytical/common/EventQueue.h>
+#include <astra-network-analytical/common/NetworkParser.h>
+#include <astra-network-analytical/common/Type.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace AstraSimAnalyticalFlowLevel {
+
+/**
+ * FlowNetwork is a flow-level network model.
+ *
+ * Every message is a flow that occupies a fixed route of unidirectional
+ * links. Concurrently active flows share the link bandwidth with max-min
+ * fairness, computed by progressive filling. Rates only change when a flow
+ * arrives or departs, and only the flows that (transitively) share a link
+ * with the arriving or departing flow are recomputed.
+ *
+ * The topology is read from the same network configuration as the other
+ * analytical backends: each dimension is a Ring (bidirectional, shortest
+ * direction), FullyConnected (one direct link per NPU pair) or Switch (one
+ * uplink and one downlink per NPU). Multi-dimensional routes traverse the
+ * dimensions in increasing order.
+ */
+class FlowNetwork {
+  public:
+    /**
+     * A message to be injected into the network.
+     */
+    struct FlowRequest {
+        /// source NPU
+        DeviceId src;
+
+        /// destination NPU
+        DeviceId dest;
+
+        /// message size in bytes
+        ChunkSize size;
+
+        /// invoked once the last byte is delivered to the destination
+        Callback callback;
+
+        /// argument of the callback
+        CallbackArg callback_arg;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param network_parser parsed network configuration
+     * @param event_queue event queue that drives the simulation
+     */
+    FlowNetwork(const NetworkParser& network_parser,
+                std::shared_ptr<EventQueue> event_queue) noexcept;
+
+    /**
+     * Inject several flows at the current time. Rates are recomputed once
+     * for the whole batch.
+     *
+     * @param requests flows to inject
+     */
+    void add_flows(const std::vector<FlowRequest>& requests) noexcept;
+
+    /**
+     * Inject a single flow at the current time.
+     *
+     * @param request flow to inject
+     */
+    void add_flow(const FlowRequest& request) noexcept;
+
+    /**
+     * Callback of the scheduled wake-ups: retires the flows that finish at
+     * the current time.
+     *
+     * @param network pointer to the FlowNetwork
+     */
+    static void wake_up(void* network) noexcept;
+
+    [[nodiscard]] int get_npus_count() const noexcept;
+    [[nodiscard]] int get_dims_count() const noexcept;
+    [[nodiscard]] std::vector<int> get_npus_count_per_dim() const noexcept;
+    [[nodiscard]] std::vector<Bandwidth> get_bandwidth_per_dim() const noexcept;
+
+  private:
+    struct Link {
+        /// bandwidth in bytes per ns
+        double capacity;
+
+        /// latency in ns
+        Latency latency;
+
+        /// ids of the active flows using this link
+        std::vector<int> flows;
+    };
+
+    struct Flow {
+        /// link ids, in traversal order
+        std::vector<int> route;
+
+        /// bytes not transmitted yet as of last_update
+        double remaining;
+
+        /// current rate in bytes per ns
+        double rate;
+
+        EventTime last_update;
+        EventTime finish_time;
+
+        /// sum of the link latencies along the route
+        Latency latency;
+
+        Callback callback;
+        CallbackArg callback_arg;
+    };
+
+    /// find or lazily create the link between two nodes of a dimension
+    int get_link(int from, int to, int dim) noexcept;
+
+    /// switch node of the dimension-`dim` group that contains `npu`
+    int get_switch(int npu, int dim) noexcept;
+
+    /// append the links from `src` to `dest` to `route`
+    void build_route(int src, int dest, std::vector<int>& route) noexcept;
+
+    int allocate_flow() noexcept;
+
+    /// recompute the rates of the flows connected to `seed_links`
+    void reallocate(const std::vector<int>& seed_links) noexcept;
+
+    void schedule_wake_up(EventTime time) noexcept;
+
+    void process_finished_flows() noexcept;
+
+    std::shared_ptr<EventQueue> event_queue;
+
+    int npus_count;
+    int dims_count;
+    std::vector<int> npus_count_per_dim;
+    std::vector<Bandwidth> bandwidth_per_dim;
+    std::vector<Latency> latency_per_dim;
+    std::vector<TopologyBuildingBlock> topology_per_dim;
+
+    /// npu id stride of each dimension
+    std::vector<int> stride_per_dim;
+
+    std::vector<Link> links;
+
+    /// (from node << 32 | to node) -> link id
+    std::unordered_map<uint64_t, int> link_ids;
+
+    /// (dimension, first npu of the group) -> switch node id
+    std::map<std::pair<int, int>, int> switch_ids;
+
+    /// next node id available for switches (NPUs use [0, npus_count))
+    int next_switch_id;
+
+    /// flow pool; finished flows are recycled through free_flows
+    std::vector<Flow> flows;
+    std::vector<int> free_flows;
+
+    /// (finish time, flow id) of every active flow
+    std::set<std::pair<EventTime, int>> finish_times;
+
+    /// times for which a wake-up is already scheduled
+    std::set<EventTime> wake_ups;
+
+    /// scratch space of reallocate(), indexed by link or flow id
+    std::vector<uint64_t> link_mark;
+    std::vector<uint64_t> flow_mark;
+    std::vector<double> residual;
+    std::vector<int> unfixed;
+    uint64_t epoch;
+};
+
+}  // namespace AstraSimAnalyticalFlowLevel
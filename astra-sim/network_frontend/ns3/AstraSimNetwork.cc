@@ -146,6 +146,13 @@ class ASTRASimNetwork : public AstraSim::AstraNetworkAPI {
         return timeSpec;
     }
 
+    /**
+     * @brief 获取当前仿真时间（整数纳秒）
+     */
+    AstraSim::Tick sim_get_time_ns() {
+        return Simulator::Now().GetNanoSeconds();
+    }
+
     /**
      * @brief 调度事件
      * @param delta 延迟时间
@@ -159,6 +166,18 @@ class ASTRASimNetwork : public AstraSim::AstraNetworkAPI {
         return;
     }
 
+    /**
+     * @brief 调度事件（整数纳秒）
+     * @param delta 事件延迟时间（纳秒）
+     * @param fun_ptr 事件回调函数指针
+     * @param fun_arg 事件回调函数参数
+     */
+    virtual void sim_schedule_ns(AstraSim::Tick delta,
+                                 void (*fun_ptr)(void* fun_arg),
+                                 void* fun_arg) {
+        Simulator::Schedule(NanoSeconds(delta), fun_ptr, fun_arg);
+    }
+
     /**
      * @brief 发送消息
      * @param buffer 数据缓冲区
@@ -405,6 +424,11 @@ void parse_args(int argc, char* argv[]) {
     // 是否启用 rendezvous 协议（同步通信机制）
     cmd.AddValue("rendezvous-protocol", "Whether to enable rendezvous protocol",
                  rendezvous_protocol);
+    // 每对 NPU 复用的 RDMA 队列对数量上限（0 表示按需增加）
+    cmd.AddValue("qps-per-pair",
+                 "Maximum number of RDMA queue pairs reused between a pair of "
+                 "NPUs (0: grow with the number of concurrent messages)",
+                 qps_per_pair);
     // 解析命令行参数
     cmd.Parse(argc, argv);
 }
@@ -19,6 +19,7 @@
 #include <ns3/rdma.h>
 #include <ns3/sim-setting.h>
 #include <ns3/switch-node.h>
+#include <deque>
 #include <time.h>
 #include <unordered_map>
 
@@ -178,42 +179,151 @@ map<MsgEventKey, MsgEvent> sim_recv_waiting_hash;
 //   - value: ns3 已模拟完成但未被领取的字节数。
 map<MsgEventKey, int> received_msg_standby_hash;
 
-// send_flow commands the ns3 simulator to schedule a RDMA message to be sent
-// between two pair of nodes. send_flow is triggered by sim_send.
-// send_flow 指示 ns3 模拟器在两个节点之间安排一个 RDMA 消息传输。
-// 该函数在 sim_send 触发时被调用。
-// 它主要执行以下任务：
-// 1. 为 RDMA 传输分配一个新的端口号，并将 `tag` 存入 `sender_src_port_map`。
-// 2. 创建 `MsgEvent` 实例，记录传输事件，并存入 `sim_send_waiting_hash` 以便后续查询。
-// 3. 创建 `RdmaClientHelper` 并在 ns3 模拟器中安排 RDMA 消息传输。
-void send_flow(int src_id, int dst, int maxPacketCount,
-               void (*msg_handler)(void *fun_arg), void *fun_arg, int tag) {
-  // Get a new port number.
-  // 生成新的端口号，并在 `sender_src_port_map` 记录该端口和 `tag` 的映射关系
-  uint32_t port = portNumber[src_id][dst]++;
-  sender_src_port_map[make_pair(port, make_pair(src_id, dst))] = tag;
+// Messages are sent on a persistent pool of queue pairs per (src, dst)
+// instead of installing one RdmaClient application (and allocating one port)
+// per message. Each queue pair is a fixed source port that carries one
+// message at a time; once it finishes (qp_finish), the next waiting message
+// of the pair is started on it.
+// This only saves the per-message RdmaClient application and port:
+// AddQueuePair still allocates a new RdmaQueuePair for every message, and
+// RdmaHw deletes it when the message finishes.
+
+// 每对 (src, dst) 持有一组持久的队列对（Queue Pair），不再为每条消息
+// 安装一个 RdmaClient 应用、分配一个新端口。每个队列对对应一个固定的
+// 源端口，同一时刻只承载一条消息；消息完成（qp_finish）后，该节点对
+// 上等待的下一条消息在这个队列对上继续发送。
+// 省去的只是每条消息的 RdmaClient 应用和端口：每条消息仍由
+// AddQueuePair 新建一个 RdmaQueuePair，消息完成后由 RdmaHw 删除。
+
+// 每对 (src, dst) 最多使用的队列对数量，0 表示按需增加（与并发消息数
+// 的峰值相同）。超出上限的消息在该节点对上排队。
+uint32_t qps_per_pair = 0;
+
+// 尚未分配到队列对的消息
+struct PendingFlow {
+  int tag;
+  int size;
+  void (*msg_handler)(void *fun_arg);
+  void *fun_arg;
+};
+
+struct QpPool {
+  // 每个队列对的源端口，以及是否正在承载消息
+  vector<uint32_t> ports;
+  vector<bool> busy;
+  deque<PendingFlow> pending;
+};
+
+// key: <src_id, dst_id>
+map<pair<int, int>, QpPool> qp_pools;
+
+// Queue pairs are added with
+//   RdmaDriver::AddQueuePair(uint64_t size, uint16_t pg, Ipv4Address sip,
+//                            Ipv4Address dip, uint16_t sport, uint16_t dport,
+//                            uint32_t win, uint64_t baseRtt,
+//                            Callback<void> notifyAppFinish)
+// which is the call RdmaClient::StartApplication made. The per-message
+// arguments RdmaClientHelper used to take are kept in this file instead:
+// src/dst come from q->sip/q->dip, the tag from sender_src_port_map and
+// msg_handler/fun_arg from sim_send_waiting_hash, both keyed by the source
+// port. The flows are completed through qp_finish, so the per-queue-pair
+// notification does nothing.
+// 队列对通过上面的 9 参数 RdmaDriver::AddQueuePair 添加（即 RdmaClient 内部
+// 使用的接口）。原先传给 RdmaClientHelper 的逐消息参数保存在本文件中：
+// src/dst 由 q->sip/q->dip 得到，tag 存于 sender_src_port_map，
+// msg_handler/fun_arg 存于 sim_send_waiting_hash，两者都以源端口为键。
+// 消息完成统一由 qp_finish 处理，逐队列对的回调不做任何事。
+void qp_notify_app_finish() {}
+
+// start_flow schedules one message on the queue pair `slot` of the pool.
+// start_flow 在节点对的第 slot 个队列对上安排一条 RDMA 消息：
+// 1. 在 `sender_src_port_map` 记录该端口当前消息的 `tag`。
+// 2. 创建 `MsgEvent` 实例，存入 `sim_send_waiting_hash` 以便完成时查询。
+// 3. 直接在源节点的 RdmaDriver 上添加队列对。
+void start_flow(int src_id, int dst, QpPool &pool, uint32_t slot,
+                const PendingFlow &flow) {
+  uint32_t port = pool.ports[slot];
+  pool.busy[slot] = true;
+  sender_src_port_map[make_pair(port, make_pair(src_id, dst))] = flow.tag;
   int pg = 3, dport = 100;
   flow_input.idx++;
 
   // Create a MsgEvent instance and register callback function.
   // 创建 MsgEvent 实例并注册回调函数
   MsgEvent send_event =
-      MsgEvent(src_id, dst, 0, maxPacketCount, fun_arg, msg_handler);
-  pair<MsgEventKey, int> send_event_key =
-      make_pair(make_pair(tag, make_pair(send_event.src_id, send_event.dst_id)),port) ;
+      MsgEvent(src_id, dst, 0, flow.size, flow.fun_arg, flow.msg_handler);
+  pair<MsgEventKey, int> send_event_key = make_pair(
+      make_pair(flow.tag, make_pair(send_event.src_id, send_event.dst_id)),
+      port);
   sim_send_waiting_hash[send_event_key] = send_event;
 
-  // Create a queue pair and schedule within the ns3 simulator.
-  // 创建队列对（Queue Pair）并在 ns3 模拟器中安排传输
-  RdmaClientHelper clientHelper(
-      pg, serverAddress[src_id], serverAddress[dst], port, dport,
-      maxPacketCount,
+  Ptr<RdmaDriver> rdma = n.Get(src_id)->GetObject<RdmaDriver>();
+  rdma->AddQueuePair(
+      flow.size, pg, serverAddress[src_id], serverAddress[dst], port, dport,
       has_win ? (global_t == 1 ? maxBdp : pairBdp[n.Get(src_id)][n.Get(dst)])
               : 0,
-      global_t == 1 ? maxRtt : pairRtt[src_id][dst], msg_handler, fun_arg, tag,
-      src_id, dst);
-  ApplicationContainer appCon = clientHelper.Install(n.Get(src_id));
-  appCon.Start(Time(0));
+      global_t == 1 ? maxRtt : pairRtt[src_id][dst],
+      MakeCallback(&qp_notify_app_finish));
+}
+
+// send_flow commands the ns3 simulator to schedule a RDMA message to be sent
+// between two pair of nodes. send_flow is triggered by sim_send.
+// send_flow 指示 ns3 模拟器在两个节点之间安排一个 RDMA 消息传输。
+// 该函数在 sim_send 触发时被调用：消息被放到节点对的空闲队列对上，
+// 没有空闲队列对时新建一个（不超过 qps_per_pair），否则排队等待。
+void send_flow(int src_id, int dst, int maxPacketCount,
+               void (*msg_handler)(void *fun_arg), void *fun_arg, int tag) {
+  QpPool &pool = qp_pools[make_pair(src_id, dst)];
+  PendingFlow flow = {tag, maxPacketCount, msg_handler, fun_arg};
+  for (uint32_t slot = 0; slot < pool.ports.size(); slot++) {
+    if (!pool.busy[slot]) {
+      start_flow(src_id, dst, pool, slot, flow);
+      return;
+    }
+  }
+  if (qps_per_pair == 0 || pool.ports.size() < qps_per_pair) {
+    // Get a new port number for a new queue pair.
+    // 为新的队列对分配端口号
+    pool.ports.push_back(portNumber[src_id][dst]++);
+    pool.busy.push_back(false);
+    start_flow(src_id, dst, pool, pool.ports.size() - 1, flow);
+    return;
+  }
+  pool.pending.push_back(flow);
+}
+
+// reuse_qp runs in its own event after the queue pair on `slot` finished. It
+// starts the next waiting message of the pair on it, or marks it idle.
+// reuse_qp 在队列对完成后的独立事件中执行：在第 slot 个队列对上发送该节点对
+// 上等待的下一条消息，没有等待的消息时将其标记为空闲。
+void reuse_qp(int src_id, int dst, uint32_t slot) {
+  QpPool &pool = qp_pools[make_pair(src_id, dst)];
+  if (pool.pending.empty()) {
+    pool.busy[slot] = false;
+    return;
+  }
+  PendingFlow flow = pool.pending.front();
+  pool.pending.pop_front();
+  start_flow(src_id, dst, pool, slot, flow);
+}
+
+// release_qp hands a finished queue pair back to the pool. RdmaHw deletes the
+// finished queue pair by (dip, sport, pg) only after qp_finish returns, and
+// the send/receive callbacks in qp_finish may issue new messages on the same
+// pair. The slot therefore stays busy until reuse_qp runs in a separate event
+// at the same time, so its port is never added twice to RdmaHw.
+// release_qp 将完成的队列对交还给队列对池。RdmaHw 在 qp_finish 返回后才按
+// (dip, sport, pg) 删除已完成的队列对，而 qp_finish 中的发送/接收回调可能在
+// 同一节点对上发出新消息。因此该队列对在同一时刻的另一个事件（reuse_qp）
+// 执行之前保持占用，其端口不会在 RdmaHw 中被重复添加。
+void release_qp(int src_id, int dst, uint32_t port) {
+  QpPool &pool = qp_pools[make_pair(src_id, dst)];
+  for (uint32_t slot = 0; slot < pool.ports.size(); slot++) {
+    if (pool.ports[slot] == port) {
+      Simulator::ScheduleNow(&reuse_qp, src_id, dst, slot);
+      return;
+    }
+  }
 }
 
 // notify_receiver_receive_data looks at whether the System layer has issued
@@ -399,6 +509,10 @@ void qp_finish(FILE *fout, Ptr<RdmaQueuePair> q) {
   // 通知发送方：数据传输完成
   notify_sender_sending_finished(sid, did, q->m_size, tag, q->sport);
 
+  // The queue pair carries the next waiting message, if any.
+  // 队列对继续承载该节点对上等待的下一条消息
+  release_qp(sid, did, q->sport);
+
   // Let receiver knows that it has received packets.
   // 通知接收方：数据已成功接收
   notify_receiver_receive_data(sid, did, q->m_size, tag);
@@ -8,198 +8,191 @@ LICENSE file in the root directory of this source tree.
 #include "astra-sim/common/Logging.hh"
 #include "astra-sim/system/Common.hh"
 
+#include <algorithm>
 #include <cassert>
-#include <cmath>
-#include <fcntl.h>
-#include <iostream>
-#include <unistd.h>
 #include <utility>
-#include <vector>
 
 using namespace std;
 using namespace AstraSim;
 
-CSVWriter::CSVWriter(std::string path, std::string name) {
+CSVWriter::CSVWriter(std::string path, std::string name, Format format) {
     this->path = path;
     this->name = name;
+    this->format = format;
 }
 
-void CSVWriter::initialize_csv(int rows, int cols) {
-    auto logger = LoggerFactory::get_logger("system::CSVWriter");
-    logger->info("CSV path and filename: {}{}", path, name);
-    int trial = 10000;
-    do {
-        myFile.open(path + name, std::fstream::out);
-        trial--;
-    } while (!myFile.is_open() && trial > 0);
-    if (trial == 0) {
-        logger->critical("Unable to create file: {}", path);
-        logger->critical(
-            "This error is fatal. Please make sure the CSV write path exists.");
-        exit(1);
+CSVWriter::~CSVWriter() {
+    if (!columns.empty()) {
+        flush();
     }
-    do {
+    if (myFile.is_open()) {
         myFile.close();
-    } while (myFile.is_open());
+    }
+}
 
-    do {
-        myFile.open(path + name, std::fstream::out | std::fstream::in);
-    } while (!myFile.is_open());
+void CSVWriter::add_column(std::string header, std::vector<uint64_t> values) {
+    Column column;
+    column.header = std::move(header);
+    column.type = ColumnType::UInt64;
+    column.uint_values = std::move(values);
+    columns.push_back(std::move(column));
+}
 
-    if (!myFile) {
-        logger->critical("Unable to create file: {}", path);
-        logger->critical(
-            "This error is fatal. Please make sure the CSV write path exists.");
-        exit(1);
-    } else {
-        logger->info("Success in opening CSV file for writing the report.");
-    }
+void CSVWriter::add_column(std::string header, std::vector<double> values) {
+    Column column;
+    column.header = std::move(header);
+    column.type = ColumnType::Double;
+    column.double_values = std::move(values);
+    columns.push_back(std::move(column));
+}
 
-    myFile.seekp(0, std::ios_base::beg);
-    myFile.seekg(0, std::ios_base::beg);
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols - 1; j++) {
-            myFile << ',';
+void CSVWriter::finalize_csv(
+    const std::list<std::list<std::pair<uint64_t, double>>>& dims) {
+    // all dims are sampled at the same ticks; the first one provides the
+    // time column
+    std::vector<uint64_t> ticks;
+    bool time_set = false;
+    int dim_num = 1;
+    for (const auto& dim : dims) {
+        std::vector<double> util;
+        util.reserve(dim.size());
+        size_t row = 0;
+        for (const auto& sample : dim) {
+            if (!time_set) {
+                ticks.push_back(sample.first);
+            } else {
+                assert(row >= ticks.size() || ticks[row] == sample.first);
+            }
+            util.push_back(sample.second);
+            row++;
         }
-        myFile << '\n';
+        if (!time_set) {
+            std::vector<double> time;
+            time.reserve(ticks.size());
+            for (auto tick : ticks) {
+                time.push_back(tick / FREQ);
+            }
+            add_column(" time (us) ", std::move(time));
+            time_set = true;
+        }
+        add_column("dim" + std::to_string(dim_num) + " util", std::move(util));
+        dim_num++;
     }
-    do {
-        myFile.close();
-    } while (myFile.is_open());
+    flush();
 }
 
-void CSVWriter::finalize_csv(
-    std::list<std::list<std::pair<uint64_t, double>>> dims) {
+void CSVWriter::flush() {
     auto logger = LoggerFactory::get_logger("system::CSVWriter");
-    logger->info("path to create csvs is: {}", path);
-    int trial = 10000;
-    do {
-        myFile.open(path + name, std::fstream::out);
-        trial--;
-    } while (!myFile.is_open() && trial > 0);
-    if (trial == 0) {
-        logger->critical("Unable to create file: {}{}", path, name);
-        logger->critical(
-            "This error is fatal. Please make sure the CSV write path exists.");
-        exit(1);
+    logger->info("writing {} columns to {}{}", columns.size(), path, name);
+    if (format == Format::Binary) {
+        open_output(std::ios_base::out | std::ios_base::binary);
+        flush_binary();
+    } else {
+        open_output(std::ios_base::out);
+        flush_csv();
     }
-    do {
-        myFile.close();
-    } while (myFile.is_open());
-
-    do {
-        myFile.open(path + name, std::fstream::out | std::fstream::in);
-    } while (!myFile.is_open());
+    myFile.close();
+    columns.clear();
+}
 
-    if (!myFile) {
+void CSVWriter::open_output(std::ios_base::openmode mode) {
+    // pubsetbuf has to be called before open() to take effect.
+    file_buffer.resize(buffer_size);
+    myFile.rdbuf()->pubsetbuf(file_buffer.data(), file_buffer.size());
+    myFile.open(path + name, mode | std::ios_base::trunc);
+    if (!myFile.is_open()) {
+        auto logger = LoggerFactory::get_logger("system::CSVWriter");
         logger->critical("Unable to create file: {}{}", path, name);
         logger->critical(
             "This error is fatal. Please make sure the CSV write path exists.");
         exit(1);
-    } else {
-        logger->info("success in openning file");
     }
-    myFile.seekp(0, std::ios_base::beg);
-    myFile.seekg(0, std::ios_base::beg);
-    std::vector<std::list<std::pair<uint64_t, double>>::iterator> dims_it;
-    std::vector<std::list<std::pair<uint64_t, double>>::iterator> dims_it_end;
-    for (auto& dim : dims) {
-        dims_it.push_back(dim.begin());
-        dims_it_end.push_back(dim.end());
+}
+
+void CSVWriter::write_buffer(std::string& buffer, bool force) {
+    if (force || buffer.size() >= buffer_size) {
+        myFile.write(buffer.data(), buffer.size());
+        buffer.clear();
     }
-    int dim_num = 1;
-    myFile << " time (us) ";
-    myFile << ",";
-    for (uint64_t i = 0; i < dims.size(); i++) {
-        myFile << "dim" + std::to_string(dim_num) + " util";
-        myFile << ',';
-        dim_num++;
+}
+
+void CSVWriter::flush_csv() {
+    size_t rows = 0;
+    for (const auto& column : columns) {
+        rows = std::max(rows, column.size());
+    }
+
+    std::string buffer;
+    buffer.reserve(buffer_size + 4096);
+    for (size_t i = 0; i < columns.size(); i++) {
+        if (i != 0) {
+            buffer += ',';
+        }
+        buffer += columns[i].header;
     }
-    myFile << '\n';
-    while (true) {
-        uint64_t finished = 0;
-        uint64_t compare;
-        for (uint64_t i = 0; i < dims_it.size(); i++) {
-            if (dims_it[i] != dims_it_end[i]) {
-                if (i == 0) {
-                    myFile << std::to_string((*dims_it[i]).first / FREQ);
-                    myFile << ",";
-                    compare = (*dims_it[i]).first;
-                } else {
-                    assert(compare == (*dims_it[i]).first);
-                }
+    buffer += '\n';
+
+    for (size_t row = 0; row < rows; row++) {
+        for (size_t i = 0; i < columns.size(); i++) {
+            const Column& column = columns[i];
+            if (i != 0) {
+                buffer += ',';
             }
-            if (dims_it[i] == dims_it_end[i]) {
-                finished++;
-                myFile << ",";
+            if (row >= column.size()) {
                 continue;
+            }
+            if (column.type == ColumnType::UInt64) {
+                buffer += std::to_string(column.uint_values[row]);
             } else {
-                myFile << std::to_string((*dims_it[i]).second);
-                myFile << ',';
-                std::advance(dims_it[i], 1);
+                buffer += std::to_string(column.double_values[row]);
             }
         }
-        myFile << '\n';
-        if (finished == dims_it_end.size()) {
-            break;
-        }
+        buffer += '\n';
+        write_buffer(buffer, false);
     }
-    myFile.close();
+    write_buffer(buffer, true);
 }
 
-void CSVWriter::write_cell(int row, int column, std::string data) {
-    std::string str = "";
-    std::string tmp;
-
-    int status = 1;
-    int fildes = -1;
-    do {
-        fildes = open((path + name).c_str(), O_RDWR);
-    } while (fildes == -1);
-
-    do {
-        status = lockf(fildes, F_TLOCK, (off_t)1000000);
-    } while (status != 0);
-    char buf[1];
-    while (row > 0) {
-        status = read(fildes, buf, 1);
-        str = str + (*buf);
-        if (*buf == '\n') {
-            row--;
+// Binary layout (host byte order):
+//   char[8]  magic "ASTRACOL"
+//   uint32   version
+//   uint32   number of columns
+//   per column:
+//     uint8    ColumnType
+//     uint32   header length, followed by the header bytes
+//     uint64   number of values, followed by the 8-byte values
+void CSVWriter::flush_binary() {
+    const char magic[8] = {'A', 'S', 'T', 'R', 'A', 'C', 'O', 'L'};
+    const uint32_t version = 1;
+    const uint32_t num_columns = static_cast<uint32_t>(columns.size());
+
+    std::string buffer;
+    buffer.reserve(buffer_size + 4096);
+    auto append = [&buffer](const void* data, size_t len) {
+        buffer.append(static_cast<const char*>(data), len);
+    };
+    append(magic, sizeof(magic));
+    append(&version, sizeof(version));
+    append(&num_columns, sizeof(num_columns));
+    for (const auto& column : columns) {
+        const uint8_t type = static_cast<uint8_t>(column.type);
+        const uint32_t header_len = static_cast<uint32_t>(column.header.size());
+        const uint64_t count = column.size();
+        append(&type, sizeof(type));
+        append(&header_len, sizeof(header_len));
+        append(column.header.data(), header_len);
+        append(&count, sizeof(count));
+        write_buffer(buffer, true);
+        // values are already contiguous, so hand them to the stream directly
+        if (column.type == ColumnType::UInt64) {
+            myFile.write(
+                reinterpret_cast<const char*>(column.uint_values.data()),
+                count * sizeof(uint64_t));
+        } else {
+            myFile.write(
+                reinterpret_cast<const char*>(column.double_values.data()),
+                count * sizeof(double));
         }
     }
-    while (column > 0) {
-        status = read(fildes, buf, 1);
-        str = str + (*buf);
-        if (*buf == ',') {
-            column--;
-        }
-        if (*buf == '\n') {
-            LoggerFactory::get_logger("system::CSVWriter")
-                ->critical("fatal error in inserting cewll!");
-            exit(1);
-        }
-    }
-    str = str + data;
-    while (read(fildes, buf, 1)) {
-        str = str + (*buf);
-    }
-
-    do {
-        lseek(fildes, 0, SEEK_SET);
-        status = write(fildes, str.c_str(), str.length());
-    } while (status != str.length());
-
-    do {
-        status = lseek(fildes, 0, SEEK_SET);
-    } while (status == -1);
-
-    do {
-        status = lockf(fildes, F_ULOCK, (off_t)1000000);
-    } while (status != 0);
-
-    do {
-        status = close(fildes);
-    } while (status == -1);
-    return;
+    write_buffer(buffer, true);
 }
@@ -11,28 +11,56 @@ LICENSE file in the root directory of this source tree.
 #include <list>
 #include <string>
 #include <sys/stat.h>
+#include <vector>
 
 namespace AstraSim {
 
+// Buffered, column-oriented stats writer.
+// Columns are accumulated in memory by add_column() and written out in a
+// single sequential pass by flush(), either as CSV (row-major, one line per
+// row) or as a compact binary file (column-major, see flush_binary()).
 class CSVWriter {
   public:
-    CSVWriter(std::string path, std::string name);
-    ~CSVWriter() {
-        if (myFile.is_open()) {
-            myFile.close();
+    enum class Format { CSV = 0, Binary };
+    enum class ColumnType : uint8_t { UInt64 = 0, Double };
+
+    struct Column {
+        std::string header;
+        ColumnType type;
+        std::vector<uint64_t> uint_values;
+        std::vector<double> double_values;
+        size_t size() const {
+            return type == ColumnType::UInt64 ? uint_values.size()
+                                              : double_values.size();
         }
-    }
-    void initialize_csv(int rows, int cols);
-    void finalize_csv(std::list<std::list<std::pair<uint64_t, double>>> dims);
-    void write_cell(int row, int column, std::string data);
+    };
+
+    CSVWriter(std::string path, std::string name, Format format = Format::CSV);
+    ~CSVWriter();
+    void add_column(std::string header, std::vector<uint64_t> values);
+    void add_column(std::string header, std::vector<double> values);
+    void finalize_csv(
+        const std::list<std::list<std::pair<uint64_t, double>>>& dims);
+    void flush();
     inline bool exists_test(const std::string& name) {
         struct stat buffer;
         return (stat(name.c_str(), &buffer) == 0);
     }
 
-    std::fstream myFile;
     std::string name;
     std::string path;
+    Format format;
+    std::vector<Column> columns;
+
+  private:
+    void open_output(std::ios_base::openmode mode);
+    void flush_csv();
+    void flush_binary();
+    void write_buffer(std::string& buffer, bool force);
+
+    static constexpr size_t buffer_size = 1 << 20;
+    std::ofstream myFile;
+    std::vector<char> file_buffer;
 };
 
 }  // namespace AstraSim
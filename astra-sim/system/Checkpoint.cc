@@ -0,0 +1,237 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/system/Checkpoint.hh"
+
+#include "astra-sim/common/Logging.hh"
+#include "astra-sim/system/Sys.hh"
+#include <json/json.hpp>
+
+#include <fstream>
+#include <unordered_set>
+
+using namespace std;
+using namespace AstraSim;
+using json = nlohmann::json;
+
+namespace {
+
+constexpr int checkpoint_version = 2;
+
+}  // namespace
+
+Checkpoint::Checkpoint(const std::string& path) {
+    ifstream in_file(path);
+    if (!in_file.is_open()) {
+        Sys::sys_panic("Unable to open checkpoint file: " + path);
+    }
+
+    json j;
+    try {
+        in_file >> j;
+        if (j.at("version").get<int>() != checkpoint_version) {
+            Sys::sys_panic("Unsupported checkpoint version in " + path);
+        }
+        tick = j.at("tick").get<Tick>();
+        workload_configuration = j.at("workload").get<string>();
+        finished_workloads = j.at("finished_workloads").get<int>();
+        for (const auto& npu : j.at("npus")) {
+            NpuState state;
+            state.id = npu.at("id").get<int>();
+            state.num_streams = npu.at("num_streams").get<int>();
+            state.priority_counter = npu.at("priority_counter").get<int>();
+            state.comm_group_streams =
+                npu.at("comm_groups").get<map<string, int>>();
+            state.finished = npu.at("finished").get<bool>();
+            state.finished_nodes =
+                npu.at("finished_nodes").get<vector<uint64_t>>();
+            for (const auto& node : npu.at("in_flight_nodes")) {
+                state.in_flight_nodes.emplace_back(node.at(0).get<uint64_t>(),
+                                                   node.at(1).get<Tick>());
+            }
+            const auto& hw = npu.at("hardware_resource");
+            state.num_cpu_ops = hw.at("num_cpu_ops").get<uint64_t>();
+            state.num_gpu_ops = hw.at("num_gpu_ops").get<uint64_t>();
+            state.num_gpu_comms = hw.at("num_gpu_comms").get<uint64_t>();
+            state.tics_cpu_ops = hw.at("tics_cpu_ops").get<uint64_t>();
+            state.tics_gpu_ops = hw.at("tics_gpu_ops").get<uint64_t>();
+            state.tics_gpu_comms = hw.at("tics_gpu_comms").get<uint64_t>();
+            const auto& iterations = npu.at("iterations");
+            state.completed_iterations =
+                iterations.at("completed").get<uint64_t>();
+            state.total_iterations = iterations.at("total").get<uint64_t>();
+            state.last_boundary_tick =
+                iterations.at("last_boundary_tick").get<Tick>();
+            state.last_boundary_tics_gpu_ops =
+                iterations.at("last_boundary_tics_gpu_ops").get<uint64_t>();
+            state.recent_iteration_ticks =
+                iterations.at("recent_iteration_ticks").get<vector<Tick>>();
+            state.recent_exposed_comm_ticks =
+                iterations.at("recent_exposed_comm_ticks")
+                    .get<vector<Tick>>();
+            state.steady = iterations.at("steady").get<bool>();
+            if (state.recent_iteration_ticks.size() !=
+                state.recent_exposed_comm_ticks.size()) {
+                Sys::sys_panic("Malformed checkpoint file " + path +
+                               ": recent iteration records differ in size");
+            }
+            npus.push_back(std::move(state));
+        }
+    } catch (const json::exception& e) {
+        Sys::sys_panic("Malformed checkpoint file " + path + ": " + e.what());
+    }
+}
+
+bool Checkpoint::is_quiescent(const std::vector<Sys*>& systems) {
+    for (auto sys : systems) {
+        if (!sys->is_quiescent()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Checkpoint::save(const std::string& path,
+                      const std::vector<Sys*>& systems,
+                      const std::string& workload_configuration) {
+    json j;
+    j["version"] = checkpoint_version;
+    j["tick"] = Sys::boostedTick();
+    j["workload"] = workload_configuration;
+    j["finished_workloads"] = Sys::finished_workloads;
+    j["npus"] = json::array();
+    for (auto sys : systems) {
+        Workload* workload = sys->workload;
+        HardwareResource* hw = workload->hw_resource;
+        json npu;
+        npu["id"] = sys->id;
+        npu["num_streams"] = sys->num_streams;
+        npu["priority_counter"] = sys->priority_counter;
+        npu["comm_groups"] = json::object();
+        for (const auto& group : workload->comm_groups) {
+            npu["comm_groups"][group.first] = group.second->num_streams;
+        }
+        npu["finished"] = workload->is_finished;
+        npu["finished_nodes"] = workload->finished_node_ids;
+        npu["in_flight_nodes"] = json::array();
+        for (const auto& node : sys->get_in_flight_nodes()) {
+            npu["in_flight_nodes"].push_back({node.first, node.second});
+        }
+        npu["hardware_resource"] = {{"num_cpu_ops", hw->num_cpu_ops},
+                                    {"num_gpu_ops", hw->num_gpu_ops},
+                                    {"num_gpu_comms", hw->num_gpu_comms},
+                                    {"tics_cpu_ops", hw->tics_cpu_ops},
+                                    {"tics_gpu_ops", hw->tics_gpu_ops},
+                                    {"tics_gpu_comms", hw->tics_gpu_comms}};
+        npu["iterations"] = {
+            {"completed", workload->completed_iterations},
+            {"total", workload->total_iterations},
+            {"last_boundary_tick", workload->last_boundary_tick},
+            {"last_boundary_tics_gpu_ops",
+             workload->last_boundary_tics_gpu_ops},
+            {"recent_iteration_ticks", workload->recent_iteration_ticks},
+            {"recent_exposed_comm_ticks", workload->recent_exposed_comm_ticks},
+            {"steady", workload->steady}};
+        j["npus"].push_back(std::move(npu));
+    }
+
+    ofstream out_file(path, ios_base::out | ios_base::trunc);
+    if (!out_file.is_open()) {
+        Sys::sys_panic("Unable to create checkpoint file: " + path);
+    }
+    out_file << j;
+
+    LoggerFactory::get_logger("system::Checkpoint")
+        ->info("checkpoint of {} NPUs at tick {} written to {}",
+               systems.size(), Sys::boostedTick(), path);
+}
+
+Tick Checkpoint::get_tick() const {
+    return tick;
+}
+
+void Checkpoint::restore(const std::vector<Sys*>& systems,
+                         const std::string& workload_configuration) const {
+    auto logger = LoggerFactory::get_logger("system::Checkpoint");
+    if (npus.size() != systems.size()) {
+        Sys::sys_panic("checkpoint holds " + to_string(npus.size()) +
+                       " NPUs but the simulation has " +
+                       to_string(systems.size()));
+    }
+    if (Sys::boostedTick() != tick) {
+        Sys::sys_panic("the frontend clock must be at the checkpoint tick " +
+                       to_string(tick) + " before restoring");
+    }
+    if (workload_configuration != this->workload_configuration) {
+        logger->warn("checkpoint was taken with workload {}, restoring it "
+                     "into {}",
+                     this->workload_configuration, workload_configuration);
+    }
+
+    // restore every NPU before issuing anything, so that no NPU sends to a
+    // peer whose state is not restored yet
+    for (const auto& state : npus) {
+        if (state.id < 0 || state.id >= static_cast<int>(systems.size())) {
+            Sys::sys_panic("checkpoint holds unknown NPU id " +
+                           to_string(state.id));
+        }
+        Sys* sys = systems[state.id];
+        Workload* workload = sys->workload;
+        sys->num_streams = state.num_streams;
+        sys->priority_counter = state.priority_counter;
+        for (const auto& group : state.comm_group_streams) {
+            auto it = workload->comm_groups.find(group.first);
+            if (it == workload->comm_groups.end()) {
+                Sys::sys_panic("checkpoint of sys[" + to_string(state.id) +
+                               "] refers to unknown communicator group " +
+                               group.first);
+            }
+            it->second->num_streams = group.second;
+        }
+
+        unordered_set<uint64_t> finished_nodes(state.finished_nodes.begin(),
+                                               state.finished_nodes.end());
+        workload->restore(finished_nodes, state.in_flight_nodes);
+        if (workload->is_finished != state.finished) {
+            Sys::sys_panic("checkpoint of sys[" + to_string(state.id) +
+                           "] does not match workload (finish state)");
+        }
+
+        // overwrite the counters incremented while re-occupying the
+        // in-flight nodes
+        HardwareResource* hw = workload->hw_resource;
+        hw->num_cpu_ops = state.num_cpu_ops;
+        hw->num_gpu_ops = state.num_gpu_ops;
+        hw->num_gpu_comms = state.num_gpu_comms;
+        hw->tics_cpu_ops = state.tics_cpu_ops;
+        hw->tics_gpu_ops = state.tics_gpu_ops;
+        hw->tics_gpu_comms = state.tics_gpu_comms;
+
+        // the fast-forward projection starts from the last iteration
+        // boundary, which lies before the checkpoint tick
+        workload->completed_iterations = state.completed_iterations;
+        workload->total_iterations = state.total_iterations;
+        workload->last_boundary_tick = state.last_boundary_tick;
+        workload->last_boundary_tics_gpu_ops =
+            state.last_boundary_tics_gpu_ops;
+        workload->recent_iteration_ticks.assign(
+            state.recent_iteration_ticks.begin(),
+            state.recent_iteration_ticks.end());
+        workload->recent_exposed_comm_ticks.assign(
+            state.recent_exposed_comm_ticks.begin(),
+            state.recent_exposed_comm_ticks.end());
+        workload->steady = state.steady;
+    }
+    Sys::finished_workloads = finished_workloads;
+
+    for (auto sys : systems) {
+        if (!sys->workload->is_finished) {
+            sys->workload->issue_dep_free_nodes();
+        }
+    }
+
+    logger->info("restored {} NPUs from checkpoint at tick {}", npus.size(),
+                 tick);
+}
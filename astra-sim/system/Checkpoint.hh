@@ -0,0 +1,94 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __CHECKPOINT_HH__
+#define __CHECKPOINT_HH__
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "astra-sim/system/Common.hh"
+
+namespace AstraSim {
+
+class Sys;
+
+// Simulation checkpoint of all NPUs, stored as a JSON file.
+//
+// In-flight collectives (streams, phases, chunks inside the network backend)
+// are made of raw callback pointers that cannot be serialized reliably, so a
+// checkpoint is only taken at a quiescent point: no stream is running, the
+// network backend has no outstanding send/recv, no remote memory access is
+// outstanding, and only compute nodes may be in flight. At such a point the
+// whole simulation state reduces to the ET graph progress, the finish ticks of
+// the in-flight compute nodes, the hardware resource statistics and the stream
+// id counters of every NPU.
+//
+// Restoring replays the finished ET nodes without simulating them, so a run
+// restored from a checkpoint taken after the warm-up iterations only
+// simulates the remaining iterations.
+class Checkpoint {
+  public:
+    struct NpuState {
+        int id;
+        int num_streams;
+        int priority_counter;
+        // communicator group name -> stream id counter of the group
+        std::map<std::string, int> comm_group_streams;
+        bool finished;
+        std::vector<uint64_t> finished_nodes;
+        // (node id, finish tick)
+        std::vector<std::pair<uint64_t, Tick>> in_flight_nodes;
+        uint64_t num_cpu_ops;
+        uint64_t num_gpu_ops;
+        uint64_t num_gpu_comms;
+        uint64_t tics_cpu_ops;
+        uint64_t tics_gpu_ops;
+        uint64_t tics_gpu_comms;
+        // iteration tracking of the workload, see Workload::finish_iteration
+        uint64_t completed_iterations;
+        uint64_t total_iterations;
+        Tick last_boundary_tick;
+        uint64_t last_boundary_tics_gpu_ops;
+        std::vector<Tick> recent_iteration_ticks;
+        std::vector<Tick> recent_exposed_comm_ticks;
+        bool steady;
+    };
+
+    // load a checkpoint written by save()
+    explicit Checkpoint(const std::string& path);
+
+    // true if every NPU is at a point where a checkpoint can be taken; the
+    // caller must also make sure that the network backend is idle
+    static bool is_quiescent(const std::vector<Sys*>& systems);
+
+    // Workload::record_finished_nodes has to be set on every NPU from the
+    // start of the run, otherwise the finished nodes are not known.
+    static void save(const std::string& path,
+                     const std::vector<Sys*>& systems,
+                     const std::string& workload_configuration);
+
+    // tick at which the checkpoint was taken
+    Tick get_tick() const;
+
+    // The frontend has to advance its clock to get_tick() before calling
+    // this. Finished nodes are replayed, in-flight compute nodes are
+    // rescheduled and the remaining dependency-free nodes are issued.
+    void restore(const std::vector<Sys*>& systems,
+                 const std::string& workload_configuration) const;
+
+  private:
+    Tick tick;
+    std::string workload_configuration;
+    int finished_workloads;
+    std::vector<NpuState> npus;
+};
+
+}  // namespace AstraSim
+
+#endif /* __CHECKPOINT_HH__ */
@@ -25,6 +25,30 @@ struct timespec_t {
     long double time_val;
 };
 
+// timespec_t <-> integer nanoseconds, for backends that only implement the
+// timespec_t interface of AstraNetworkAPI
+inline Tick timespec_to_ns(const timespec_t& time) {
+    switch (time.time_res) {
+    case SE:
+        return static_cast<Tick>(time.time_val * 1e9);
+    case MS:
+        return static_cast<Tick>(time.time_val * 1e6);
+    case US:
+        return static_cast<Tick>(time.time_val * 1e3);
+    case FS:
+        return static_cast<Tick>(time.time_val / 1e6);
+    default:
+        return static_cast<Tick>(time.time_val);
+    }
+}
+
+inline timespec_t ns_to_timespec(Tick ns) {
+    timespec_t time;
+    time.time_res = NS;
+    time.time_val = static_cast<long double>(ns);
+    return time;
+}
+
 struct sim_request {
     uint32_t srcRank;
     uint32_t dstRank;
@@ -35,6 +59,19 @@ struct sim_request {
     uint32_t layerNum;
 };
 
+// One message of a sim_send_batch()/sim_recv_batch() call. `peer` is the
+// destination for sends and the source for receives.
+struct sim_message {
+    void* buffer;
+    uint64_t count;
+    int type;
+    int peer;
+    int tag;
+    sim_request request;
+    void (*msg_handler)(void* fun_arg);
+    void* fun_arg;
+};
+
 class MetaData {
   public:
     timespec_t timestamp;
@@ -64,12 +101,21 @@ enum class CollectiveImplType {
     HalvingDoubling,
     OneHalvingDoubling,
     ChakraImpl,
+    Bruck,
+    PairwiseExchange,
+    PipelinedRing,
+    PipelinedDoubleBinaryTree,
+    InNetworkReduction,
+    // chosen per phase by the CollectiveTuner
+    Auto,
 };
 
 enum class CollectiveBarrier { Blocking = 0, Non_Blocking };
 
 enum class SchedulingPolicy { LIFO = 0, FIFO, EXPLICIT, None };
 
+enum class ChunkSizingPolicy { Fixed = 0, Adaptive };
+
 enum class IntraDimensionScheduling {
     FIFO = 0,
     RG,
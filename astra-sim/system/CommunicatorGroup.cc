@@ -5,10 +5,13 @@ LICENSE file in the root directory of this source tree.
 
 #include "astra-sim/system/CommunicatorGroup.hh"
 
-#include <algorithm>
+#include <limits>
+#include <set>
+#include <string>
 
 #include "astra-sim/system/CollectivePlan.hh"
 #include "astra-sim/system/Sys.hh"
+#include "astra-sim/system/topology/GeneralComplexTopology.hh"
 
 using namespace AstraSim;
 
@@ -16,11 +19,10 @@ CommunicatorGroup::CommunicatorGroup(int id,
                                      std::vector<int> involved_NPUs,
                                      Sys* generator) {
     set_id(id);
-    this->involved_NPUs = involved_NPUs;
+    this->members = RingTopology::get_table(involved_NPUs);
     this->generator = generator;
-    std::sort(involved_NPUs.begin(), involved_NPUs.end());
-    assert(std::find(involved_NPUs.begin(), involved_NPUs.end(),
-                     generator->id) != involved_NPUs.end());
+    assert(members->id_to_index.find(generator->id) !=
+           members->id_to_index.end());
 }
 
 CommunicatorGroup::~CommunicatorGroup() {
@@ -32,8 +34,32 @@ CommunicatorGroup::~CommunicatorGroup() {
 
 void CommunicatorGroup::set_id(int id) {
     assert(id > 0);
+    // the last stream id of the block must still fit in an int
+    if (id > std::numeric_limits<int>::max() / streams_per_group - 1) {
+        Sys::sys_panic(
+            "communicator group id " + std::to_string(id) +
+            " is too large: at most " +
+            std::to_string(std::numeric_limits<int>::max() /
+                               streams_per_group -
+                           1) +
+            " groups fit in the stream id space");
+    }
     this->id = id;
-    this->num_streams = id * 1000000;
+    this->num_streams = id * streams_per_group;
+}
+
+int CommunicatorGroup::next_stream_id() {
+    if (num_streams == (id + 1) * streams_per_group - 1) {
+        Sys::sys_panic("communicator group " + std::to_string(id) +
+                       " ran out of stream ids after " +
+                       std::to_string(streams_per_group - 1) +
+                       " collectives");
+    }
+    return num_streams++;
+}
+
+const std::vector<int>& CommunicatorGroup::get_involved_NPUs() const {
+    return members->index_to_id;
 }
 
 CollectivePlan* CommunicatorGroup::get_collective_plan(ComType comm_type) {
@@ -41,7 +67,8 @@ CollectivePlan* CommunicatorGroup::get_collective_plan(ComType comm_type) {
         return comm_plans[comm_type];
     }
 
-    if (static_cast<uint64_t>(generator->total_nodes) == involved_NPUs.size()) {
+    if (static_cast<uint64_t>(generator->total_nodes) ==
+        members->index_to_id.size()) {
         LogicalTopology* logical_topology =
             generator->get_logical_topology(comm_type);
         std::vector<CollectiveImpl*> collective_implementation =
@@ -52,9 +79,14 @@ CollectivePlan* CommunicatorGroup::get_collective_plan(ComType comm_type) {
             new CollectivePlan(logical_topology, collective_implementation,
                                dimensions_involved, should_be_removed);
         return comm_plans[comm_type];
+    }
+    CollectivePlan* hierarchical_plan = get_hierarchical_plan(comm_type);
+    if (hierarchical_plan != nullptr) {
+        comm_plans[comm_type] = hierarchical_plan;
+        return hierarchical_plan;
     } else {
         LogicalTopology* logical_topology = new RingTopology(
-            RingTopology::Dimension::Local, generator->id, involved_NPUs);
+            RingTopology::Dimension::Local, generator->id, members);
         std::vector<CollectiveImpl*> collective_implementation{
             new CollectiveImpl(CollectiveImplType::Ring)};
         std::vector<bool> dimensions_involved(1, true);
@@ -67,3 +99,85 @@ CollectivePlan* CommunicatorGroup::get_collective_plan(ComType comm_type) {
     assert(false);
     return nullptr;
 }
+
+CollectivePlan* CommunicatorGroup::get_hierarchical_plan(ComType comm_type) {
+    LogicalTopology* system_topology =
+        generator->get_logical_topology(comm_type);
+    std::vector<CollectiveImpl*> system_implementation =
+        generator->get_collective_implementation(comm_type);
+    int dimensions = system_topology->get_num_of_dimensions();
+    if (system_implementation.size() < static_cast<uint64_t>(dimensions)) {
+        return nullptr;
+    }
+
+    // coordinates of the members along every dimension
+    std::vector<int> stride(dimensions);
+    std::vector<std::set<int>> coordinates(dimensions);
+    uint64_t product = 1;
+    for (int dim = 0, s = 1; dim < dimensions; dim++) {
+        stride[dim] = s;
+        int size = system_topology->get_num_of_nodes_in_dimension(dim);
+        for (int npu : members->index_to_id) {
+            coordinates[dim].insert((npu / s) % size);
+        }
+        product *= coordinates[dim].size();
+        s *= size;
+    }
+    if (product != members->index_to_id.size()) {
+        return nullptr;
+    }
+
+    std::vector<CollectiveImpl*> implementation_per_dimension;
+    std::vector<LogicalTopology*> dimension_topology;
+    bool supported = true;
+    for (int dim = 0; dim < dimensions && supported; dim++) {
+        CollectiveImpl* impl = system_implementation[dim];
+        switch (impl->type) {
+        case CollectiveImplType::Direct:
+            implementation_per_dimension.push_back(new DirectCollectiveImpl(
+                impl->type,
+                ((DirectCollectiveImpl*)impl)->direct_collective_window));
+            break;
+        case CollectiveImplType::Ring:
+        case CollectiveImplType::HalvingDoubling:
+        case CollectiveImplType::Auto:
+        case CollectiveImplType::Bruck:
+        case CollectiveImplType::PairwiseExchange:
+        case CollectiveImplType::PipelinedRing:
+        case CollectiveImplType::InNetworkReduction:
+            implementation_per_dimension.push_back(
+                new CollectiveImpl(impl->type));
+            break;
+        case CollectiveImplType::DoubleBinaryTree:
+        case CollectiveImplType::PipelinedDoubleBinaryTree:
+            // the trees are only built over whole dimensions
+            implementation_per_dimension.push_back(
+                new CollectiveImpl(CollectiveImplType::Ring));
+            break;
+        default:
+            supported = false;
+            continue;
+        }
+        int size = system_topology->get_num_of_nodes_in_dimension(dim);
+        int own = (generator->id / stride[dim]) % size;
+        std::vector<int> ring;
+        for (int coordinate : coordinates[dim]) {
+            ring.push_back(generator->id + (coordinate - own) * stride[dim]);
+        }
+        dimension_topology.push_back(new RingTopology(
+            RingTopology::Dimension::NA, generator->id, ring));
+    }
+    if (!supported) {
+        for (CollectiveImpl* impl : implementation_per_dimension) {
+            delete impl;
+        }
+        for (LogicalTopology* topology : dimension_topology) {
+            delete topology;
+        }
+        return nullptr;
+    }
+    std::vector<bool> dimensions_involved(dimensions, true);
+    return new CollectivePlan(
+        new GeneralComplexTopology(dimension_topology),
+        implementation_per_dimension, dimensions_involved, true);
+}
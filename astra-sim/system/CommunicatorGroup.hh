@@ -8,9 +8,11 @@ LICENSE file in the root directory of this source tree.
 
 #include <assert.h>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "astra-sim/system/Common.hh"
+#include "astra-sim/system/topology/RingTopology.hh"
 
 namespace AstraSim {
 
@@ -21,12 +23,29 @@ class CommunicatorGroup {
     CommunicatorGroup(int id, std::vector<int> involved_NPUs, Sys* generator);
     CollectivePlan* get_collective_plan(ComType comm_type);
     void set_id(int id);
+    // stream id of the next collective of the group
+    int next_stream_id();
+    const std::vector<int>& get_involved_NPUs() const;
     ~CommunicatorGroup();
 
-    std::vector<int> involved_NPUs;
+    // Stream ids of group `id` are the block [id, id + 1) *
+    // streams_per_group, disjoint from the ids of collectives over all NPUs
+    // and the same on every rank of the group.
+    static constexpr int streams_per_group = 1000000;
+
+    // member list shared by every rank of the group
+    std::shared_ptr<const RingTopology::Table> members;
     int num_streams;
 
   private:
+    // Projects the group onto the dimensions of the system: along every
+    // dimension, the members that differ from this NPU only in that
+    // coordinate form a ring running the implementation configured for the
+    // dimension. Returns nullptr if the group is not such a product of
+    // per-dimension subsets or a dimension's implementation needs the full
+    // dimension.
+    CollectivePlan* get_hierarchical_plan(ComType comm_type);
+
     int id;
     Sys* generator;
     std::map<ComType, CollectivePlan*> comm_plans;
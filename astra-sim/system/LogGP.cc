@@ -31,6 +31,7 @@ LogGP::LogGP(std::string name,
     this->THRESHOLD = 8;
     this->NPU_MEM = nullptr;
     request_num = 0;
+    this->talking_slot = -1;
     this->local_reduction_delay = sys->local_reduction_delay;
 }
 
@@ -51,6 +52,21 @@ void LogGP::attach_mem_bus(Sys* sys,
                                model_shared_bus, communication_delay, false);
 }
 
+int LogGP::allocate_request(const MemMovRequest& mr) {
+    if (!free_requests.empty()) {
+        int slot = free_requests.back();
+        free_requests.pop_back();
+        requests[slot] = mr;
+        return slot;
+    }
+    requests.push_back(mr);
+    return requests.size() - 1;
+}
+
+void LogGP::release_request(int slot) {
+    free_requests.push_back(slot);
+}
+
 void LogGP::process_next_read() {
     Tick offset = 0;
     if (prevState == State::Sending) {
@@ -63,28 +79,32 @@ void LogGP::process_next_read() {
     } else {
         offset = o;
     }
-    MemMovRequest tmp = sends.front();
+    int slot = sends.front();
+    sends.pop_front();
+    MemMovRequest& tmp = requests[slot];
     tmp.total_transfer_queue_time += Sys::boostedTick() - tmp.start_time;
+    int size = tmp.size;
     partner->switch_to_receiver(tmp, offset);
-    sends.pop_front();
+    release_request(slot);
     curState = State::Sending;
     sys->register_event(this, EventType::Send_Finished, nullptr,
-                        offset + (G * (tmp.size - 1)));
+                        offset + (G * (size - 1)));
 }
 void LogGP::request_read(int bytes,
                          bool processed,
                          bool send_back,
                          Callable* callable) {
-    MemMovRequest mr(request_num++, sys, this, bytes, 0, callable, processed,
-                     send_back);
+    int slot = allocate_request(MemMovRequest(request_num++, sys, this, bytes,
+                                              0, callable, processed,
+                                              send_back));
     if (NPU_MEM != nullptr) {
+        MemMovRequest& mr = requests[slot];
         mr.callEvent = EventType::Consider_Send_Back;
-        pre_send.push_back(mr);
-        pre_send.back().wait_wait_for_mem_bus(--pre_send.end());
+        mr.wait_wait_for_mem_bus(slot);
         NPU_MEM->send_from_MA_to_NPU(MemBus::Transmition::Usual, mr.size, false,
-                                     false, &pre_send.back());
+                                     false, &mr);
     } else {
-        sends.push_back(mr);
+        sends.push_back(slot);
         if (curState == State::Free) {
             if (subsequent_reads > THRESHOLD && partner->sends.size() > 0 &&
                 partner->subsequent_reads <= THRESHOLD) {
@@ -98,9 +118,10 @@ void LogGP::request_read(int bytes,
     }
 }
 
-void LogGP::switch_to_receiver(MemMovRequest mr, Tick offset) {
-    mr.start_time = Sys::boostedTick();
-    receives.push_back(mr);
+void LogGP::switch_to_receiver(const MemMovRequest& mr, Tick offset) {
+    int slot = allocate_request(mr);
+    requests[slot].start_time = Sys::boostedTick();
+    receives.push_back(slot);
     prevState = curState;
     curState = State::Receiving;
     sys->register_event(this, EventType::Rec_Finished, nullptr,
@@ -116,160 +137,143 @@ void LogGP::call(EventType event, CallData* data) {
         subsequent_reads++;
     } else if (event == EventType::Rec_Finished) {
         assert(receives.size() > 0);
-        receives.front().total_transfer_time +=
-            Sys::boostedTick() - receives.front().start_time;
-        receives.front().start_time = Sys::boostedTick();
+        int slot = receives.front();
+        MemMovRequest& mr = requests[slot];
+        mr.total_transfer_time += Sys::boostedTick() - mr.start_time;
+        mr.start_time = Sys::boostedTick();
         last_trans = Sys::boostedTick();
         prevState = curState;
         if (receives.size() < 2) {
             curState = State::Free;
         }
-        if (receives.front().processed == true) {
+        if (mr.processed == true) {
+            mr.processed = false;
+            receives.pop_front();
             if (NPU_MEM != nullptr) {
-                receives.front().processed = false;
-                receives.front().loggp = this;
-                receives.front().callEvent = EventType::Consider_Process;
-                pre_process.push_back(receives.front());
-                receives.pop_front();
-                pre_process.back().wait_wait_for_mem_bus(--pre_process.end());
+                mr.loggp = this;
+                mr.callEvent = EventType::Consider_Process;
+                mr.wait_wait_for_mem_bus(slot);
                 NPU_MEM->send_from_NPU_to_MA(MemBus::Transmition::Usual,
-                                             pre_process.back().size, false,
-                                             true, &pre_process.back());
+                                             mr.size, false, true, &mr);
             } else {
-                receives.front().processed = false;
-                processing.push_back(receives.front());
-                receives.pop_front();
+                processing.push_back(slot);
             }
             if (processing_state == ProcState::Free && processing.size() > 0) {
-                processing.front().total_processing_queue_time +=
-                    Sys::boostedTick() - processing.front().start_time;
-                processing.front().start_time = Sys::boostedTick();
+                MemMovRequest& next = requests[processing.front()];
+                next.total_processing_queue_time +=
+                    Sys::boostedTick() - next.start_time;
+                next.start_time = Sys::boostedTick();
                 sys->register_event(
                     this, EventType::Processing_Finished, nullptr,
-                    ((processing.front().size / 100) * local_reduction_delay) +
-                        50);
+                    ((next.size / 100) * local_reduction_delay) + 50);
                 processing_state = ProcState::Processing;
             }
-        } else if (receives.front().send_back == true) {
+        } else if (mr.send_back == true) {
+            mr.send_back = false;
+            receives.pop_front();
             if (NPU_MEM != nullptr) {
-                receives.front().send_back = false;
-                receives.front().callEvent = EventType::Consider_Send_Back;
-                receives.front().loggp = this;
-                pre_send.push_back(receives.front());
-                receives.pop_front();
-                pre_send.back().wait_wait_for_mem_bus(--pre_send.end());
+                mr.callEvent = EventType::Consider_Send_Back;
+                mr.loggp = this;
+                mr.wait_wait_for_mem_bus(slot);
                 NPU_MEM->send_from_NPU_to_MA(MemBus::Transmition::Usual,
-                                             pre_send.back().size, false, true,
-                                             &pre_send.back());
+                                             mr.size, false, true, &mr);
             } else {
-                receives.front().send_back = false;
-                sends.push_back(receives.front());
-                receives.pop_front();
+                sends.push_back(slot);
             }
         } else {
+            receives.pop_front();
             if (NPU_MEM != nullptr) {
-                receives.front().callEvent = EventType::Consider_Retire;
-                receives.front().loggp = this;
-                retirements.push_back(receives.front());
-                retirements.back().wait_wait_for_mem_bus(--retirements.end());
+                mr.callEvent = EventType::Consider_Retire;
+                mr.loggp = this;
+                mr.wait_wait_for_mem_bus(slot);
                 NPU_MEM->send_from_NPU_to_MA(MemBus::Transmition::Usual,
-                                             retirements.back().size, false,
-                                             false, &retirements.back());
-                receives.pop_front();
+                                             mr.size, false, false, &mr);
             } else {
                 SharedBusStat* tmp = new SharedBusStat(
-                    BusType::Shared, receives.front().total_transfer_queue_time,
-                    receives.front().total_transfer_time,
-                    receives.front().total_processing_queue_time,
-                    receives.front().total_processing_time);
-                tmp->update_bus_stats(BusType::Mem, receives.front());
-                receives.front().callable->call(trigger_event, tmp);
-                receives.pop_front();
+                    BusType::Shared, mr.total_transfer_queue_time,
+                    mr.total_transfer_time, mr.total_processing_queue_time,
+                    mr.total_processing_time);
+                tmp->update_bus_stats(BusType::Mem, mr);
+                Callable* callable = mr.callable;
+                release_request(slot);
+                callable->call(trigger_event, tmp);
             }
         }
     } else if (event == EventType::Processing_Finished) {
         assert(processing.size() > 0);
-        processing.front().total_processing_time +=
-            Sys::boostedTick() - processing.front().start_time;
-        processing.front().start_time = Sys::boostedTick();
+        int slot = processing.front();
+        processing.pop_front();
+        MemMovRequest& mr = requests[slot];
+        mr.total_processing_time += Sys::boostedTick() - mr.start_time;
+        mr.start_time = Sys::boostedTick();
         processing_state = ProcState::Free;
-        if (processing.front().send_back == true) {
+        if (mr.send_back == true) {
+            mr.send_back = false;
             if (NPU_MEM != nullptr) {
-                processing.front().send_back = false;
-                processing.front().loggp = this;
-                processing.front().callEvent = EventType::Consider_Send_Back;
-                pre_send.push_back(processing.front());
-                processing.pop_front();
-                pre_send.back().wait_wait_for_mem_bus(--pre_send.end());
+                mr.loggp = this;
+                mr.callEvent = EventType::Consider_Send_Back;
+                mr.wait_wait_for_mem_bus(slot);
                 NPU_MEM->send_from_NPU_to_MA(MemBus::Transmition::Usual,
-                                             pre_send.back().size, false, true,
-                                             &pre_send.back());
+                                             mr.size, false, true, &mr);
             } else {
-                processing.front().send_back = false;
-                sends.push_back(processing.front());
-                processing.pop_front();
+                sends.push_back(slot);
             }
         } else {
             if (NPU_MEM != nullptr) {
-                processing.front().callEvent = EventType::Consider_Retire;
-                processing.front().loggp = this;
-                retirements.push_back(processing.front());
-                retirements.back().wait_wait_for_mem_bus(--retirements.end());
+                mr.callEvent = EventType::Consider_Retire;
+                mr.loggp = this;
+                mr.wait_wait_for_mem_bus(slot);
                 NPU_MEM->send_from_NPU_to_MA(MemBus::Transmition::Usual,
-                                             retirements.back().size, false,
-                                             false, &retirements.back());
-                processing.pop_front();
+                                             mr.size, false, false, &mr);
             } else {
                 SharedBusStat* tmp = new SharedBusStat(
-                    BusType::Shared,
-                    processing.front().total_transfer_queue_time,
-                    processing.front().total_transfer_time,
-                    processing.front().total_processing_queue_time,
-                    processing.front().total_processing_time);
-                tmp->update_bus_stats(BusType::Mem, processing.front());
-                processing.front().callable->call(trigger_event, tmp);
-                processing.pop_front();
+                    BusType::Shared, mr.total_transfer_queue_time,
+                    mr.total_transfer_time, mr.total_processing_queue_time,
+                    mr.total_processing_time);
+                tmp->update_bus_stats(BusType::Mem, mr);
+                Callable* callable = mr.callable;
+                release_request(slot);
+                callable->call(trigger_event, tmp);
             }
         }
         if (processing.size() > 0) {
-            processing.front().total_processing_queue_time +=
-                Sys::boostedTick() - processing.front().start_time;
-            processing.front().start_time = Sys::boostedTick();
+            MemMovRequest& next = requests[processing.front()];
+            next.total_processing_queue_time +=
+                Sys::boostedTick() - next.start_time;
+            next.start_time = Sys::boostedTick();
             processing_state = ProcState::Processing;
             sys->register_event(
                 this, EventType::Processing_Finished, nullptr,
-                ((processing.front().size / 100) * local_reduction_delay) + 50);
+                ((next.size / 100) * local_reduction_delay) + 50);
         }
     } else if (event == EventType::Consider_Retire) {
+        int slot = talking_slot;
+        MemMovRequest& mr = requests[slot];
         SharedBusStat* tmp = new SharedBusStat(
-            BusType::Shared, retirements.front().total_transfer_queue_time,
-            retirements.front().total_transfer_time,
-            retirements.front().total_processing_queue_time,
-            retirements.front().total_processing_time);
-        MemMovRequest movRequest = *talking_it;
-        tmp->update_bus_stats(BusType::Mem, movRequest);
-        movRequest.callable->call(trigger_event, tmp);
-        retirements.erase(talking_it);
+            BusType::Shared, mr.total_transfer_queue_time,
+            mr.total_transfer_time, mr.total_processing_queue_time,
+            mr.total_processing_time);
+        tmp->update_bus_stats(BusType::Mem, mr);
+        Callable* callable = mr.callable;
+        release_request(slot);
+        callable->call(trigger_event, tmp);
         delete data;
     } else if (event == EventType::Consider_Process) {
-        MemMovRequest movRequest = *talking_it;
-        processing.push_back(movRequest);
-        pre_process.erase(talking_it);
+        processing.push_back(talking_slot);
         if (processing_state == ProcState::Free && processing.size() > 0) {
-            processing.front().total_processing_queue_time +=
-                Sys::boostedTick() - processing.front().start_time;
-            processing.front().start_time = Sys::boostedTick();
+            MemMovRequest& next = requests[processing.front()];
+            next.total_processing_queue_time +=
+                Sys::boostedTick() - next.start_time;
+            next.start_time = Sys::boostedTick();
             sys->register_event(
                 this, EventType::Processing_Finished, nullptr,
-                ((processing.front().size / 100) * local_reduction_delay) + 50);
+                ((next.size / 100) * local_reduction_delay) + 50);
             processing_state = ProcState::Processing;
         }
         delete data;
     } else if (event == EventType::Consider_Send_Back) {
-        assert(pre_send.size() > 0);
-        MemMovRequest movRequest = *talking_it;
-        sends.push_back(movRequest);
-        pre_send.erase(talking_it);
+        assert(talking_slot >= 0);
+        sends.push_back(talking_slot);
         delete data;
     }
     if (curState == State::Free) {
@@ -6,12 +6,14 @@ LICENSE file in the root directory of this source tree.
 #ifndef __LOGGP_HH__
 #define __LOGGP_HH__
 
-#include <list>
+#include <deque>
+#include <vector>
 
 #include "astra-sim/system/Callable.hh"
 #include "astra-sim/system/Common.hh"
 #include "astra-sim/system/MemBus.hh"
 #include "astra-sim/system/MemMovRequest.hh"
+#include "astra-sim/system/RingBuffer.hh"
 
 namespace AstraSim {
 
@@ -31,7 +33,7 @@ class LogGP : public Callable {
                       bool processed,
                       bool send_back,
                       Callable* callable);
-    void switch_to_receiver(MemMovRequest mr, Tick offset);
+    void switch_to_receiver(const MemMovRequest& mr, Tick offset);
     void call(EventType event, CallData* data);
     void attach_mem_bus(Sys* sys,
                         Tick L,
@@ -55,14 +57,19 @@ class LogGP : public Callable {
     State curState;
     State prevState;
     ProcState processing_state;
-    std::list<MemMovRequest> sends;
-    std::list<MemMovRequest> receives;
-    std::list<MemMovRequest> processing;
 
-    std::list<MemMovRequest> retirements;
-    std::list<MemMovRequest> pre_send;
-    std::list<MemMovRequest> pre_process;
-    std::list<MemMovRequest>::iterator talking_it;
+    // Requests live in a pool (a deque, so the addresses handed to the
+    // memory bus stay valid) and are referred to by slot index. Requests
+    // waiting on the NPU memory bus are only tracked by their slot; the bus
+    // reports back which one finished through talking_slot.
+    int allocate_request(const MemMovRequest& mr);
+    void release_request(int slot);
+    std::deque<MemMovRequest> requests;
+    std::vector<int> free_requests;
+    RingBuffer<int> sends;
+    RingBuffer<int> receives;
+    RingBuffer<int> processing;
+    int talking_slot;
 
     LogGP* partner;
     Sys* sys;
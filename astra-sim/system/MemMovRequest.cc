@@ -35,6 +35,7 @@ MemMovRequest::MemMovRequest(int request_num,
     this->request_num = request_num;
     this->start_time = Sys::boostedTick();
     this->mem_bus_finished = true;
+    this->slot = -1;
 }
 
 void MemMovRequest::call(EventType event, CallData* data) {
@@ -51,12 +52,11 @@ void MemMovRequest::call(EventType event, CallData* data) {
     // delete (SharedBusStat *)data;
     // callEvent=EventType::General;
     mem_bus_finished = true;
-    loggp->talking_it = pointer;
+    loggp->talking_slot = slot;
     loggp->call(callEvent, data);
 }
 
-void MemMovRequest::wait_wait_for_mem_bus(
-    std::list<MemMovRequest>::iterator pointer) {
+void MemMovRequest::wait_wait_for_mem_bus(int slot) {
     mem_bus_finished = false;
-    this->pointer = pointer;
+    this->slot = slot;
 }
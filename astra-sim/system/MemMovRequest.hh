@@ -24,10 +24,7 @@ class MemMovRequest : public Callable, public SharedBusStat {
                   Callable* callable,
                   bool processed,
                   bool send_back);
-    void wait_wait_for_mem_bus(std::list<MemMovRequest>::iterator pointer);
-    void set_iterator(std::list<MemMovRequest>::iterator pointer) {
-        this->pointer = pointer;
-    }
+    void wait_wait_for_mem_bus(int slot);
     void call(EventType event, CallData* data);
 
     static int id;
@@ -41,7 +38,7 @@ class MemMovRequest : public Callable, public SharedBusStat {
     Sys* sys;
     EventType callEvent = EventType::General;
     LogGP* loggp;
-    std::list<MemMovRequest>::iterator pointer;
+    int slot;
 
     Tick total_transfer_queue_time;
     Tick total_transfer_time;
@@ -0,0 +1,80 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __RING_BUFFER_HH__
+#define __RING_BUFFER_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace AstraSim {
+
+// FIFO queue over a power-of-two sized array. The capacity is fixed after
+// construction in the common case; if a queue ever overflows, the storage is
+// doubled once and reused from then on, so steady state never allocates.
+template <typename T>
+class RingBuffer {
+  public:
+    explicit RingBuffer(uint64_t capacity = 64) {
+        uint64_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        buffer.resize(size);
+        head = 0;
+        count = 0;
+    }
+
+    void push_back(const T& value) {
+        if (count == buffer.size()) {
+            grow();
+        }
+        buffer[(head + count) & (buffer.size() - 1)] = value;
+        count++;
+    }
+
+    void pop_front() {
+        assert(count > 0);
+        head = (head + 1) & (buffer.size() - 1);
+        count--;
+    }
+
+    T& front() {
+        assert(count > 0);
+        return buffer[head];
+    }
+
+    T& back() {
+        assert(count > 0);
+        return buffer[(head + count - 1) & (buffer.size() - 1)];
+    }
+
+    uint64_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+  private:
+    void grow() {
+        std::vector<T> tmp(buffer.size() * 2);
+        for (uint64_t i = 0; i < count; i++) {
+            tmp[i] = buffer[(head + i) & (buffer.size() - 1)];
+        }
+        buffer.swap(tmp);
+        head = 0;
+    }
+
+    std::vector<T> buffer;
+    uint64_t head;
+    uint64_t count;
+};
+
+}  // namespace AstraSim
+
+#endif /* __RING_BUFFER_HH__ */
@@ -34,6 +34,7 @@ void SimRecvCaller::call(EventType type, CallData* data) {
     sys->comm_NI->sim_recv(this->buffer, this->count, this->type, this->src,
                            this->tag, &this->request, this->msg_handler,
                            this->fun_arg);
+    Sys::backend_sequence++;
     if (should_cleanup) {
         delete this;
     }
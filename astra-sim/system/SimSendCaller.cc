@@ -34,6 +34,7 @@ void SimSendCaller::call(EventType type, CallData* data) {
     sys->comm_NI->sim_send(this->buffer, this->count, this->type, this->dst,
                            this->tag, &this->request, this->msg_handler,
                            this->fun_arg);
+    Sys::backend_sequence++;
     if (should_cleanup) {
         delete this;
     }
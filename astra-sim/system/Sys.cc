@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #include "astra-sim/system/Sys.hh"
 
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 
 #include "astra-sim/common/Logging.hh"
@@ -23,10 +24,16 @@ LICENSE file in the root directory of this source tree.
 #include "astra-sim/system/StreamBaseline.hh"
 #include "astra-sim/system/WorkloadLayerHandlerData.hh"
 #include "astra-sim/system/collective/AllToAll.hh"
+#include "astra-sim/system/collective/Bruck.hh"
 #include "astra-sim/system/collective/ChakraImpl.hh"
 #include "astra-sim/system/collective/DoubleBinaryTreeAllReduce.hh"
 #include "astra-sim/system/collective/HalvingDoubling.hh"
+#include "astra-sim/system/collective/InNetworkReduction.hh"
+#include "astra-sim/system/collective/PairwiseExchange.hh"
+#include "astra-sim/system/collective/PipelinedRing.hh"
+#include "astra-sim/system/collective/PipelinedTreeAllReduce.hh"
 #include "astra-sim/system/collective/Ring.hh"
+#include "astra-sim/system/scheduling/CollectiveTuner.hh"
 #include "astra-sim/system/scheduling/OfflineGreedy.hh"
 #include "astra-sim/system/topology/BasicLogicalTopology.hh"
 #include "astra-sim/system/topology/GeneralComplexTopology.hh"
@@ -39,6 +46,13 @@ using json = nlohmann::json;
 namespace AstraSim {
 uint8_t* Sys::dummy_data = new uint8_t[2];
 vector<Sys*> Sys::all_sys;
+map<Tick, deque<Sys::DispatchBatch>> Sys::dispatch_queue;
+uint64_t Sys::backend_sequence = 0;
+bool Sys::coalesce_backend_events = true;
+int Sys::finished_workloads = 0;
+
+// call_events 的异常路径与 sys_panic 共用，避免每次都查 spdlog 注册表
+static LoggerHandle system_logger("system");
 
 // SchedulerUnit --------------------------------------------------------------
 Sys::SchedulerUnit::SchedulerUnit(Sys* sys,
@@ -65,14 +79,16 @@ Sys::SchedulerUnit::SchedulerUnit(Sys* sys,
             base++;
         }
         dimension++;
-        UsageTracker u(2);
+        UsageTracker u(2, sys->utilization_window);
         usage.push_back(u);
     }
 }
 
 void Sys::SchedulerUnit::notify_stream_added(int vnet) {
-    if (sys->id == 0 &&
-        ++total_active_chunks_per_dimension[queue_id_to_dimension[vnet]] == 1) {
+    // usage is only tracked when utilization heatmaps are requested
+    if (++total_active_chunks_per_dimension[queue_id_to_dimension[vnet]] ==
+            1 &&
+        sys->utilization_window > 0) {
         usage[queue_id_to_dimension[vnet]].increase_usage();
     }
     stream_pointer[vnet] = sys->active_Streams[vnet].begin();
@@ -98,8 +114,9 @@ void Sys::SchedulerUnit::notify_stream_added_into_ready_list() {
 }
 
 void Sys::SchedulerUnit::notify_stream_removed(int vnet, Tick running_time) {
-    if (sys->id == 0 &&
-        --total_active_chunks_per_dimension[queue_id_to_dimension[vnet]] == 0) {
+    if (--total_active_chunks_per_dimension[queue_id_to_dimension[vnet]] ==
+            0 &&
+        sys->utilization_window > 0) {
         usage[queue_id_to_dimension[vnet]].decrease_usage();
     }
     running_streams[vnet]--;
@@ -182,6 +199,7 @@ Sys::Sys(int id,
     this->scheduler_unit = nullptr;
     this->vLevels = nullptr;
     this->offline_greedy = nullptr;
+    this->collective_tuner = nullptr;
     this->intra_dimension_scheduling = IntraDimensionScheduling::FIFO;
     this->inter_dimension_scheduling = InterDimensionScheduling::Ascending;
     this->round_robin_inter_dimension_scheduler = 0;
@@ -189,8 +207,9 @@ Sys::Sys(int id,
     this->priority_counter = 0;
     this->pending_events = 0;
     this->preferred_dataset_splits = 0;
-
-    this->last_scheduled_collective = 0;
+    this->chunk_sizing_policy = ChunkSizingPolicy::Fixed;
+    this->min_chunk_bytes = 64 * 1024;
+    this->max_chunk_bytes = 64 * 1024 * 1024;
 
     this->first_phase_streams = 0;
     this->total_running_streams = 0;
@@ -245,6 +264,20 @@ Sys::Sys(int id,
     logical_topologies["AllToAll"] = new GeneralComplexTopology(
         id, physical_dims, all_to_all_implementation_per_dimension);
 
+    for (auto implementation_per_dimension :
+         {&all_reduce_implementation_per_dimension,
+          &reduce_scatter_implementation_per_dimension,
+          &all_gather_implementation_per_dimension,
+          &all_to_all_implementation_per_dimension}) {
+        for (auto ci : *implementation_per_dimension) {
+            if (ci->type == CollectiveImplType::Auto &&
+                collective_tuner == nullptr) {
+                collective_tuner =
+                    new CollectiveTuner(this, collective_tuner_table_path);
+            }
+        }
+    }
+
     memBus = new MemBus("NPU", "MA", this, inp_L, inp_o, inp_g, inp_G,
                         model_shared_bus, communication_delay, true);
 
@@ -309,6 +342,10 @@ Sys::~Sys() {
         delete offline_greedy;
     }
 
+    if (collective_tuner != nullptr) {
+        delete collective_tuner;
+    }
+
     bool shouldExit = true;
     for (auto& a : all_sys) {
         if (a != nullptr) {
@@ -318,6 +355,8 @@ Sys::~Sys() {
     }
 
     if (shouldExit) {
+        // the next run in this process starts counting from scratch
+        finished_workloads = 0;
         exit_sim_loop("Exiting");
     }
 }
@@ -327,8 +366,7 @@ bool Sys::initialize_sys(string name) {
     inFile.open(name);
     if (!inFile) {
         if (id == 0) {
-            LoggerFactory::get_logger("system")->critical(
-                "Unable to open file: {}", name);
+            system_logger->critical("Unable to open file: {}", name);
         }
         exit(1);
     }
@@ -419,6 +457,22 @@ bool Sys::initialize_sys(string name) {
             generate_collective_impl_from_chakra(chakra_filepath_str_vec[0]);
         all_reduce_implementation_per_dimension.push_back(ci);
     }
+    this->collective_tuner_table_path = "";
+    if (j.contains("collective-tuner-table")) {
+        string inp_collective_tuner_table = j["collective-tuner-table"];
+        collective_tuner_table_path = inp_collective_tuner_table;
+    }
+    this->collective_slice_bytes = 512 * 1024;
+    if (j.contains("collective-slice-bytes")) {
+        collective_slice_bytes = j["collective-slice-bytes"];
+        if (collective_slice_bytes == 0) {
+            sys_panic("collective-slice-bytes should be positive");
+        }
+    }
+    this->in_network_reduction_bw = 0;
+    if (j.contains("in-network-reduction-bw")) {
+        in_network_reduction_bw = j["in-network-reduction-bw"];  // GB/sec
+    }
     if (j.contains("collective-optimization")) {
         string inp_collective_optimization = j["collective-optimization"];
         if (inp_collective_optimization == "baseline") {
@@ -465,6 +519,27 @@ bool Sys::initialize_sys(string name) {
     if (j.contains("preferred-dataset-splits")) {
         preferred_dataset_splits = j["preferred-dataset-splits"];
     }
+    if (j.contains("chunk-sizing")) {
+        string inp_chunk_sizing = j["chunk-sizing"];
+        if (inp_chunk_sizing == "fixed") {
+            chunk_sizing_policy = ChunkSizingPolicy::Fixed;
+        } else if (inp_chunk_sizing == "adaptive") {
+            chunk_sizing_policy = ChunkSizingPolicy::Adaptive;
+        } else {
+            sys_panic("unknown value for chunk sizing in sys input file");
+        }
+    }
+    if (j.contains("min-chunk-bytes")) {
+        min_chunk_bytes = j["min-chunk-bytes"];
+    }
+    if (j.contains("max-chunk-bytes")) {
+        max_chunk_bytes = j["max-chunk-bytes"];
+    }
+    if (chunk_sizing_policy == ChunkSizingPolicy::Adaptive &&
+        (min_chunk_bytes == 0 || min_chunk_bytes > max_chunk_bytes)) {
+        sys_panic("min-chunk-bytes should be positive and no larger than "
+                  "max-chunk-bytes");
+    }
     if (j.contains("peak-perf")) {
         peak_perf = j["peak-perf"];
         peak_perf = peak_perf * 1000000000000;  // TFLOPS
@@ -483,10 +558,44 @@ bool Sys::initialize_sys(string name) {
     if (j.contains("trace-enabled")) {
         if (j["trace-enabled"] != 0) {
             this->trace_enabled = true;
+#if ASTRA_LOG_ACTIVE_LEVEL > SPDLOG_LEVEL_DEBUG
+            if (id == 0) {
+                system_logger->warn(
+                    "trace-enabled is set, but debug logging is compiled "
+                    "out of this build (ASTRA_LOG_ACTIVE_LEVEL); no trace "
+                    "will be written");
+            }
+#endif
         } else {
             this->trace_enabled = false;
         }
     }
+    this->utilization_window = 0;
+    if (j.contains("utilization-window")) {
+        utilization_window = j["utilization-window"];
+    }
+    this->utilization_heatmap_path = "./";
+    if (j.contains("utilization-heatmap-path")) {
+        string inp_utilization_heatmap_path = j["utilization-heatmap-path"];
+        utilization_heatmap_path = inp_utilization_heatmap_path;
+    }
+    this->utilization_heatmap_format = CSVWriter::Format::CSV;
+    if (j.contains("utilization-heatmap-format")) {
+        string inp_utilization_heatmap_format = j["utilization-heatmap-format"];
+        if (inp_utilization_heatmap_format == "csv") {
+            utilization_heatmap_format = CSVWriter::Format::CSV;
+        } else if (inp_utilization_heatmap_format == "binary") {
+            utilization_heatmap_format = CSVWriter::Format::Binary;
+        } else {
+            sys_panic("unknown value for utilization heatmap format in sys "
+                      "input file");
+        }
+    }
+    this->critical_path_report_path = "";
+    if (j.contains("critical-path-report")) {
+        string inp_critical_path_report = j["critical-path-report"];
+        critical_path_report_path = inp_critical_path_report;
+    }
     this->replay_only = false;
     if (j.contains("replay-only")) {
         if (j["replay-only"] != 0) {
@@ -495,6 +604,27 @@ bool Sys::initialize_sys(string name) {
             this->replay_only = false;
         }
     }
+    this->steady_state_iterations = 0;
+    if (j.contains("steady-state-iterations")) {
+        steady_state_iterations = j["steady-state-iterations"];
+    }
+    this->steady_state_tolerance = 0.01;
+    if (j.contains("steady-state-tolerance")) {
+        steady_state_tolerance = j["steady-state-tolerance"];
+    }
+    if (steady_state_iterations < 0 || steady_state_tolerance < 0) {
+        sys_panic("steady-state-iterations and steady-state-tolerance should "
+                  "not be negative");
+    }
+    this->iteration_marker = "";
+    if (j.contains("iteration-marker")) {
+        string inp_iteration_marker = j["iteration-marker"];
+        iteration_marker = inp_iteration_marker;
+    }
+    this->total_iterations = 0;
+    if (j.contains("total-iterations")) {
+        total_iterations = j["total-iterations"];
+    }
 
     inFile.close();
     return true;
@@ -524,6 +654,19 @@ CollectiveImpl* Sys::generate_collective_impl_from_input(
         return new CollectiveImpl(CollectiveImplType::HalvingDoubling);
     } else if (collective_impl_str == "oneHalvingDoubling") {
         return new CollectiveImpl(CollectiveImplType::OneHalvingDoubling);
+    } else if (collective_impl_str == "pipelinedRing") {
+        return new CollectiveImpl(CollectiveImplType::PipelinedRing);
+    } else if (collective_impl_str == "pipelinedDoubleBinaryTree") {
+        return new CollectiveImpl(
+            CollectiveImplType::PipelinedDoubleBinaryTree);
+    } else if (collective_impl_str == "inNetworkReduction") {
+        return new CollectiveImpl(CollectiveImplType::InNetworkReduction);
+    } else if (collective_impl_str == "bruck") {
+        return new CollectiveImpl(CollectiveImplType::Bruck);
+    } else if (collective_impl_str == "pairwiseExchange") {
+        return new CollectiveImpl(CollectiveImplType::PairwiseExchange);
+    } else if (collective_impl_str == "auto") {
+        return new CollectiveImpl(CollectiveImplType::Auto);
     } else {
         sys_panic("Cannot interpret collective implementations. Please check "
                   "the collective implementations in the sys"
@@ -548,20 +691,160 @@ Tick Sys::boostedTick() {
             }
         }
     }
-    timespec_t tmp = ts->comm_NI->sim_get_time();
-    Tick tick = tmp.time_val / CLOCK_PERIOD;
-    return tick;
+    return ts->comm_NI->sim_get_time_ns() / CLOCK_PERIOD;
 }
 
 void Sys::sys_panic(string msg) {
-    auto logger = LoggerFactory::get_logger("system");
-    logger->critical(msg);
+    system_logger->critical(msg);
     exit(1);
 }
 
 void Sys::exit_sim_loop(string msg) {
-    auto logger = LoggerFactory::get_logger("system");
-    logger->warn(msg);
+    system_logger->warn(msg);
+}
+
+bool Sys::is_quiescent() const {
+    if (!ready_list.empty() || total_running_streams != 0) {
+        return false;
+    }
+    if (workload != nullptr && !workload->is_quiescent()) {
+        return false;
+    }
+    for (const auto& events : event_queue) {
+        for (const auto& event : events.second) {
+            if (get<0>(event) != workload || get<2>(event) == nullptr) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+vector<pair<uint64_t, Tick>> Sys::get_in_flight_nodes() const {
+    vector<pair<uint64_t, Tick>> in_flight;
+    for (const auto& events : event_queue) {
+        for (const auto& event : events.second) {
+            if (get<0>(event) != workload || get<2>(event) == nullptr) {
+                continue;
+            }
+            auto* wlhd = static_cast<WorkloadLayerHandlerData*>(get<2>(event));
+            in_flight.emplace_back(wlhd->node_id, events.first);
+        }
+    }
+    return in_flight;
+}
+
+void Sys::notify_workload_finished() {
+    finished_workloads++;
+    int active_sys = 0;
+    for (auto sys : all_sys) {
+        if (sys != nullptr) {
+            active_sys++;
+        }
+    }
+    if (finished_workloads == active_sys && utilization_window > 0) {
+        dump_utilization_heatmaps();
+    }
+    if (finished_workloads == active_sys &&
+        !critical_path_report_path.empty()) {
+        dump_critical_path_reports();
+    }
+}
+
+void Sys::dump_critical_path_reports() {
+    // a JSON array with the report of every NPU, see CriticalPathTracker
+    string path;
+    for (auto sys : all_sys) {
+        if (sys != nullptr) {
+            path = sys->critical_path_report_path;
+            break;
+        }
+    }
+    ofstream out_file(path, ios_base::out | ios_base::trunc);
+    if (!out_file.is_open()) {
+        sys_panic("Unable to create critical path report: " + path);
+    }
+    out_file << '[';
+    bool first = true;
+    for (auto sys : all_sys) {
+        if (sys == nullptr || sys->workload->critical_path_report.empty()) {
+            continue;
+        }
+        if (!first) {
+            out_file << ",\n";
+        }
+        out_file << sys->workload->critical_path_report;
+        first = false;
+    }
+    out_file << "]\n";
+    system_logger->info("critical path report written to {}", path);
+}
+
+void Sys::try_fast_forward() {
+    // a workload can only stop early when every peer it communicates with
+    // stops as well, so the decision is global
+    for (auto sys : all_sys) {
+        if (sys == nullptr) {
+            continue;
+        }
+        if (!sys->workload->is_finished && !sys->workload->is_steady()) {
+            return;
+        }
+    }
+    for (auto sys : all_sys) {
+        if (sys != nullptr && !sys->workload->is_finished) {
+            sys->workload->fast_forward();
+        }
+    }
+}
+
+void Sys::dump_utilization_heatmaps() {
+    // one file per dimension: a row per window, a column per NPU
+    Sys* ref = nullptr;
+    for (auto sys : all_sys) {
+        if (sys != nullptr) {
+            ref = sys;
+            break;
+        }
+    }
+    if (ref == nullptr) {
+        return;
+    }
+    Tick window = ref->utilization_window;
+    uint64_t dims_count = ref->scheduler_unit->usage.size();
+    string extension =
+        ref->utilization_heatmap_format == CSVWriter::Format::Binary ? ".bin"
+                                                                     : ".csv";
+    for (uint64_t dim = 0; dim < dims_count; dim++) {
+        CSVWriter writer(
+            ref->utilization_heatmap_path,
+            "utilization_heatmap_dim" + to_string(dim + 1) + extension,
+            ref->utilization_heatmap_format);
+        vector<int> npus;
+        vector<vector<double>> percentages;
+        uint64_t windows = 0;
+        for (auto sys : all_sys) {
+            if (sys == nullptr) {
+                continue;
+            }
+            UsageTracker& tracker = sys->scheduler_unit->usage[dim];
+            tracker.flush();
+            npus.push_back(sys->id);
+            percentages.push_back(tracker.window_percentage());
+            windows = max<uint64_t>(windows, percentages.back().size());
+        }
+        vector<uint64_t> window_end;
+        window_end.reserve(windows);
+        for (uint64_t i = 1; i <= windows; i++) {
+            window_end.push_back(i * window);
+        }
+        writer.add_column("window end (cycles)", std::move(window_end));
+        for (uint64_t i = 0; i < npus.size(); i++) {
+            writer.add_column("npu" + to_string(npus[i]),
+                              std::move(percentages[i]));
+        }
+        writer.flush();
+    }
 }
 
 void Sys::call(EventType type, CallData* data) {}
@@ -572,9 +855,8 @@ void Sys::call_events() {
             pending_events--;
             (get<0>(callable))->call(get<1>(callable), get<2>(callable));
         } catch (const std::exception& e) {
-            auto logger = LoggerFactory::get_logger("system");
-            logger->critical("warning! a callable is removed before call {}",
-                             e.what());
+            system_logger->critical(
+                "warning! a callable is removed before call {}", e.what());
         }
     }
     if (event_queue[Sys::boostedTick()].size() > 0) {
@@ -594,29 +876,63 @@ void Sys::try_register_event(Callable* callable,
                              EventType event,
                              CallData* callData,
                              Tick& delta_cycles) {
-    bool should_schedule = false;
     auto event_time = Sys::boostedTick() + delta_cycles;
     if (event_queue.find(event_time) == event_queue.end()) {
         list<tuple<Callable*, EventType, CallData*>> tmp;
         event_queue[event_time] = tmp;
-        should_schedule = true;
+        // join the last batch of the tick only if nothing else was queued
+        // for that tick since its backend event; otherwise this Sys's turn
+        // comes after those events, so it starts a new batch with its own
+        // backend event
+        deque<DispatchBatch>& batches = dispatch_queue[event_time];
+        bool join = false;
+        if (coalesce_backend_events && !batches.empty()) {
+            const DispatchBatch& last = batches.back();
+            if (last.scheduled >= 0) {
+                join = last.scheduled == comm_NI->sim_scheduled_events_ns(
+                                             event_time * CLOCK_PERIOD);
+            } else {
+                join = last.sequence == backend_sequence;
+            }
+        }
+        if (!join) {
+            comm_NI->sim_schedule_ns(delta_cycles * CLOCK_PERIOD,
+                                     &Sys::dispatch_events, nullptr);
+            batches.push_back(DispatchBatch{
+                vector<int>(), backend_sequence,
+                comm_NI->sim_scheduled_events_ns(event_time * CLOCK_PERIOD)});
+        }
+        batches.back().ids.push_back(id);
     }
     event_queue[event_time].push_back(make_tuple(callable, event, callData));
-    if (should_schedule) {
-        timespec_t tmp;
-        tmp.time_res = NS;
-        tmp.time_val = delta_cycles;
-        BasicEventHandlerData* data =
-            new BasicEventHandlerData(id, EventType::CallEvents);
-        data->sys_id = id;
-        comm_NI->sim_schedule(tmp, &Sys::handleEvent, data);
-    }
     delta_cycles = 0;
     pending_events++;
     return;
 }
 
+void Sys::dispatch_events(void* arg) {
+    backend_sequence++;
+    auto dispatch = dispatch_queue.find(Sys::boostedTick());
+    if (dispatch == dispatch_queue.end()) {
+        return;
+    }
+    // backend events of a tick fire in the order they were scheduled, so this
+    // one belongs to the oldest batch; a Sys that registers another event at
+    // this tick after its turn starts a new batch behind the pending events
+    vector<int> ids = std::move(dispatch->second.front().ids);
+    dispatch->second.pop_front();
+    if (dispatch->second.empty()) {
+        dispatch_queue.erase(dispatch);
+    }
+    for (int id : ids) {
+        if (all_sys[id] != nullptr) {
+            all_sys[id]->call_events();
+        }
+    }
+}
+
 void Sys::handleEvent(void* arg) {
+    backend_sequence++;
     if (arg == nullptr) {
         return;
     }
@@ -780,21 +1096,31 @@ DataSet* Sys::generate_collective(
     ComType collective_type,
     int explicit_priority,
     CommunicatorGroup* communicator_group) {
-    uint64_t chunk_size = determine_chunk_size(size, collective_type);
+    uint64_t chunk_size =
+        determine_chunk_size(size, collective_type, dimensions_involved);
     uint64_t recommended_chunk_size = chunk_size;
     int streams = ceil(((double)size) / chunk_size);
     uint64_t remain_size;
     DataSet* dataset = new DataSet(streams);
     int pri = get_priority(explicit_priority);
     int count = 0;
-    if (id == 0 && (inter_dimension_scheduling ==
-                        InterDimensionScheduling::OfflineGreedy ||
-                    inter_dimension_scheduling ==
-                        InterDimensionScheduling::OfflineGreedyFlex)) {
-        if (last_scheduled_collective != Sys::boostedTick()) {
-            offline_greedy->reset_loads();
-            last_scheduled_collective = Sys::boostedTick();
+    shared_ptr<const CollectiveSchedule> themis_schedule = nullptr;
+    if (collective_type != ComType::All_to_All &&
+        (inter_dimension_scheduling ==
+             InterDimensionScheduling::OfflineGreedy ||
+         inter_dimension_scheduling ==
+             InterDimensionScheduling::OfflineGreedyFlex)) {
+        // the whole collective is scheduled once and shared by all ranks;
+        // each rank then picks its chunks by index
+        const RingTopology::Table* group = nullptr;
+        long long first_chunk_id = num_streams;
+        if (communicator_group != nullptr) {
+            group = communicator_group->members.get();
+            first_chunk_id = communicator_group->num_streams;
         }
+        themis_schedule = offline_greedy->get_collective_schedule(
+            group, first_chunk_id, size, recommended_chunk_size,
+            dimensions_involved, inter_dimension_scheduling, collective_type);
     }
 
     while (size > 0) {
@@ -816,16 +1142,12 @@ DataSet* Sys::generate_collective(
                 topology->get_num_of_dimensions()) {
                 round_robin_inter_dimension_scheduler = 0;
             }
-        } else if (collective_type != ComType::All_to_All &&
-                   (inter_dimension_scheduling ==
-                        InterDimensionScheduling::OfflineGreedy ||
-                    inter_dimension_scheduling ==
-                        InterDimensionScheduling::OfflineGreedyFlex)) {
-            uint64_t prev_size = size;
-            dim_mapper = offline_greedy->get_chunk_scheduling(
-                num_streams, size, recommended_chunk_size, dimensions_involved,
-                inter_dimension_scheduling, collective_type);
-            chunk_size = prev_size - size;
+        } else if (themis_schedule != nullptr) {
+            uint64_t chunk =
+                min<uint64_t>(count, themis_schedule->dim_order.size()) - 1;
+            dim_mapper = themis_schedule->dim_order[chunk];
+            chunk_size = themis_schedule->chunk_size[chunk];
+            size -= chunk_size;
         }
 
         if (collective_type == ComType::All_to_All ||
@@ -856,7 +1178,7 @@ DataSet* Sys::generate_collective(
                     collective_type,
                     topology->get_basic_topology_at_dimension(dim_mapper[dim],
                                                               collective_type),
-                    remain_size, queue.first, queue.second,
+                    dim_mapper[dim], remain_size, queue.first, queue.second,
                     InjectionPolicy::Normal,
                     implementation_per_dimension[dim_mapper[dim]]);
                 vect.push_back(phase);
@@ -883,7 +1205,7 @@ DataSet* Sys::generate_collective(
                     ComType::Reduce_Scatter,
                     topology->get_basic_topology_at_dimension(
                         dim_mapper[dim], ComType::Reduce_Scatter),
-                    remain_size, queue.first, queue.second,
+                    dim_mapper[dim], remain_size, queue.first, queue.second,
                     InjectionPolicy::Normal,
                     implementation_per_dimension[dim_mapper[dim]]);
                 vect.push_back(phase);
@@ -904,7 +1226,7 @@ DataSet* Sys::generate_collective(
                     ComType::All_Gather,
                     topology->get_basic_topology_at_dimension(
                         dim_mapper[dim], ComType::All_Gather),
-                    remain_size, queue.first, queue.second,
+                    dim_mapper[dim], remain_size, queue.first, queue.second,
                     InjectionPolicy::Normal,
                     implementation_per_dimension[dim_mapper[dim]]);
                 vect.push_back(phase);
@@ -954,7 +1276,7 @@ DataSet* Sys::generate_collective(
                     ComType::Reduce_Scatter,
                     topology->get_basic_topology_at_dimension(
                         dim_mapper[dim], ComType::Reduce_Scatter),
-                    remain_size, queue.first, queue.second,
+                    dim_mapper[dim], remain_size, queue.first, queue.second,
                     InjectionPolicy::Normal,
                     implementation_per_dimension[dim_mapper[dim]]);
                 vect.push_back(phase);
@@ -983,7 +1305,7 @@ DataSet* Sys::generate_collective(
                     ComType::All_Reduce,
                     topology->get_basic_topology_at_dimension(
                         dim_mapper[dim], ComType::All_Reduce),
-                    remain_size, queue.first, queue.second,
+                    dim_mapper[dim], remain_size, queue.first, queue.second,
                     InjectionPolicy::Normal,
                     implementation_per_dimension[dim_mapper[dim]]);
                 vect.push_back(phase);
@@ -1007,7 +1329,7 @@ DataSet* Sys::generate_collective(
                     ComType::All_Gather,
                     topology->get_basic_topology_at_dimension(
                         dim_mapper[dim], ComType::All_Gather),
-                    remain_size, queue.first, queue.second,
+                    dim_mapper[dim], remain_size, queue.first, queue.second,
                     InjectionPolicy::Normal,
                     implementation_per_dimension[dim_mapper[dim]]);
                 vect.push_back(phase);
@@ -1017,7 +1339,7 @@ DataSet* Sys::generate_collective(
         if (vect.size() > 0) {
             int stream_id = num_streams++;
             if (communicator_group != nullptr) {
-                stream_id = communicator_group->num_streams++;
+                stream_id = communicator_group->next_stream_id();
             }
             StreamBaseline* newStream =
                 new StreamBaseline(this, dataset, stream_id, vect, pri);
@@ -1037,11 +1359,18 @@ DataSet* Sys::generate_collective(
 CollectivePhase Sys::generate_collective_phase(
     ComType collective_type,
     BasicLogicalTopology* topology,
+    int dimension,
     uint64_t data_size,
     int queue_id,
     RingTopology::Direction direction,
     InjectionPolicy injection_policy,
     CollectiveImpl* collective_impl) {
+    if (collective_impl->type == CollectiveImplType::Auto) {
+        CollectiveTuner::Choice choice = collective_tuner->select(
+            collective_type, dimension, (RingTopology*)topology, data_size);
+        collective_impl = choice.implementation;
+        topology = choice.topology;
+    }
     if (collective_impl->type == CollectiveImplType::Ring ||
         collective_impl->type == CollectiveImplType::OneRing) {
         CollectivePhase vn(this, queue_id,
@@ -1071,12 +1400,45 @@ CollectivePhase Sys::generate_collective_phase(
                                                (RingTopology*)topology,
                                                data_size));
         return vn;
+    } else if (collective_impl->type == CollectiveImplType::PipelinedRing) {
+        CollectivePhase vn(this, queue_id,
+                           new PipelinedRing(collective_type, id,
+                                             (RingTopology*)topology, data_size,
+                                             direction,
+                                             collective_slice_bytes));
+        return vn;
+    } else if (collective_impl->type ==
+               CollectiveImplType::PipelinedDoubleBinaryTree) {
+        CollectivePhase vn(this, queue_id,
+                           new PipelinedTreeAllReduce(id, (BinaryTree*)topology,
+                                                      data_size,
+                                                      collective_slice_bytes));
+        return vn;
+    } else if (collective_impl->type ==
+               CollectiveImplType::InNetworkReduction) {
+        CollectivePhase vn(this, queue_id,
+                           new InNetworkReduction(collective_type, id,
+                                                  (RingTopology*)topology,
+                                                  data_size,
+                                                  in_network_reduction_bw));
+        return vn;
+    } else if (collective_impl->type == CollectiveImplType::Bruck) {
+        CollectivePhase vn(
+            this, queue_id,
+            new Bruck(collective_type, id, (RingTopology*)topology, data_size));
+        return vn;
+    } else if (collective_impl->type == CollectiveImplType::PairwiseExchange) {
+        CollectivePhase vn(this, queue_id,
+                           new PairwiseExchange(collective_type, id,
+                                                (RingTopology*)topology,
+                                                data_size));
+        return vn;
     } else if (collective_impl->type == CollectiveImplType::ChakraImpl) {
         string filename = ((ChakraCollectiveImpl*)collective_impl)->filename;
         CollectivePhase vn(this, queue_id, new ChakraImpl(filename, id));
         return vn;
     } else {
-        LoggerFactory::get_logger("system")->critical(
+        system_logger->critical(
             "Error: No known collective implementation for collective phase");
         exit(1);
     }
@@ -1198,18 +1560,80 @@ int Sys::break_dimension(int model_parallel_npu_group) {
     return -1;
 }
 
-uint64_t Sys::determine_chunk_size(uint64_t& size, ComType type) {
-    uint64_t chunk_size = size / preferred_dataset_splits;
+uint64_t Sys::determine_chunk_size(uint64_t& size,
+                                  ComType type,
+                                  const vector<bool>& dimensions_involved) {
+    int splits = preferred_dataset_splits;
+    if (chunk_sizing_policy == ChunkSizingPolicy::Adaptive) {
+        splits = determine_adaptive_splits(size, dimensions_involved);
+    }
+    uint64_t chunk_size = size / splits;
     // We want the collective size to have minimum size, otherwise, there is a
     // possibility of size overflow due to further dividing it to more
     // fine-grained messages
     if (type != ComType::All_Gather && this->total_nodes > chunk_size) {
         chunk_size = this->total_nodes;
-        size = preferred_dataset_splits * chunk_size;
+        size = splits * chunk_size;
     }
     return chunk_size;
 }
 
+int Sys::determine_adaptive_splits(uint64_t size,
+                                   const vector<bool>& dimensions_involved) {
+    // The slowest involved dimension bounds the pipeline, so chunks are sized
+    // against its bandwidth and link latency. dimensions_involved is indexed
+    // by logical dimension; a broken dimension maps back to the physical one.
+    // Bandwidth is in GB/s, i.e. bytes per cycle.
+    double min_bw = -1;
+    double slowest_latency = -1;
+    uint64_t active_dims = 0;
+    for (uint64_t dim = 0; dim < dimensions_involved.size(); dim++) {
+        int physical_dim = static_cast<int>(dim);
+        if (dim_to_break != -1 && physical_dim > dim_to_break) {
+            physical_dim--;
+        }
+        if (!dimensions_involved[dim] ||
+            static_cast<uint64_t>(physical_dim) >= physical_dims.size() ||
+            physical_dims[physical_dim] <= 1) {
+            continue;
+        }
+        active_dims++;
+        double bw = comm_NI->get_BW_at_dimension(physical_dim);
+        if (bw > 0 && (min_bw < 0 || bw < min_bw)) {
+            min_bw = bw;
+            slowest_latency = comm_NI->get_latency_at_dimension(physical_dim);
+        }
+    }
+    if (min_bw <= 0) {
+        // backend does not expose bandwidth, keep the configured splits
+        return preferred_dataset_splits;
+    }
+    // backends that do not report link latency fall back to the endpoint
+    // delay of each message
+    if (slowest_latency <= 0) {
+        slowest_latency = communication_delay;
+    }
+
+    // Each chunk pays the link latency once per step. Keep that cost below
+    // ~1/16 of the chunk's transfer time on the slowest link, within the
+    // configured bounds.
+    const double overhead_factor = 16;
+    uint64_t target_chunk_size = static_cast<uint64_t>(
+        min_bw * max(slowest_latency, 1.0) * overhead_factor);
+    target_chunk_size =
+        max(min_chunk_bytes, min(max_chunk_bytes, target_chunk_size));
+
+    uint64_t splits = (size + target_chunk_size - 1) / target_chunk_size;
+    // Give every involved dimension a chunk to work on when the collective is
+    // large enough to be split that far without going below the minimum.
+    if (splits < active_dims && size / active_dims >= min_chunk_bytes) {
+        splits = active_dims;
+    }
+    // never cut below min_chunk_bytes, but always issue at least one chunk
+    splits = min<uint64_t>(splits, max<uint64_t>(size / min_chunk_bytes, 1));
+    return static_cast<int>(max<uint64_t>(splits, 1));
+}
+
 int Sys::get_priority(int explicit_priority) {
     if (scheduling_policy == SchedulingPolicy::LIFO) {
         return priority_counter++;
@@ -1435,6 +1859,21 @@ void Sys::proceed_to_next_vnet_baseline(StreamBaseline* stream) {
     scheduler_unit->notify_stream_added(stream->current_queue_id);
 }
 
+int Sys::map_front_end_tag(int tag, Sys::FrontEndSendRecvType type) {
+    if (type == Sys::FrontEndSendRecvType::NATIVE) {
+        tag = tag % (Sys::FrontEndSendRecvType::COLLECTIVE -
+                     Sys::FrontEndSendRecvType::NATIVE) +
+              Sys::FrontEndSendRecvType::NATIVE;
+    } else if (type == Sys::FrontEndSendRecvType::COLLECTIVE) {
+        tag = tag % (Sys::FrontEndSendRecvType::RENDEZVOUS -
+                     Sys::FrontEndSendRecvType::COLLECTIVE) +
+              Sys::FrontEndSendRecvType::COLLECTIVE;
+    } else {
+        sys_panic("A type of RENDZVOUS should never issued in frontend");
+    }
+    return tag;
+}
+
 int Sys::front_end_sim_send(Tick delay,
                             void* buffer,
                             uint64_t count,
@@ -1445,17 +1884,7 @@ int Sys::front_end_sim_send(Tick delay,
                             Sys::FrontEndSendRecvType send_type,
                             void (*msg_handler)(void* fun_arg),
                             void* fun_arg) {
-    if (send_type == Sys::FrontEndSendRecvType::NATIVE) {
-        tag = tag % (Sys::FrontEndSendRecvType::COLLECTIVE -
-                     Sys::FrontEndSendRecvType::NATIVE) +
-              Sys::FrontEndSendRecvType::NATIVE;
-    } else if (send_type == Sys::FrontEndSendRecvType::COLLECTIVE) {
-        tag = tag % (Sys::FrontEndSendRecvType::RENDEZVOUS -
-                     Sys::FrontEndSendRecvType::COLLECTIVE) +
-              Sys::FrontEndSendRecvType::COLLECTIVE;
-    } else {
-        sys_panic("A type of RENDZVOUS should never issued in frontend");
-    }
+    tag = map_front_end_tag(tag, send_type);
     if (rendezvous_enabled) {
         return rendezvous_sim_send(delay, buffer, count, type, dst, tag,
                                    request, msg_handler, fun_arg);
@@ -1475,17 +1904,7 @@ int Sys::front_end_sim_recv(Tick delay,
                             Sys::FrontEndSendRecvType recv_type,
                             void (*msg_handler)(void* fun_arg),
                             void* fun_arg) {
-    if (recv_type == Sys::FrontEndSendRecvType::NATIVE) {
-        tag = tag % (Sys::FrontEndSendRecvType::COLLECTIVE -
-                     Sys::FrontEndSendRecvType::NATIVE) +
-              Sys::FrontEndSendRecvType::NATIVE;
-    } else if (recv_type == Sys::FrontEndSendRecvType::COLLECTIVE) {
-        tag = tag % (Sys::FrontEndSendRecvType::RENDEZVOUS -
-                     Sys::FrontEndSendRecvType::COLLECTIVE) +
-              Sys::FrontEndSendRecvType::COLLECTIVE;
-    } else {
-        sys_panic("A type of RENDZVOUS should never issued in frontend");
-    }
+    tag = map_front_end_tag(tag, recv_type);
     if (rendezvous_enabled) {
         return rendezvous_sim_recv(delay, buffer, count, type, src, tag,
                                    request, msg_handler, fun_arg);
@@ -1495,6 +1914,42 @@ int Sys::front_end_sim_recv(Tick delay,
     }
 }
 
+int Sys::front_end_sim_send_batch(std::vector<sim_message>& messages,
+                                  Sys::FrontEndSendRecvType send_type) {
+    if (rendezvous_enabled) {
+        for (auto& msg : messages) {
+            front_end_sim_send(0, msg.buffer, msg.count, msg.type, msg.peer,
+                               msg.tag, &msg.request, send_type,
+                               msg.msg_handler, msg.fun_arg);
+        }
+        return 1;
+    }
+    for (auto& msg : messages) {
+        msg.tag = map_front_end_tag(msg.tag, send_type);
+    }
+    comm_NI->sim_send_batch(messages);
+    backend_sequence++;
+    return 1;
+}
+
+int Sys::front_end_sim_recv_batch(std::vector<sim_message>& messages,
+                                  Sys::FrontEndSendRecvType recv_type) {
+    if (rendezvous_enabled) {
+        for (auto& msg : messages) {
+            front_end_sim_recv(0, msg.buffer, msg.count, msg.type, msg.peer,
+                               msg.tag, &msg.request, recv_type,
+                               msg.msg_handler, msg.fun_arg);
+        }
+        return 1;
+    }
+    for (auto& msg : messages) {
+        msg.tag = map_front_end_tag(msg.tag, recv_type);
+    }
+    comm_NI->sim_recv_batch(messages);
+    backend_sequence++;
+    return 1;
+}
+
 int Sys::rendezvous_sim_send(Tick delay,
                              void* buffer,
                              uint64_t count,
@@ -1563,6 +2018,7 @@ int Sys::sim_send(Tick delay,
     if (delay == 0) {
         comm_NI->sim_send(buffer, count, type, dst, tag, request, msg_handler,
                           fun_arg);
+        backend_sequence++;
     } else {
         try_register_event(new SimSendCaller(this, buffer, count, type, dst,
                                              tag, *request, msg_handler,
@@ -1584,6 +2040,7 @@ int Sys::sim_recv(Tick delay,
     if (delay == 0) {
         comm_NI->sim_recv(buffer, count, type, src, tag, request, msg_handler,
                           fun_arg);
+        backend_sequence++;
     } else {
         try_register_event(new SimRecvCaller(this, buffer, count, type, src,
                                              tag, *request, msg_handler,
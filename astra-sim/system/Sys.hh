@@ -7,6 +7,7 @@ LICENSE file in the root directory of this source tree.
 #define __SYSTEM_HH__
 
 #include <chrono>
+#include <deque>
 
 #include "astra-sim/common/AstraNetworkAPI.hh"
 #include "astra-sim/system/AstraRemoteMemoryAPI.hh"
@@ -29,6 +30,7 @@ class Workload;
 class LogicalTopology;
 class BasicLogicalTopology;
 class OfflineGreedy;
+class CollectiveTuner;
 
 class Sys : public Callable {
   public:
@@ -91,11 +93,29 @@ class Sys : public Callable {
     static void sys_panic(std::string msg);
     //---------------------------------------------------------------------------
 
+    // Statistics
+    // ---------------------------------------------------------------
+    void notify_workload_finished();
+    // fast-forward every workload once all unfinished ones are steady
+    static void try_fast_forward();
+    static void dump_utilization_heatmaps();
+    static void dump_critical_path_reports();
+    //---------------------------------------------------------------------------
+
     // Simulation Loop
     // ----------------------------------------------------------
     void exit_sim_loop(std::string msg);
     //---------------------------------------------------------------------------
 
+    // Checkpoint
+    // ---------------------------------------------------------------
+    // true if no stream is running and the only pending events are the
+    // completions of in-flight compute nodes of the workload
+    bool is_quiescent() const;
+    // (node id, finish tick) of the in-flight compute nodes
+    std::vector<std::pair<uint64_t, Tick>> get_in_flight_nodes() const;
+    //---------------------------------------------------------------------------
+
     // General Event Handling
     // ---------------------------------------------------
     void call(EventType type, CallData* data);
@@ -109,6 +129,8 @@ class Sys : public Callable {
                             CallData* callData,
                             Tick& delta_cycles);
     static void handleEvent(void* arg);
+    // runs call_events of the Sys instances queued at the current tick
+    static void dispatch_events(void* arg);
     //---------------------------------------------------------------------------
 
     // Communicator Group Support
@@ -146,6 +168,7 @@ class Sys : public Callable {
         CommunicatorGroup* communicator_group);
     CollectivePhase generate_collective_phase(ComType collective_type,
                                               BasicLogicalTopology* topology,
+                                              int dimension,
                                               uint64_t data_size,
                                               int queue_id,
                                               RingTopology::Direction direction,
@@ -156,7 +179,11 @@ class Sys : public Callable {
 
     // Middle-level Network Primitives
     // ------------------------------------------
-    uint64_t determine_chunk_size(uint64_t& size, ComType type);
+    uint64_t determine_chunk_size(uint64_t& size,
+                                  ComType type,
+                                  const std::vector<bool>& dimensions_involved);
+    int determine_adaptive_splits(uint64_t size,
+                                  const std::vector<bool>& dimensions_involved);
     int get_priority(int explicit_priority);
     void insert_into_ready_list(BaseStream* stream);
     void insert_stream(std::list<BaseStream*>* queue, BaseStream* baseStream);
@@ -180,6 +207,8 @@ class Sys : public Callable {
         COLLECTIVE = 500000000,
         RENDEZVOUS = 1000000000
     };
+    int map_front_end_tag(int tag, FrontEndSendRecvType type);
+
     int front_end_sim_send(Tick delay,
                            void* buffer,
                            uint64_t count,
@@ -202,6 +231,15 @@ class Sys : public Callable {
                            void (*msg_handler)(void* fun_arg),
                            void* fun_arg);
 
+    // Batched versions of front_end_sim_send/recv for messages issued at the
+    // current tick. The tags in `messages` are mapped in place; with
+    // rendezvous enabled every message falls back to the per-message path.
+    int front_end_sim_send_batch(std::vector<sim_message>& messages,
+                                 FrontEndSendRecvType send_type);
+
+    int front_end_sim_recv_batch(std::vector<sim_message>& messages,
+                                 FrontEndSendRecvType recv_type);
+
     int rendezvous_sim_send(Tick delay,
                             void* buffer,
                             uint64_t count,
@@ -244,6 +282,29 @@ class Sys : public Callable {
     //---------------------------------------------------------------------------
 
     static std::vector<Sys*> all_sys;  // vector of all Sys objects
+    // Sys instances that registered events at a tick back to back share one
+    // backend event, which calls them in registration order. `scheduled` is
+    // the backend's count of events queued for the tick right after the
+    // batch's own event (AstraNetworkAPI::sim_scheduled_events_ns), or -1 if
+    // the backend cannot tell; `sequence` is the value of backend_sequence
+    // when the batch was scheduled.
+    struct DispatchBatch {
+        std::vector<int> ids;
+        uint64_t sequence;
+        int64_t scheduled;
+    };
+    // batches of a tick, in the order their backend events were scheduled
+    static std::map<Tick, std::deque<DispatchBatch>> dispatch_queue;
+    // Fallback for backends without a per-tick count. Counts every send,
+    // receive and remote memory access Sys hands to the backend and every
+    // backend callback into Sys, i.e. everything that may schedule a backend
+    // event at an unknown tick, so a batch is only joined within one
+    // callback. Dispatch events are not counted, their tick is known and only
+    // batches of that tick are joined.
+    static uint64_t backend_sequence;
+    // false schedules one backend event per Sys and tick, the reference order
+    // that the coalesced dispatch has to reproduce
+    static bool coalesce_backend_events;
 
     int id;
     bool initialized;
@@ -280,6 +341,15 @@ class Sys : public Callable {
     SchedulerUnit* scheduler_unit;
     QueueLevels* vLevels;
     OfflineGreedy* offline_greedy;
+    // picks the algorithm of phases on dimensions configured as "auto"
+    CollectiveTuner* collective_tuner;
+    // threshold table of the tuner, reused if the file exists
+    std::string collective_tuner_table_path;
+    // slice size of the pipelined ring and tree implementations
+    uint64_t collective_slice_bytes;
+    // aggregation throughput (GB/s) of the switches of "inNetworkReduction"
+    // dimensions, 0 for unlimited
+    double in_network_reduction_bw;
     IntraDimensionScheduling intra_dimension_scheduling;
     InterDimensionScheduling inter_dimension_scheduling;
     int round_robin_inter_dimension_scheduler;
@@ -287,6 +357,9 @@ class Sys : public Callable {
     int priority_counter;
     uint64_t pending_events;
     int preferred_dataset_splits;
+    ChunkSizingPolicy chunk_sizing_policy;
+    uint64_t min_chunk_bytes;
+    uint64_t max_chunk_bytes;
     int concurrent_streams;
     int active_first_phase;
     int max_running;
@@ -317,15 +390,32 @@ class Sys : public Callable {
     std::vector<CollectiveImpl*> all_gather_implementation_per_dimension;
     std::vector<CollectiveImpl*> all_to_all_implementation_per_dimension;
     CollectiveOptimization collectiveOptimization;
-    Tick last_scheduled_collective;
     bool break_dimension_done;
     int dimension_to_break;
 
     // statistics
     bool trace_enabled;
+    Tick utilization_window;
+    std::string utilization_heatmap_path;
+    // "csv" (default) or "binary" (column-major, see CSVWriter::flush_binary)
+    CSVWriter::Format utilization_heatmap_format;
+    // JSON file of the per-NPU critical path reports, empty to disable
+    std::string critical_path_report_path;
+    static int finished_workloads;
 
     // skip simulation for all nodes and use current duration
     bool replay_only;
+
+    // steady-state fast-forward: once the last steady_state_iterations
+    // iteration durations agree within steady_state_tolerance (relative),
+    // the remaining iterations are extrapolated instead of simulated
+    int steady_state_iterations;
+    double steady_state_tolerance;
+    // name of the ET node that ends an iteration (in addition to nodes
+    // with the "is_iteration_end" attribute)
+    std::string iteration_marker;
+    // 0: taken from the "num_iterations" attribute of the marker node
+    uint64_t total_iterations;
 };
 
 }  // namespace AstraSim
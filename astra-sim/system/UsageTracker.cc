@@ -8,19 +8,71 @@
  #include "astra-sim/system/UsageTracker.hh"  // 资源使用跟踪器的头文件
  #include "astra-sim/system/Sys.hh"           // 包含系统时间相关操作
  
+ #include <algorithm>
+ #include <cassert>
+ #include <string>
+ #include <vector>
+ 
  using namespace AstraSim;  // 使用 AstraSim 命名空间，避免冗长的前缀
  
  /**
   * @brief UsageTracker 构造函数
   * @param levels 资源使用的最大等级（表示最大负载程度）
+  * @param window 在线统计窗口大小（周期数），0 表示不做在线统计
+  * @param record_segments 是否保存完整的时间段序列
   * 
   * 初始化 `levels`（最大使用等级），`current_level`（当前等级）设为 0，
   * `last_tick`（上次使用变化的时间戳）设为 0。
   */
- UsageTracker::UsageTracker(int levels) {
+ UsageTracker::UsageTracker(int levels, Tick window, bool record_segments) {
+     assert(levels > 0 && levels <= 256);  // 等级使用一个字节存储
      this->levels = levels;
      this->current_level = 0;
      this->last_tick = 0;
+     this->window = window;
+     this->record_segments = record_segments;
+     this->usage_count = 0;
+ }
+ 
+ /**
+  * @brief 记录从 `last_tick` 到 `now` 的时间段
+  * @param now 当前时间戳
+  * 
+  * 时间段总是首尾相接的，因此只需保存持续时间（即时间戳增量）和等级。
+  * 持续时间为 0 的时间段对统计没有贡献，直接丢弃。未开启
+  * `record_segments` 时只累加窗口活动量，不保存时间段。
+  */
+ void UsageTracker::append_usage(Tick now) {
+     if (now <= last_tick) {
+         return;
+     }
+     uint64_t duration = now - last_tick;
+ 
+     // 在线累加每个窗口的活动量
+     if (window > 0 && current_level > 0) {
+         Tick begin = last_tick;
+         while (begin < now) {
+             uint64_t index = begin / window;
+             Tick end = std::min(now, (index + 1) * window);
+             if (window_activity.size() <= index) {
+                 window_activity.resize(index + 1, 0);
+             }
+             window_activity[index] += (end - begin) * current_level;
+             begin = end;
+         }
+     }
+ 
+     // varint 编码持续时间，随后写入一个字节的等级
+     if (record_segments) {
+         while (duration >= 0x80) {
+             encoded.push_back(static_cast<uint8_t>(duration | 0x80));
+             duration >>= 7;
+         }
+         encoded.push_back(static_cast<uint8_t>(duration));
+         encoded.push_back(static_cast<uint8_t>(current_level));
+         usage_count++;
+     }
+     last_tick = now;
  }
  
  /**
@@ -30,10 +82,8 @@
   */
  void UsageTracker::increase_usage() {
      if (current_level < levels - 1) {  // 确保不会超过最大使用等级
-         Usage u(current_level, last_tick, Sys::boostedTick());  // 记录当前使用情况
-         usage.push_back(u);  // 将该使用记录存入 usage 列表
+         append_usage(Sys::boostedTick());  // 记录当前使用情况
          current_level++;  // 增加当前使用等级
-         last_tick = Sys::boostedTick();  // 更新最新的时间戳
      }
  }
  
@@ -44,10 +94,8 @@
   */
  void UsageTracker::decrease_usage() {
      if (current_level > 0) {  // 确保不会低于最低等级
-         Usage u(current_level, last_tick, Sys::boostedTick());  // 记录当前使用情况
-         usage.push_back(u);  // 将该使用记录存入 usage 列表
+         append_usage(Sys::boostedTick());  // 记录当前使用情况
          current_level--;  // 减少当前使用等级
-         last_tick = Sys::boostedTick();  // 更新最新的时间戳
      }
  }
  
@@ -59,26 +107,35 @@
   */
  void UsageTracker::set_usage(int level) {
      if (current_level != level) {  // 只有当前等级不同才进行更新
-         Usage u(current_level, last_tick, Sys::boostedTick());  // 记录当前使用情况
-         usage.push_back(u);  // 将该使用记录存入 usage 列表
+         append_usage(Sys::boostedTick());  // 记录当前使用情况
          current_level = level;  // 更新当前使用等级
-         last_tick = Sys::boostedTick();  // 更新最新的时间戳
      }
  }
  
  /**
-  * @brief 生成资源使用情况的 CSV 报告
-  * @param writer CSVWriter 对象，用于写入数据
-  * @param offset 数据列的偏移量
+  * @brief 将当前时间段记录到当前时刻，使用等级保持不变
+  */
+ void UsageTracker::flush() {
+     append_usage(Sys::boostedTick());
+ }
+ 
+ /**
+  * @brief 生成资源使用情况报告
+  * @param writer 列式统计写入器，数据在 writer 刷新时一次性顺序写出
+  * @param offset 该跟踪器的编号（如 NPU 或维度编号），用于生成列名
   */
  void UsageTracker::report(CSVWriter* writer, int offset) {
-     uint64_t col = offset * 3;  // 计算列偏移量
-     uint64_t row = 1;  // 从第一行开始写入
-     for (auto a : usage) {
-         writer->write_cell(row, col, std::to_string(a.start));  // 写入起始时间
-         writer->write_cell(row++, col + 1, std::to_string(a.level));  // 写入使用等级
-     }
-     return;
+     std::vector<uint64_t> start;  // 每段使用记录的起始时间
+     std::vector<uint64_t> level;  // 每段使用记录的使用等级
+     start.reserve(usage_count);
+     level.reserve(usage_count);
+     for_each_usage([&](const Usage& a) {
+         start.push_back(a.start);
+         level.push_back(static_cast<uint64_t>(a.level));
+     });
+     const std::string prefix = std::to_string(offset);
+     writer->add_column(prefix + " start", std::move(start));  // 写入起始时间列
+     writer->add_column(prefix + " level", std::move(level));  // 写入使用等级列
  }
  
  /**
@@ -87,38 +144,81 @@
   * @return 返回一个列表，每个元素为 `(时间戳, 资源使用百分比)`
   */
  std::list<std::pair<uint64_t, double>> UsageTracker::report_percentage(uint64_t cycles) {
-     decrease_usage();  // 先减少使用，以确保所有的使用数据正确存储
-     increase_usage();  // 重新增加，以确保数据完整
+     flush();  // 先把当前时间段记录下来，确保数据完整
+ 
+     std::list<std::pair<uint64_t, double>> result;  // 结果存储列表
+ 
+     // 周期为在线统计窗口的整数倍时，直接合并在线累加的窗口
+     if (window > 0 && cycles > 0 && cycles % window == 0) {
+         uint64_t windows_per_period = cycles / window;
+         std::vector<double> percentages = window_percentage();
+         for (size_t i = 0; i < percentages.size(); i += windows_per_period) {
+             size_t last = std::min(percentages.size(), i + windows_per_period);
+             double sum = 0;
+             for (size_t j = i; j < last; j++) {
+                 sum += percentages[j];
+             }
+             result.push_back(std::make_pair(
+                 static_cast<uint64_t>(i / windows_per_period + 1) * cycles,
+                 sum / windows_per_period));
+         }
+         return result;
+     }
+     // 其他周期需要完整的时间段序列，否则结果为空或错误
+     if (!record_segments || cycles == 0) {
+         Sys::sys_panic("UsageTracker: report_percentage(" +
+                        std::to_string(cycles) +
+                        ") needs record_segments or a multiple of the "
+                        "statistics window (" + std::to_string(window) + ")");
+     }
  
      Tick total_activity_possible = (this->levels - 1) * cycles;  // 计算理论上的最大活动值
-     std::list<Usage>::iterator usage_pointer = this->usage.begin();  // 迭代器指向 `usage` 列表的起始位置
      Tick current_activity = 0;  // 当前活动量
      Tick period_start = 0;  // 计算周期起点
      Tick period_end = cycles;  // 计算周期终点
-     std::list<std::pair<uint64_t, double>> result;  // 结果存储列表
  
-     // 遍历 usage 列表，计算每个周期内的资源使用百分比
-     while (usage_pointer != this->usage.end()) {
-         Usage current_usage = *usage_pointer;  // 获取当前 usage 记录
-         uint64_t begin = std::max(static_cast<uint64_t>(period_start), current_usage.start);  // 计算起始时间
-         uint64_t end = std::min(static_cast<uint64_t>(period_end), current_usage.end);  // 计算结束时间
-         assert(begin <= end);  // 确保时间顺序正确
+     // 遍历所有时间段，计算每个周期内的资源使用百分比
+     for_each_usage([&](const Usage& current_usage) {
+         while (true) {
+             uint64_t begin = std::max(static_cast<uint64_t>(period_start), current_usage.start);  // 计算起始时间
+             uint64_t end = std::min(static_cast<uint64_t>(period_end), current_usage.end);  // 计算结束时间
+             if (begin < end) {
+                 // 计算当前时间段的活动量
+                 current_activity += ((end - begin) * current_usage.level);
+             }
  
-         // 计算当前时间段的活动量
-         current_activity += ((end - begin) * current_usage.level);
- 
-         // 如果当前 usage 记录已经覆盖了当前周期，则计算百分比
-         if (current_usage.end >= period_end) {
+             // 如果当前时间段已经覆盖了当前周期，则计算百分比
+             if (current_usage.end < period_end) {
+                 break;  // 继续处理下一个时间段
+             }
              result.push_back(std::make_pair(
                  (uint64_t)period_end,
                  (((double)current_activity) / total_activity_possible) * 100));  // 计算使用百分比
              period_start += cycles;  // 更新下一个周期的起始点
              period_end += cycles;  // 更新下一个周期的终点
              current_activity = 0;  // 重置当前活动量
-         } else {
-             std::advance(usage_pointer, 1);  // 继续遍历 usage 列表
          }
-     }
+     });
      return result;  // 返回计算结果
  }
- 
\ No newline at end of file
+ 
+ /**
+  * @brief 在线统计得到的每个窗口的资源使用百分比
+  * @return 每个窗口一个百分比，未开启在线统计时返回空列表
+  */
+ std::vector<double> UsageTracker::window_percentage() const {
+     std::vector<double> result;
+     if (window == 0) {
+         return result;
+     }
+     // 尾部空闲的窗口不会产生活动量，按最后记录的时间补齐
+     uint64_t windows = (last_tick + window - 1) / window;
+     windows = std::max<uint64_t>(windows, window_activity.size());
+     result.reserve(windows);
+     double total_activity_possible = (double)(levels - 1) * window;
+     for (uint64_t i = 0; i < windows; i++) {
+         uint64_t activity = i < window_activity.size() ? window_activity[i] : 0;
+         result.push_back(activity / total_activity_possible * 100);
+     }
+     return result;
+ }
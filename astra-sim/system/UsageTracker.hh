@@ -7,6 +7,8 @@ LICENSE file in the root directory of this source tree.
 #define __USAGE_TRACKER_HH__
 
 #include <cstdint>
+#include <list>
+#include <vector>
 
 #include "astra-sim/system/CSVWriter.hh"
 #include "astra-sim/system/Callable.hh"
@@ -18,28 +20,34 @@ namespace AstraSim {
 /**
  * @class UsageTracker
  * @brief 该类用于跟踪资源使用情况，并提供数据报告功能。
- * 
+ *
  * 该类可以记录资源使用的变化，例如 CPU、GPU 或网络的负载情况。
- * 它维护一个 `usage` 列表，其中每个 `Usage` 记录一个时间段内的使用状态。
+ * 若设置了统计窗口，则在记录时在线累加每个窗口的活动量，每个窗口
+ * 只占一个计数器，因此可以为每个 NPU 的每个维度开启跟踪而不会造成
+ * 内存膨胀。只有显式开启 `record_segments` 时，才额外以紧凑的只追加
+ * 时间序列保存每个时间段（varint 持续时间增量 + 一个字节的使用等级），
+ * 供 report() 与任意周期的 report_percentage() 使用。
  */
 class UsageTracker {
   public:
     /**
      * @brief 构造函数
-     * @param levels 资源使用的等级数（越高表示负载越大）
+     * @param levels 资源使用的等级数（越高表示负载越大，最多 256 级）
+     * @param window 在线统计窗口大小（周期数），0 表示不做在线统计
+     * @param record_segments 是否保存完整的时间段序列
      */
-    UsageTracker(int levels);
+    UsageTracker(int levels, Tick window = 0, bool record_segments = false);
 
     /**
      * @brief 增加资源使用等级
-     * 
+     *
      * 如果当前使用等级小于最大等级，则增加等级并记录时间戳。
      */
     void increase_usage();
 
     /**
      * @brief 降低资源使用等级
-     * 
+     *
      * 如果当前使用等级大于 0，则减少等级并记录时间戳。
      */
     void decrease_usage();
@@ -47,15 +55,20 @@ class UsageTracker {
     /**
      * @brief 直接设置资源使用等级
      * @param level 要设置的等级
-     * 
+     *
      * 如果当前等级与指定等级不同，则记录变化并更新时间戳。
      */
     void set_usage(int level);
 
     /**
-     * @brief 生成资源使用报告，并写入 CSV 文件
-     * @param writer CSV 文件写入器
-     * @param offset 数据列偏移量
+     * @brief 将当前正在进行的时间段记录到当前时刻，不改变使用等级
+     */
+    void flush();
+
+    /**
+     * @brief 生成资源使用报告，以两列（起始时间、使用等级）追加到写入器
+     * @param writer 列式统计写入器
+     * @param offset 跟踪器编号，用于生成列名
      */
     void report(CSVWriter* writer, int offset);
 
@@ -63,13 +76,54 @@ class UsageTracker {
      * @brief 计算每个周期的资源使用百分比
      * @param cycles 计算周期（以时钟周期计）
      * @return 返回一个列表，每个元素为 `(时间戳, 资源使用百分比)`
+     *
+     * 若 `cycles` 是在线统计窗口的整数倍，则直接合并在线累加的结果；
+     * 否则需要开启 `record_segments`，未开启时调用 sys_panic。
      */
     std::list<std::pair<uint64_t, double>> report_percentage(uint64_t cycles);
 
+    /**
+     * @brief 返回在线统计得到的每个窗口的资源使用百分比
+     */
+    std::vector<double> window_percentage() const;
+
+    /**
+     * @brief 按时间顺序遍历所有已记录的时间段
+     * @param f 回调函数，参数为 `Usage`（等级、起始时间、结束时间）
+     */
+    template <typename F>
+    void for_each_usage(F f) const {
+        uint64_t start = 0;
+        size_t pos = 0;
+        while (pos < encoded.size()) {
+            uint64_t duration = 0;
+            int shift = 0;
+            uint8_t byte;
+            do {
+                byte = encoded[pos++];
+                duration |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            int level = encoded[pos++];
+            f(Usage(level, start, start + duration));
+            start += duration;
+        }
+    }
+
     int levels;                 ///< 资源使用的最大等级
     int current_level;           ///< 当前使用等级
     Tick last_tick;              ///< 上一次使用等级变化的时间戳
-    std::list<Usage> usage;      ///< 记录资源使用情况的时间片段列表
+    Tick window;                 ///< 在线统计窗口大小（周期数）
+    bool record_segments;        ///< 是否保存完整的时间段序列
+    uint64_t usage_count;        ///< 已记录的时间段数量
+    std::vector<uint8_t> encoded;         ///< 编码后的时间段：varint 持续时间 + 1 字节等级
+    std::vector<uint64_t> window_activity;  ///< 每个窗口内的累计活动量（等级 × 周期）
+
+  private:
+    /**
+     * @brief 记录从 `last_tick` 到 `now` 的时间段（等级为 `current_level`）
+     */
+    void append_usage(Tick now);
 };
 
 }  // namespace AstraSim
@@ -23,7 +23,17 @@ class Algorithm : public Callable {
     /**
      * @brief 支持的集合通信算法名称
      */
-    enum class Name { Ring = 0, DoubleBinaryTree, AllToAll, HalvingDoubling };
+    enum class Name {
+        Ring = 0,
+        DoubleBinaryTree,
+        AllToAll,
+        HalvingDoubling,
+        Bruck,
+        PairwiseExchange,
+        PipelinedRing,
+        PipelinedTree,
+        InNetworkReduction
+    };
 
     /**
      * @brief 默认构造函数，初始化 Algorithm
@@ -53,9 +53,8 @@ void AllToAll::run(EventType event, CallData* data) {
             if (total_packets_received < middle_point) {
                 return;  // 若未接收到足够的数据包，则不进行后续处理
             }
-            for (int i = 0; i < parallel_reduce; i++) {
-                ready(); // 检查是否可以继续执行
-            }
+            // 一次性发出窗口内的全部数据包，发送和接收各只调用一次网络后端
+            issue_packets(parallel_reduce);
             iteratable(); // 确保算法可以继续迭代
         } else {
             ready();
@@ -0,0 +1,32 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/system/collective/Bruck.hh"
+
+#include <algorithm>
+
+using namespace AstraSim;
+
+Bruck::Bruck(ComType type,
+             int id,
+             RingTopology* ring_topology,
+             uint64_t data_size)
+    : ScheduledAllToAll(type, id, ring_topology, data_size) {
+    this->name = Name::Bruck;
+    uint64_t block_size = std::max<uint64_t>(1, data_size / nodes_in_ring);
+    for (int distance = 1; distance < nodes_in_ring; distance <<= 1) {
+        // 偏移量 j（1 <= j < N）中第 k 位为 1 的数据块在这一步发出
+        uint64_t blocks = 0;
+        for (int offset = 1; offset < nodes_in_ring; offset++) {
+            if (offset & distance) {
+                blocks++;
+            }
+        }
+        steps.push_back(
+            {{node_at(distance), node_at(-distance), blocks * block_size}});
+    }
+    // 开始前的旋转与结束后的逆旋转
+    local_copy_bytes = 2 * data_size;
+}
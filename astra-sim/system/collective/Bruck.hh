@@ -0,0 +1,30 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __BRUCK_HH__
+#define __BRUCK_HH__
+
+#include "astra-sim/system/collective/ScheduledAllToAll.hh"
+
+namespace AstraSim {
+
+/**
+ * @brief Bruck All-to-All：ceil(log2 N) 步，时延最优
+ *
+ * 第 k 步把偏移量第 k 位为 1 的所有数据块一起发给环上距离为 2^k 的节点，
+ * 代价是约 N/2 个数据块的多次转发，以及开始/结束时的本地数据旋转。
+ * 适合节点数多、消息小的维度（例如 MoE 的专家并行）。
+ */
+class Bruck : public ScheduledAllToAll {
+  public:
+    Bruck(ComType type,
+          int id,
+          RingTopology* ring_topology,
+          uint64_t data_size);
+};
+
+}  // namespace AstraSim
+
+#endif /* __BRUCK_HH__ */
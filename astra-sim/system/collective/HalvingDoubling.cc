@@ -23,7 +23,33 @@ HalvingDoubling::HalvingDoubling(ComType type,
     this->id = id;
     this->logical_topo = ring_topology;
     this->data_size = data_size;
-    this->nodes_in_ring = ring_topology->get_nodes_in_ring();
+    // Rabenseifner's scheme for any ring size: the first 2 * r ranks (r being
+    // the excess over the largest power of two) pair up, the even one folds
+    // its data onto the odd one and sits out the power-of-two exchange, then
+    // gets the result back.
+    int total_nodes = ring_topology->get_nodes_in_ring();
+    this->nodes_in_ring = 1;
+    while (this->nodes_in_ring * 2 <= total_nodes) {
+        this->nodes_in_ring *= 2;
+    }
+    this->remainder_nodes = total_nodes - this->nodes_in_ring;
+    int index = ring_topology->get_index_in_ring();
+    this->fold_partner = -1;
+    this->folded_out = false;
+    this->stage = Stage::Exchange;
+    if (index < 2 * remainder_nodes) {
+        this->stage = Stage::Fold;
+        this->folded_out = index % 2 == 0;
+        this->fold_partner =
+            ring_topology->id_at(folded_out ? index + 1 : index - 1);
+    }
+    if (folded_out) {
+        this->folded_index = -1;
+    } else if (index < 2 * remainder_nodes) {
+        this->folded_index = index / 2;
+    } else {
+        this->folded_index = index - remainder_nodes;
+    }
     this->parallel_reduce = 1;
     this->total_packets_sent = 0;
     this->total_packets_received = 0;
@@ -51,21 +77,26 @@ HalvingDoubling::HalvingDoubling(ComType type,
     }
     remained_packets_per_message = 1;
     remained_packets_per_max_count = 1;
+    this->fold_size = data_size;
     switch (type) {
     case ComType::All_Reduce:
         this->final_data_size = data_size;
+        this->unfold_size = data_size;
         this->msg_size = data_size / 2;
         this->rank_offset = 1;
         this->offset_multiplier = 2;
         break;
     case ComType::All_Gather:
-        this->final_data_size = data_size * nodes_in_ring;
-        this->msg_size = data_size;
+        this->final_data_size = data_size * total_nodes;
+        this->unfold_size = final_data_size;
+        // ranks holding a folded block gather two; spread evenly
+        this->msg_size = data_size * total_nodes / nodes_in_ring;
         this->rank_offset = nodes_in_ring / 2;
         this->offset_multiplier = 0.5;
         break;
     case ComType::Reduce_Scatter:
-        this->final_data_size = data_size / nodes_in_ring;
+        this->final_data_size = data_size / total_nodes;
+        this->unfold_size = final_data_size;
         this->msg_size = data_size / 2;
         this->rank_offset = 1;
         this->offset_multiplier = 2;
@@ -77,13 +108,28 @@ HalvingDoubling::HalvingDoubling(ComType type,
                 "HalvingDoubling collective algorithm #########");
         std::exit(1);
     }
-    RingTopology::Direction direction = specify_direction();
     this->curr_receiver = id;
-    for (int i = 0; i < rank_offset; i++) {
-        this->curr_receiver =
-            ring_topology->get_receiver(this->curr_receiver, direction);
-        this->curr_sender = curr_receiver;
+    if (!folded_out) {
+        this->curr_receiver = peer_at(rank_offset, specify_direction());
     }
+    this->curr_sender = curr_receiver;
+}
+
+int HalvingDoubling::peer_at(int distance, RingTopology::Direction direction) {
+    int index = direction == RingTopology::Direction::Clockwise
+                    ? folded_index + distance
+                    : folded_index - distance;
+    index %= nodes_in_ring;
+    if (index < 0) {
+        index += nodes_in_ring;
+    }
+    // back from the power-of-two exchange to the position in the ring
+    if (index < remainder_nodes) {
+        index = 2 * index + 1;
+    } else {
+        index += remainder_nodes;
+    }
+    return ((RingTopology*)logical_topo)->id_at(index);
 }
 
 int HalvingDoubling::get_non_zero_latency_packets() {
@@ -94,8 +140,7 @@ RingTopology::Direction HalvingDoubling::specify_direction() {
     if (rank_offset == 0) {
         return RingTopology::Direction::Clockwise;
     }
-    int reminder =
-        (((RingTopology*)logical_topo)->get_index_in_ring() / rank_offset) % 2;
+    int reminder = (folded_index / rank_offset) % 2;
     if (reminder == 0) {
         return RingTopology::Direction::Clockwise;
     } else {
@@ -104,6 +149,10 @@ RingTopology::Direction HalvingDoubling::specify_direction() {
 }
 
 void HalvingDoubling::run(EventType event, CallData* data) {
+    if (stage != Stage::Exchange) {
+        run_fold(event);
+        return;
+    }
     if (event == EventType::General) {
         free_packets += 1;
         ready();
@@ -118,6 +167,68 @@ void HalvingDoubling::run(EventType event, CallData* data) {
     }
 }
 
+void HalvingDoubling::run_fold(EventType event) {
+    if (event == EventType::StreamInit) {
+        if (stream->state == StreamState::Created ||
+            stream->state == StreamState::Ready) {
+            stream->changeState(StreamState::Executing);
+        }
+        if (folded_out) {
+            receive_from(fold_partner, unfold_size);
+            (new PacketBundle(stream->owner, stream, false, false, fold_size,
+                              transmition))
+                ->send_to_MA();
+        } else {
+            receive_from(fold_partner, fold_size);
+        }
+    } else if (event == EventType::General) {
+        if (folded_out) {
+            send_to(fold_partner, fold_size);
+        } else if (stage == Stage::Fold) {
+            // folded data merged, start the power-of-two exchange
+            stage = Stage::Exchange;
+            for (int i = 0; i < parallel_reduce; i++) {
+                insert_packet(nullptr);
+            }
+        } else {
+            send_to(fold_partner, unfold_size);
+            finish();
+        }
+    } else if (event == EventType::PacketReceived) {
+        if (folded_out) {
+            finish();
+        } else {
+            (new PacketBundle(stream->owner, stream,
+                              comType != ComType::All_Gather, false, fold_size,
+                              transmition))
+                ->send_to_NPU();
+        }
+    }
+}
+
+void HalvingDoubling::send_to(int dest, uint64_t size) {
+    sim_request snd_req;
+    snd_req.srcRank = id;
+    snd_req.dstRank = dest;
+    snd_req.tag = stream->stream_id;
+    snd_req.reqType = UINT8;
+    snd_req.vnet = this->stream->current_queue_id;
+    stream->owner->front_end_sim_send(
+        0, Sys::dummy_data, size, UINT8, dest, stream->stream_id, &snd_req,
+        Sys::FrontEndSendRecvType::COLLECTIVE, &Sys::handleEvent, nullptr);
+}
+
+void HalvingDoubling::receive_from(int src, uint64_t size) {
+    sim_request rcv_req;
+    rcv_req.vnet = this->stream->current_queue_id;
+    RecvPacketEventHandlerData* ehd = new RecvPacketEventHandlerData(
+        stream, stream->owner->id, EventType::PacketReceived,
+        stream->current_queue_id, stream->stream_id);
+    stream->owner->front_end_sim_recv(
+        0, Sys::dummy_data, size, UINT8, src, stream->stream_id, &rcv_req,
+        Sys::FrontEndSendRecvType::COLLECTIVE, &Sys::handleEvent, ehd);
+}
+
 void HalvingDoubling::release_packets() {
     for (auto packet : locked_packets) {
         packet->set_notifier(this);
@@ -167,13 +278,8 @@ void HalvingDoubling::process_max_count() {
             rank_offset *= offset_multiplier;
             msg_size /= offset_multiplier;
         }
-        curr_receiver = id;
-        RingTopology::Direction direction = specify_direction();
-        for (int i = 0; i < rank_offset; i++) {
-            curr_receiver = ((RingTopology*)logical_topo)
-                                ->get_receiver(curr_receiver, direction);
-            curr_sender = curr_receiver;
-        }
+        curr_receiver = peer_at(rank_offset, specify_direction());
+        curr_sender = curr_receiver;
     }
 }
 
@@ -272,6 +378,18 @@ bool HalvingDoubling::ready() {
 }
 
 void HalvingDoubling::exit() {
+    if (fold_partner != -1 && stage == Stage::Exchange) {
+        // hand the result back to the folded rank
+        stage = Stage::Unfold;
+        (new PacketBundle(stream->owner, stream, false, false, unfold_size,
+                          transmition))
+            ->send_to_MA();
+        return;
+    }
+    finish();
+}
+
+void HalvingDoubling::finish() {
     if (packets.size() != 0) {
         packets.clear();
     }
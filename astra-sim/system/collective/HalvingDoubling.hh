@@ -17,6 +17,11 @@ namespace AstraSim {
 
 class HalvingDoubling : public Algorithm {
   public:
+    // Fold: ranks beyond the largest power of two hand their data to a
+    // neighbour; Exchange: recursive halving/doubling; Unfold: the neighbour
+    // returns the result.
+    enum class Stage { Fold, Exchange, Unfold };
+
     HalvingDoubling(ComType type,
                     int id,
                     RingTopology* ring_topology,
@@ -32,6 +37,12 @@ class HalvingDoubling : public Algorithm {
     void insert_packet(Callable* sender);
     bool ready();
     void exit();
+    void finish();
+    // NPU `distance` ranks away in the power-of-two exchange
+    int peer_at(int distance, RingTopology::Direction direction);
+    void run_fold(EventType event);
+    void send_to(int dest, uint64_t size);
+    void receive_from(int src, uint64_t size);
 
     RingTopology::Direction dimension;
     MemBus::Transmition transmition;
@@ -61,6 +72,17 @@ class HalvingDoubling : public Algorithm {
 
     int rank_offset;
     double offset_multiplier;
+
+    Stage stage;
+    // ranks left over above the largest power of two
+    int remainder_nodes;
+    // rank in the power-of-two exchange, -1 when folded out
+    int folded_index;
+    // the rank folded onto or from, -1 if none
+    int fold_partner;
+    bool folded_out;
+    uint64_t fold_size;
+    uint64_t unfold_size;
 };
 
 }  // namespace AstraSim
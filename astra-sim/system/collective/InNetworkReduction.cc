@@ -0,0 +1,142 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/system/collective/InNetworkReduction.hh"
+
+#include <cassert>
+
+#include "astra-sim/common/Logging.hh"
+#include "astra-sim/system/PacketBundle.hh"
+#include "astra-sim/system/RecvPacketEventHandlerData.hh"
+
+using namespace AstraSim;
+
+std::map<InNetworkReduction::SwitchKey, InNetworkReduction::Switch>
+    InNetworkReduction::switches;
+
+InNetworkReduction::InNetworkReduction(ComType type,
+                                       int id,
+                                       RingTopology* ring_topology,
+                                       uint64_t data_size,
+                                       double aggregation_bw)
+    : Algorithm() {
+    this->nodes_in_ring = ring_topology->get_nodes_in_ring();
+    switch (type) {
+    case ComType::All_Reduce:
+        this->final_data_size = data_size;
+        break;
+    case ComType::Reduce_Scatter:
+        this->final_data_size = data_size / nodes_in_ring;
+        break;
+    default:
+        LoggerFactory::get_logger("system::collective::InNetworkReduction")
+            ->critical("InNetworkReduction only supports All-Reduce and "
+                       "Reduce-Scatter");
+        std::exit(1);
+    }
+    this->comType = type;
+    this->id = id;
+    this->logical_topo = ring_topology;
+    this->data_size = data_size;
+    this->name = Name::InNetworkReduction;
+    this->state = State::Begin;
+    this->result_size = final_data_size;
+    int index = ring_topology->index_of(id);
+    this->previous =
+        ring_topology->id_at((index + nodes_in_ring - 1) % nodes_in_ring);
+    this->next = ring_topology->id_at((index + 1) % nodes_in_ring);
+    // stream id 在开始执行时才确定
+    this->key = SwitchKey(-1, ring_topology->id_at(0),
+                          ring_topology->id_at(1 % nodes_in_ring));
+    this->aggregation_delay = 0;
+    if (aggregation_bw > 0) {
+        // 交换机需要读入所有 NPU 的数据
+        this->aggregation_delay = static_cast<Tick>(
+            static_cast<double>(data_size) * nodes_in_ring / aggregation_bw);
+    }
+    if (ring_topology->get_dimension() == RingTopology::Dimension::Local) {
+        transmition = MemBus::Transmition::Fast;
+    } else {
+        transmition = MemBus::Transmition::Usual;
+    }
+}
+
+void InNetworkReduction::run(EventType event, CallData* data) {
+    if (state == State::Begin && event == EventType::StreamInit) {
+        if (stream->state == StreamState::Created ||
+            stream->state == StreamState::Ready) {
+            stream->changeState(StreamState::Executing);
+        }
+        if (nodes_in_ring == 1) {
+            exit();
+            return;
+        }
+        std::get<0>(key) = stream->stream_id;
+        switches[key].members.push_back(this);
+        // 上一个 NPU 的数据经它的上行链路和本 NPU 的下行链路到达交换机
+        state = State::SendingUp;
+        receive(previous, data_size);
+        (new PacketBundle(stream->owner, stream, false, false, data_size,
+                          transmition))
+            ->send_to_MA();
+    } else if (state == State::SendingUp && event == EventType::General) {
+        send(next, data_size);
+        state = State::Collecting;
+    } else if ((state == State::SendingUp || state == State::Collecting) &&
+               event == EventType::PacketReceived) {
+        input_arrived();
+    } else if (state == State::ReceivingDown && event == EventType::General) {
+        exit();
+    }
+}
+
+void InNetworkReduction::input_arrived() {
+    auto it = switches.find(key);
+    assert(it != switches.end());
+    Switch& reduction = it->second;
+    if (++reduction.arrived < nodes_in_ring) {
+        return;
+    }
+    // 每个成员的输入都已到达，说明所有成员都已开始；完成时间由最慢的
+    // 输入决定
+    std::vector<InNetworkReduction*> members = std::move(reduction.members);
+    switches.erase(it);
+    for (InNetworkReduction* member : members) {
+        member->state = State::Aggregating;
+        member->stream->owner->register_event(member, EventType::General,
+                                              nullptr, aggregation_delay);
+    }
+}
+
+void InNetworkReduction::call(EventType event, CallData* data) {
+    // 归约结果已随合并的传输下发，写回 NPU 后结束
+    state = State::ReceivingDown;
+    (new PacketBundle(stream->owner, stream, false, false, result_size,
+                      transmition))
+        ->send_to_NPU();
+}
+
+void InNetworkReduction::send(int peer, uint64_t bytes) {
+    sim_request snd_req;
+    snd_req.srcRank = id;
+    snd_req.dstRank = peer;
+    snd_req.tag = stream->stream_id;
+    snd_req.reqType = UINT8;
+    snd_req.vnet = stream->current_queue_id;
+    stream->owner->front_end_sim_send(
+        0, Sys::dummy_data, bytes, UINT8, peer, stream->stream_id, &snd_req,
+        Sys::FrontEndSendRecvType::COLLECTIVE, &Sys::handleEvent, nullptr);
+}
+
+void InNetworkReduction::receive(int peer, uint64_t bytes) {
+    sim_request rcv_req;
+    rcv_req.vnet = stream->current_queue_id;
+    RecvPacketEventHandlerData* ehd = new RecvPacketEventHandlerData(
+        stream, stream->owner->id, EventType::PacketReceived,
+        stream->current_queue_id, stream->stream_id);
+    stream->owner->front_end_sim_recv(
+        0, Sys::dummy_data, bytes, UINT8, peer, stream->stream_id, &rcv_req,
+        Sys::FrontEndSendRecvType::COLLECTIVE, &Sys::handleEvent, ehd);
+}
@@ -0,0 +1,94 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __IN_NETWORK_REDUCTION_HH__
+#define __IN_NETWORK_REDUCTION_HH__
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "astra-sim/system/MemBus.hh"
+#include "astra-sim/system/collective/Algorithm.hh"
+#include "astra-sim/system/topology/RingTopology.hh"
+
+namespace AstraSim {
+
+/**
+ * @class InNetworkReduction
+ * @brief 交换机内归约（类似 SHARP）的 All-Reduce / Reduce-Scatter。
+ *
+ * 每个 NPU 只把自己的数据上送一次，交换机收齐全部 N 份输入并完成
+ * 归约后才下发结果，NPU 侧只接收不转发。系统层没有交换机端点，因此
+ * 每个成员的上送与下发合并为一次发往环上下一个 NPU 的传输：每个 NPU
+ * 的上行与下行链路各承载一份数据，不经过任何其他 NPU 的链路。交换机
+ * 的状态由环上所有成员共享，收齐全部输入后按交换机聚合吞吐计入归约
+ * 延迟，再同时完成所有成员。
+ */
+class InNetworkReduction : public Algorithm {
+  public:
+    enum class State {
+        Begin,
+        SendingUp,
+        Collecting,
+        Aggregating,
+        ReceivingDown
+    };
+
+    // 同一集合通信在交换机上的状态：(stream id, 环上前两个 NPU) 标识
+    // 一个环上的一次归约，与集合通信消息按 stream id 匹配的前提相同
+    using SwitchKey = std::tuple<int, int, int>;
+    struct Switch {
+        // 已到达交换机的输入数
+        int arrived = 0;
+        // 已开始的成员，收齐输入后由最后一份输入的接收方统一唤醒
+        std::vector<InNetworkReduction*> members;
+    };
+
+    /**
+     * @brief 构造函数
+     * @param type 通信类型（All-Reduce 或 Reduce-Scatter）
+     * @param id 当前节点 ID
+     * @param ring_topology 参与归约的 NPU 所在的环
+     * @param data_size 每个 NPU 的数据大小（字节）
+     * @param aggregation_bw 交换机聚合吞吐（GB/s，即 bytes/ns），0 表示不限
+     */
+    InNetworkReduction(ComType type,
+                       int id,
+                       RingTopology* ring_topology,
+                       uint64_t data_size,
+                       double aggregation_bw);
+
+    void run(EventType event, CallData* data) override;
+
+    /**
+     * @brief 交换机归约完成，结果写回 NPU
+     */
+    void call(EventType event, CallData* data) override;
+
+  private:
+    void send(int peer, uint64_t bytes);
+    void receive(int peer, uint64_t bytes);
+    // 一份输入到达交换机，收齐时开始归约
+    void input_arrived();
+
+    static std::map<SwitchKey, Switch> switches;
+
+    State state;
+    SwitchKey key;
+    int nodes_in_ring;
+    // 环上的前一个与后一个 NPU
+    int previous;
+    int next;
+    MemBus::Transmition transmition;
+    // 写回每个 NPU 的结果大小
+    uint64_t result_size;
+    // 交换机归约全部输入所需的时间（ns）
+    Tick aggregation_delay;
+};
+
+}  // namespace AstraSim
+
+#endif /* __IN_NETWORK_REDUCTION_HH__ */
@@ -0,0 +1,28 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/system/collective/PairwiseExchange.hh"
+
+#include <algorithm>
+
+using namespace AstraSim;
+
+PairwiseExchange::PairwiseExchange(ComType type,
+                                   int id,
+                                   RingTopology* ring_topology,
+                                   uint64_t data_size)
+    : ScheduledAllToAll(type, id, ring_topology, data_size) {
+    this->name = Name::PairwiseExchange;
+    uint64_t block_size = std::max<uint64_t>(1, data_size / nodes_in_ring);
+    bool power_of_two = (nodes_in_ring & (nodes_in_ring - 1)) == 0;
+    for (int step = 1; step < nodes_in_ring; step++) {
+        if (power_of_two) {
+            int peer = node_at((index_in_ring ^ step) - index_in_ring);
+            steps.push_back({{peer, peer, block_size}});
+        } else {
+            steps.push_back({{node_at(step), node_at(-step), block_size}});
+        }
+    }
+}
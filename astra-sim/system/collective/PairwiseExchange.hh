@@ -0,0 +1,30 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __PAIRWISE_EXCHANGE_HH__
+#define __PAIRWISE_EXCHANGE_HH__
+
+#include "astra-sim/system/collective/ScheduledAllToAll.hh"
+
+namespace AstraSim {
+
+/**
+ * @brief 成对交换 All-to-All：N-1 步，每步与一个节点交换一个数据块
+ *
+ * 节点数为 2 的幂时第 k 步与 id XOR k 的节点两两交换，否则向偏移 +k
+ * 的节点发送、从偏移 -k 的节点接收。每个节点每步只收发一条消息，
+ * 避免 Direct 实现中 N-1 条消息同时到达同一节点的拥塞。
+ */
+class PairwiseExchange : public ScheduledAllToAll {
+  public:
+    PairwiseExchange(ComType type,
+                     int id,
+                     RingTopology* ring_topology,
+                     uint64_t data_size);
+};
+
+}  // namespace AstraSim
+
+#endif /* __PAIRWISE_EXCHANGE_HH__ */
@@ -0,0 +1,139 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/system/collective/PipelinedRing.hh"
+
+#include <algorithm>
+
+#include "astra-sim/common/Logging.hh"
+#include "astra-sim/system/PacketBundle.hh"
+#include "astra-sim/system/RecvPacketEventHandlerData.hh"
+
+using namespace AstraSim;
+
+PipelinedRing::PipelinedRing(ComType type,
+                             int id,
+                             RingTopology* ring_topology,
+                             uint64_t data_size,
+                             RingTopology::Direction direction,
+                             uint64_t slice_size)
+    : Algorithm() {
+    this->comType = type;
+    this->id = id;
+    this->logical_topo = ring_topology;
+    this->data_size = data_size;
+    this->name = Name::PipelinedRing;
+    this->next_node = ring_topology->get_receiver(id, direction);
+    this->previous_node = ring_topology->get_sender(id, direction);
+    if (ring_topology->get_dimension() == RingTopology::Dimension::Local) {
+        transmition = MemBus::Transmition::Fast;
+    } else {
+        transmition = MemBus::Transmition::Usual;
+    }
+    int nodes_in_ring = ring_topology->get_nodes_in_ring();
+    // 每一步在环上传递的数据块大小
+    uint64_t block_size;
+    switch (type) {
+    case ComType::All_Reduce:
+        this->final_data_size = data_size;
+        block_size = data_size / nodes_in_ring;
+        steps = 2 * (nodes_in_ring - 1);
+        reduce_steps = nodes_in_ring - 1;
+        break;
+    case ComType::Reduce_Scatter:
+        this->final_data_size = data_size / nodes_in_ring;
+        block_size = data_size / nodes_in_ring;
+        steps = nodes_in_ring - 1;
+        reduce_steps = steps;
+        break;
+    case ComType::All_Gather:
+        this->final_data_size = data_size * nodes_in_ring;
+        block_size = data_size;
+        steps = nodes_in_ring - 1;
+        reduce_steps = 0;
+        break;
+    default:
+        LoggerFactory::get_logger("system::collective::PipelinedRing")
+            ->critical("PipelinedRing only supports All-Reduce, "
+                       "Reduce-Scatter and All-Gather");
+        std::exit(1);
+    }
+    block_size = std::max<uint64_t>(block_size, 1);
+    slice_size = std::max<uint64_t>(slice_size, 1);
+    slices_per_step = (block_size + slice_size - 1) / slice_size;
+    slice_bytes = (block_size + slices_per_step - 1) / slices_per_step;
+    staged = false;
+    received_slices = 0;
+    processed_slices = 0;
+}
+
+void PipelinedRing::run(EventType event, CallData* data) {
+    int total_slices = steps * slices_per_step;
+    if (event == EventType::StreamInit) {
+        if (stream->state == StreamState::Created ||
+            stream->state == StreamState::Ready) {
+            stream->changeState(StreamState::Executing);
+        }
+        if (total_slices == 0) {
+            exit();
+            return;
+        }
+        // 与 Ring 相同，第一步的数据块先经 NPU->MA 内存总线传输再发出
+        (new PacketBundle(stream->owner, stream, false, false,
+                          slice_bytes * slices_per_step, transmition))
+            ->send_to_MA();
+    } else if (!staged) {
+        // 第一步的数据块已到达 MA，全部分片直接发出
+        staged = true;
+        for (int i = 0; i < slices_per_step; i++) {
+            send_slice();
+        }
+        receive_slice();
+    } else if (event == EventType::PacketReceived) {
+        int step = received_slices / slices_per_step;
+        received_slices++;
+        if (received_slices < total_slices) {
+            receive_slice();
+        }
+        (new PacketBundle(stream->owner, stream, step < reduce_steps, false,
+                          slice_bytes, transmition))
+            ->send_to_NPU();
+    } else if (event == EventType::General) {
+        // 分片按接收顺序处理完毕，转发到下一步
+        int step = processed_slices / slices_per_step;
+        processed_slices++;
+        if (step + 1 < steps) {
+            send_slice();
+        }
+        if (processed_slices == total_slices) {
+            exit();
+        }
+    }
+}
+
+void PipelinedRing::send_slice() {
+    sim_request snd_req;
+    snd_req.srcRank = id;
+    snd_req.dstRank = next_node;
+    snd_req.tag = stream->stream_id;
+    snd_req.reqType = UINT8;
+    snd_req.vnet = stream->current_queue_id;
+    stream->owner->front_end_sim_send(
+        0, Sys::dummy_data, slice_bytes, UINT8, next_node, stream->stream_id,
+        &snd_req, Sys::FrontEndSendRecvType::COLLECTIVE, &Sys::handleEvent,
+        nullptr);
+}
+
+void PipelinedRing::receive_slice() {
+    sim_request rcv_req;
+    rcv_req.vnet = stream->current_queue_id;
+    RecvPacketEventHandlerData* ehd = new RecvPacketEventHandlerData(
+        stream, stream->owner->id, EventType::PacketReceived,
+        stream->current_queue_id, stream->stream_id);
+    stream->owner->front_end_sim_recv(
+        0, Sys::dummy_data, slice_bytes, UINT8, previous_node,
+        stream->stream_id, &rcv_req, Sys::FrontEndSendRecvType::COLLECTIVE,
+        &Sys::handleEvent, ehd);
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __PIPELINED_RING_HH__
+#define __PIPELINED_RING_HH__
+
+#include "astra-sim/system/MemBus.hh"
+#include "astra-sim/system/collective/Algorithm.hh"
+#include "astra-sim/system/topology/RingTopology.hh"
+
+namespace AstraSim {
+
+/**
+ * @class PipelinedRing
+ * @brief 阶段内按分片流水的环形集合通信（类似 NCCL 的 Ring 实现）。
+ *
+ * 每一步的数据块被切成大小为 slice_size 的分片，某个分片在上一步中
+ * 收到并处理完后即可转发，无需等待整个数据块，从而在单个阶段内
+ * 重叠带宽与时延，而不必通过 preferred-dataset-splits 创建大量数据流。
+ */
+class PipelinedRing : public Algorithm {
+  public:
+    /**
+     * @brief 构造函数
+     * @param type 通信类型（All-Reduce、Reduce-Scatter 或 All-Gather）
+     * @param id 当前节点 ID
+     * @param ring_topology 环形拓扑
+     * @param data_size 每个节点的数据大小（字节）
+     * @param direction 通信方向
+     * @param slice_size 分片大小（字节）
+     */
+    PipelinedRing(ComType type,
+                  int id,
+                  RingTopology* ring_topology,
+                  uint64_t data_size,
+                  RingTopology::Direction direction,
+                  uint64_t slice_size);
+
+    void run(EventType event, CallData* data) override;
+
+  private:
+    /**
+     * @brief 向下游节点发送一个分片
+     */
+    void send_slice();
+
+    /**
+     * @brief 从上游节点接收下一个分片
+     */
+    void receive_slice();
+
+    int next_node;
+    int previous_node;
+    MemBus::Transmition transmition;
+    // 每个分片的字节数、每步的分片数
+    uint64_t slice_bytes;
+    int slices_per_step;
+    // 总步数，前 reduce_steps 步收到的数据需要归约
+    int steps;
+    int reduce_steps;
+    // 第一步的数据块是否已完成 NPU->MA 传输
+    bool staged;
+    // 已接收与已处理的分片数
+    int received_slices;
+    int processed_slices;
+};
+
+}  // namespace AstraSim
+
+#endif /* __PIPELINED_RING_HH__ */
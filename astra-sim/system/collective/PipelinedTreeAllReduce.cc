@@ -0,0 +1,143 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/system/collective/PipelinedTreeAllReduce.hh"
+
+#include <algorithm>
+
+#include "astra-sim/system/PacketBundle.hh"
+#include "astra-sim/system/RecvPacketEventHandlerData.hh"
+
+using namespace AstraSim;
+
+PipelinedTreeAllReduce::PipelinedTreeAllReduce(int id,
+                                               BinaryTree* tree,
+                                               uint64_t data_size,
+                                               uint64_t slice_size)
+    : Algorithm() {
+    this->id = id;
+    this->logical_topo = tree;
+    this->data_size = data_size;
+    this->final_data_size = data_size;
+    this->comType = ComType::All_Reduce;
+    this->name = Name::PipelinedTree;
+    // 根节点没有父节点，叶子节点没有子节点
+    this->parent = tree->get_node_type(id) == BinaryTree::Type::Root
+                       ? -1
+                       : tree->get_parent_id(id);
+    for (int child :
+         {tree->get_left_child_id(id), tree->get_right_child_id(id)}) {
+        if (child >= 0) {
+            children.push_back(child);
+            received_from_child[child] = 0;
+        }
+    }
+    data_size = std::max<uint64_t>(data_size, 1);
+    slice_size = std::max<uint64_t>(slice_size, 1);
+    this->slices = (data_size + slice_size - 1) / slice_size;
+    this->slice_bytes = (data_size + slices - 1) / slices;
+    this->reductions_issued = 0;
+    this->reduced_slices = 0;
+    this->broadcast_slices = 0;
+}
+
+void PipelinedTreeAllReduce::run(EventType event, CallData* data) {
+    if (event == EventType::StreamInit) {
+        if (stream->state == StreamState::Created ||
+            stream->state == StreamState::Ready) {
+            stream->changeState(StreamState::Executing);
+        }
+        if (children.empty() && parent < 0) {
+            exit();
+            return;
+        }
+        if (children.empty()) {
+            // 叶子节点：全部分片直接上送
+            for (int i = 0; i < slices; i++) {
+                send_slice(parent);
+            }
+        } else {
+            for (int child : children) {
+                receive_slice(child);
+            }
+        }
+        if (parent >= 0) {
+            receive_slice(parent);
+        }
+    } else if (event == EventType::PacketReceived) {
+        auto it = pending_receives.find((RecvPacketEventHandlerData*)data);
+        int src = it->second;
+        pending_receives.erase(it);
+        if (src == parent) {
+            // 向下广播：收到即转发
+            broadcast_slices++;
+            for (int child : children) {
+                send_slice(child);
+            }
+            if (broadcast_slices < slices) {
+                receive_slice(parent);
+            } else {
+                exit();
+            }
+            return;
+        }
+        if (++received_from_child[src] < slices) {
+            receive_slice(src);
+        }
+        reduce_ready_slices();
+    } else if (event == EventType::General) {
+        // 一个分片归约完成
+        reduced_slices++;
+        if (parent >= 0) {
+            send_slice(parent);
+            return;
+        }
+        for (int child : children) {
+            send_slice(child);
+        }
+        if (reduced_slices == slices) {
+            exit();
+        }
+    }
+}
+
+void PipelinedTreeAllReduce::reduce_ready_slices() {
+    int ready = slices;
+    for (int child : children) {
+        ready = std::min(ready, received_from_child[child]);
+    }
+    for (; reductions_issued < ready; reductions_issued++) {
+        (new PacketBundle(stream->owner, stream, true, false,
+                          slice_bytes * children.size(),
+                          MemBus::Transmition::Usual))
+            ->send_to_NPU();
+    }
+}
+
+void PipelinedTreeAllReduce::send_slice(int dest) {
+    sim_request snd_req;
+    snd_req.srcRank = stream->owner->id;
+    snd_req.dstRank = dest;
+    snd_req.tag = stream->stream_id;
+    snd_req.reqType = UINT8;
+    snd_req.vnet = stream->current_queue_id;
+    stream->owner->front_end_sim_send(
+        0, Sys::dummy_data, slice_bytes, UINT8, dest, stream->stream_id,
+        &snd_req, Sys::FrontEndSendRecvType::COLLECTIVE, &Sys::handleEvent,
+        nullptr);
+}
+
+void PipelinedTreeAllReduce::receive_slice(int src) {
+    sim_request rcv_req;
+    rcv_req.vnet = stream->current_queue_id;
+    RecvPacketEventHandlerData* ehd = new RecvPacketEventHandlerData(
+        stream, stream->owner->id, EventType::PacketReceived,
+        stream->current_queue_id, stream->stream_id);
+    pending_receives[ehd] = src;
+    stream->owner->front_end_sim_recv(
+        0, Sys::dummy_data, slice_bytes, UINT8, src, stream->stream_id,
+        &rcv_req, Sys::FrontEndSendRecvType::COLLECTIVE, &Sys::handleEvent,
+        ehd);
+}
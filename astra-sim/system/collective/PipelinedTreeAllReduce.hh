@@ -0,0 +1,67 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __PIPELINED_TREE_ALL_REDUCE_HH__
+#define __PIPELINED_TREE_ALL_REDUCE_HH__
+
+#include <unordered_map>
+#include <vector>
+
+#include "astra-sim/system/collective/Algorithm.hh"
+#include "astra-sim/system/topology/BinaryTree.hh"
+
+namespace AstraSim {
+
+class RecvPacketEventHandlerData;
+
+/**
+ * @class PipelinedTreeAllReduce
+ * @brief 阶段内按分片流水的二叉树 All-Reduce（类似 NCCL 的 Tree 实现）。
+ *
+ * 与 DoubleBinaryTreeAllReduce 相同的树，但数据被切成大小为 slice_size
+ * 的分片：某个分片收齐所有子节点的数据并归约后立即发往父节点，
+ * 根节点归约完一个分片即开始向下广播，中间节点收到后立即转发给子节点。
+ */
+class PipelinedTreeAllReduce : public Algorithm {
+  public:
+    /**
+     * @brief 构造函数
+     * @param id 当前节点 ID
+     * @param tree 二叉树拓扑
+     * @param data_size 数据大小（字节）
+     * @param slice_size 分片大小（字节）
+     */
+    PipelinedTreeAllReduce(int id,
+                           BinaryTree* tree,
+                           uint64_t data_size,
+                           uint64_t slice_size);
+
+    void run(EventType event, CallData* data) override;
+
+  private:
+    void send_slice(int dest);
+    void receive_slice(int src);
+    /**
+     * @brief 所有子节点都送达的分片开始归约
+     */
+    void reduce_ready_slices();
+
+    int parent;
+    std::vector<int> children;
+    uint64_t slice_bytes;
+    int slices;
+    // 每个子节点已送达的分片数
+    std::unordered_map<int, int> received_from_child;
+    // 已开始归约、已归约完成、已从父节点收到的分片数
+    int reductions_issued;
+    int reduced_slices;
+    int broadcast_slices;
+    // 尚未送达的接收请求及其来源节点
+    std::unordered_map<RecvPacketEventHandlerData*, int> pending_receives;
+};
+
+}  // namespace AstraSim
+
+#endif /* __PIPELINED_TREE_ALL_REDUCE_HH__ */
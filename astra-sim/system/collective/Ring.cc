@@ -295,53 +295,75 @@ void Ring::insert_packet(Callable* sender) {
  * @return 如果流可执行返回 true，否则返回 false
  */
 bool Ring::ready() {
+    return issue_packets(1) > 0;
+}
+
+/**
+ * @brief 发出至多 max_packets 个数据包，并批量提交其发送和接收请求
+ * @param max_packets 本次最多发出的数据包数
+ * @return 实际发出的数据包数
+ */
+int Ring::issue_packets(int max_packets) {
     // 如果流处于 `Created` 或 `Ready` 状态，则将其状态更改为 `Executing`
     if (stream->state == StreamState::Created ||
         stream->state == StreamState::Ready) {
         stream->changeState(StreamState::Executing);
     }
 
-    // 如果数据包队列为空，或者没有剩余流，或者没有空闲数据包，则返回 false
-    if (packets.size() == 0 || stream_count == 0 || free_packets == 0) {
-        return false;
+    send_batch.clear();
+    recv_batch.clear();
+    int issued = 0;
+
+    // 数据包队列为空、没有剩余流或没有空闲数据包时停止
+    while (issued < max_packets && packets.size() != 0 && stream_count != 0 &&
+           free_packets != 0) {
+        // 获取队列中的第一个数据包
+        MyPacket packet = packets.front();
+
+        // 发送数据包请求
+        sim_message snd{};
+        snd.buffer = Sys::dummy_data;
+        snd.count = msg_size;
+        snd.type = UINT8;
+        snd.peer = packet.preferred_dest;
+        snd.tag = stream->stream_id;
+        snd.request.srcRank = id;  // 发送方 ID
+        snd.request.dstRank = packet.preferred_dest;  // 目标 ID
+        snd.request.tag = stream->stream_id;  // 关联流 ID
+        snd.request.reqType = UINT8;  // 数据类型
+        snd.request.vnet = this->stream->current_queue_id;  // 虚拟网络 ID
+        snd.msg_handler = &Sys::handleEvent;
+        snd.fun_arg = nullptr;
+        send_batch.push_back(snd);
+
+        // 处理接收数据包请求，创建事件处理数据结构
+        sim_message rcv{};
+        rcv.buffer = Sys::dummy_data;
+        rcv.count = msg_size;
+        rcv.type = UINT8;
+        rcv.peer = packet.preferred_src;
+        rcv.tag = stream->stream_id;
+        rcv.request.vnet = this->stream->current_queue_id;
+        rcv.msg_handler = &Sys::handleEvent;
+        rcv.fun_arg = new RecvPacketEventHandlerData(
+            stream, stream->owner->id, EventType::PacketReceived,
+            packet.preferred_vnet, packet.stream_id);
+        recv_batch.push_back(rcv);
+
+        // 执行 Reduce 操作
+        reduce();
+        issued++;
     }
 
-    // 获取队列中的第一个数据包
-    MyPacket packet = packets.front();
-
-    // 发送数据包请求
-    sim_request snd_req;
-    snd_req.srcRank = id;  // 发送方 ID
-    snd_req.dstRank = packet.preferred_dest;  // 目标 ID
-    snd_req.tag = stream->stream_id;  // 关联流 ID
-    snd_req.reqType = UINT8;  // 数据类型
-    snd_req.vnet = this->stream->current_queue_id;  // 虚拟网络 ID
-
-    // 通过仿真前端 API 发送数据包
-    stream->owner->front_end_sim_send(
-        0, Sys::dummy_data, msg_size, UINT8, packet.preferred_dest,
-        stream->stream_id, &snd_req, Sys::FrontEndSendRecvType::COLLECTIVE,
-        &Sys::handleEvent, nullptr); // stream_id+(packet.preferred_dest*50)
-
-    // 处理接收数据包请求
-    sim_request rcv_req;
-    rcv_req.vnet = this->stream->current_queue_id;
-
-    // 创建事件处理数据结构
-    RecvPacketEventHandlerData* ehd = new RecvPacketEventHandlerData(
-        stream, stream->owner->id, EventType::PacketReceived,
-        packet.preferred_vnet, packet.stream_id);
-
-    // 通过仿真前端 API 接收数据包
-    stream->owner->front_end_sim_recv(
-        0, Sys::dummy_data, msg_size, UINT8, packet.preferred_src,
-        stream->stream_id, &rcv_req, Sys::FrontEndSendRecvType::COLLECTIVE,
-        &Sys::handleEvent, ehd); // stream_id+(owner->id*50)
-
-    // 执行 Reduce 操作
-    reduce();
+    if (issued > 0) {
+        // 通过仿真前端 API 批量发送和接收数据包
+        stream->owner->front_end_sim_send_batch(
+            send_batch, Sys::FrontEndSendRecvType::COLLECTIVE);
+        stream->owner->front_end_sim_recv_batch(
+            recv_batch, Sys::FrontEndSendRecvType::COLLECTIVE);
+    }
 
-    return true;
+    return issued;
 }
 
 /**
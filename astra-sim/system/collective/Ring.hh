@@ -6,6 +6,8 @@ LICENSE file in the root directory of this source tree.
 #ifndef __RING_HH__
 #define __RING_HH__
 
+#include <vector>
+
 #include "astra-sim/system/MemBus.hh"
 #include "astra-sim/system/MyPacket.hh"
 #include "astra-sim/system/collective/Algorithm.hh"
@@ -86,6 +88,15 @@ class Ring : public Algorithm {
      */
     bool ready();
 
+    /**
+     * @brief 在当前时刻发出至多 max_packets 个可发送的数据包。
+     *
+     * 这些数据包的发送和接收分别通过一次批量调用交给网络后端。
+     * @param max_packets 本次最多发出的数据包数。
+     * @return 实际发出的数据包数。
+     */
+    int issue_packets(int max_packets);
+
     /**
      * @brief 退出 Ring 算法。
      */
@@ -165,6 +176,10 @@ class Ring : public Algorithm {
 
     // 是否进行 NPU 到 MA 的传输
     bool NPU_to_MA;
+
+    // issue_packets() 复用的发送/接收批次，避免每次调用重新分配
+    std::vector<sim_message> send_batch;
+    std::vector<sim_message> recv_batch;
 };
 
 }  // namespace AstraSim
@@ -0,0 +1,131 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/system/collective/ScheduledAllToAll.hh"
+
+#include "astra-sim/common/Logging.hh"
+#include "astra-sim/system/PacketBundle.hh"
+#include "astra-sim/system/RecvPacketEventHandlerData.hh"
+
+using namespace AstraSim;
+
+ScheduledAllToAll::ScheduledAllToAll(ComType type,
+                                     int id,
+                                     RingTopology* ring_topology,
+                                     uint64_t data_size)
+    : Algorithm() {
+    if (type != ComType::All_to_All) {
+        LoggerFactory::get_logger("system::collective::ScheduledAllToAll")
+            ->critical("Bruck and PairwiseExchange only implement All-to-All");
+        std::exit(1);
+    }
+    this->comType = type;
+    this->id = id;
+    this->logical_topo = ring_topology;
+    this->data_size = data_size;
+    this->final_data_size = data_size;
+    this->nodes_in_ring = ring_topology->get_nodes_in_ring();
+    this->index_in_ring = ring_topology->index_of(id);
+    this->local_copy_bytes = 0;
+    this->current_step = 0;
+    this->pending_recvs = 0;
+    this->sends_issued = false;
+    if (ring_topology->get_dimension() == RingTopology::Dimension::Local) {
+        transmition = MemBus::Transmition::Fast;
+    } else {
+        transmition = MemBus::Transmition::Usual;
+    }
+}
+
+int ScheduledAllToAll::node_at(int offset) const {
+    int index = (index_in_ring + offset) % nodes_in_ring;
+    if (index < 0) {
+        index += nodes_in_ring;
+    }
+    return ((RingTopology*)logical_topo)->id_at(index);
+}
+
+void ScheduledAllToAll::run(EventType event, CallData* data) {
+    if (event == EventType::StreamInit) {
+        if (stream->state == StreamState::Created ||
+            stream->state == StreamState::Ready) {
+            stream->changeState(StreamState::Executing);
+        }
+        if (steps.empty()) {
+            exit();
+            return;
+        }
+        start_step();
+    } else if (event == EventType::General) {
+        // 数据已送到 MA
+        issue_sends();
+    } else if (event == EventType::PacketReceived) {
+        pending_recvs--;
+        if (pending_recvs == 0 && sends_issued) {
+            finish_step();
+        }
+    }
+}
+
+void ScheduledAllToAll::call(EventType event, CallData* data) {
+    exit();
+}
+
+void ScheduledAllToAll::start_step() {
+    const std::vector<Exchange>& step = steps[current_step];
+    pending_recvs = step.size();
+    sends_issued = false;
+    uint64_t step_bytes = 0;
+    for (const Exchange& exchange : step) {
+        sim_request rcv_req;
+        rcv_req.vnet = stream->current_queue_id;
+        RecvPacketEventHandlerData* ehd = new RecvPacketEventHandlerData(
+            stream, stream->owner->id, EventType::PacketReceived,
+            stream->current_queue_id, stream->stream_id);
+        stream->owner->front_end_sim_recv(
+            0, Sys::dummy_data, exchange.bytes, UINT8, exchange.recv_from,
+            stream->stream_id, &rcv_req, Sys::FrontEndSendRecvType::COLLECTIVE,
+            &Sys::handleEvent, ehd);
+        step_bytes += exchange.bytes;
+    }
+    (new PacketBundle(stream->owner, stream, false, false, step_bytes,
+                      transmition))
+        ->send_to_MA();
+}
+
+void ScheduledAllToAll::issue_sends() {
+    for (const Exchange& exchange : steps[current_step]) {
+        sim_request snd_req;
+        snd_req.srcRank = id;
+        snd_req.dstRank = exchange.send_to;
+        snd_req.tag = stream->stream_id;
+        snd_req.reqType = UINT8;
+        snd_req.vnet = stream->current_queue_id;
+        stream->owner->front_end_sim_send(
+            0, Sys::dummy_data, exchange.bytes, UINT8, exchange.send_to,
+            stream->stream_id, &snd_req, Sys::FrontEndSendRecvType::COLLECTIVE,
+            &Sys::handleEvent, nullptr);
+    }
+    sends_issued = true;
+    if (pending_recvs == 0) {
+        finish_step();
+    }
+}
+
+void ScheduledAllToAll::finish_step() {
+    current_step++;
+    if (current_step < static_cast<int>(steps.size())) {
+        start_step();
+        return;
+    }
+    if (local_copy_bytes == 0 || stream->owner->local_mem_bw <= 0) {
+        exit();
+        return;
+    }
+    // 读一遍、写一遍，local_mem_bw 单位为 bytes/s
+    Tick delay = static_cast<Tick>(2 * static_cast<double>(local_copy_bytes) /
+                                   stream->owner->local_mem_bw * 1e9);
+    stream->owner->register_event(this, EventType::General, nullptr, delay);
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __SCHEDULED_ALL_TO_ALL_HH__
+#define __SCHEDULED_ALL_TO_ALL_HH__
+
+#include <vector>
+
+#include "astra-sim/system/MemBus.hh"
+#include "astra-sim/system/collective/Algorithm.hh"
+#include "astra-sim/system/topology/RingTopology.hh"
+
+namespace AstraSim {
+
+/**
+ * @brief 按固定步骤执行的 All-to-All 算法基类（Bruck、PairwiseExchange）
+ *
+ * 每一步先经内存总线把待发数据送到 MA，再发出该步的全部消息，
+ * 收齐该步的全部消息后进入下一步。子类在构造函数中填充 steps。
+ */
+class ScheduledAllToAll : public Algorithm {
+  public:
+    /**
+     * @brief 一步中的一次交换：向 send_to 发送、从 recv_from 接收 bytes 字节
+     */
+    struct Exchange {
+        int send_to;
+        int recv_from;
+        uint64_t bytes;
+    };
+
+    /**
+     * @brief 构造函数
+     * @param type 通信类型，仅支持 All_to_All
+     * @param id 当前节点 ID
+     * @param ring_topology 参与节点所在的环（用于确定节点顺序）
+     * @param data_size 每个节点的数据大小（字节）
+     */
+    ScheduledAllToAll(ComType type,
+                      int id,
+                      RingTopology* ring_topology,
+                      uint64_t data_size);
+
+    void run(EventType event, CallData* data) override;
+
+    /**
+     * @brief 本地数据重排结束
+     */
+    void call(EventType event, CallData* data) override;
+
+  protected:
+    /**
+     * @brief 环上相对当前节点偏移 offset 的节点
+     */
+    int node_at(int offset) const;
+
+    // 每一步的交换
+    std::vector<std::vector<Exchange>> steps;
+    // 全部步骤结束后本地重排（读+写）的数据量，0 表示无需重排
+    uint64_t local_copy_bytes;
+    int nodes_in_ring;
+    int index_in_ring;
+    MemBus::Transmition transmition;
+
+  private:
+    void start_step();
+    void issue_sends();
+    void finish_step();
+
+    int current_step;
+    int pending_recvs;
+    bool sends_issued;
+};
+
+}  // namespace AstraSim
+
+#endif /* __SCHEDULED_ALL_TO_ALL_HH__ */
@@ -0,0 +1,386 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/system/scheduling/CollectiveTuner.hh"
+#include "astra-sim/common/Logging.hh"
+#include "astra-sim/system/Sys.hh"
+#include "astra-sim/system/topology/DoubleBinaryTreeTopology.hh"
+#include "astra-sim/system/topology/RingTopology.hh"
+
+#include <cmath>
+#include <fstream>
+#include <json/json.hpp>
+#include <limits>
+
+using namespace std;
+using namespace AstraSim;
+using json = nlohmann::json;
+
+namespace {
+
+// Message sizes are swept over powers of two up to this size; thresholds in
+// between are found by bisection.
+constexpr int max_size_exponent = 40;
+
+const vector<pair<ComType, string>> collective_names = {
+    {ComType::All_Reduce, "all-reduce"},
+    {ComType::Reduce_Scatter, "reduce-scatter"},
+    {ComType::All_Gather, "all-gather"},
+    {ComType::All_to_All, "all-to-all"}};
+
+const vector<pair<CollectiveImplType, string>> implementation_names = {
+    {CollectiveImplType::Ring, "ring"},
+    {CollectiveImplType::HalvingDoubling, "halvingDoubling"},
+    {CollectiveImplType::DoubleBinaryTree, "doubleBinaryTree"},
+    {CollectiveImplType::Direct, "direct"},
+    {CollectiveImplType::Bruck, "bruck"},
+    {CollectiveImplType::PairwiseExchange, "pairwiseExchange"}};
+
+template <typename T>
+const string& name_of(const vector<pair<T, string>>& names, T value) {
+    for (const auto& name : names) {
+        if (name.first == value) {
+            return name.second;
+        }
+    }
+    Sys::sys_panic("collective tuner: value without a name");
+    return names.front().second;
+}
+
+template <typename T>
+T value_of(const vector<pair<T, string>>& names, const string& name) {
+    for (const auto& entry : names) {
+        if (entry.second == name) {
+            return entry.first;
+        }
+    }
+    Sys::sys_panic("collective tuner table: unknown name " + name);
+    return names.front().first;
+}
+
+bool is_power_of_two(int npus) {
+    return npus > 0 && (npus & (npus - 1)) == 0;
+}
+
+}  // namespace
+
+CollectiveTuner::CollectiveTuner(Sys* sys, string table_path)
+    : sys(sys),
+      table_path(std::move(table_path)),
+      ring_impl(CollectiveImplType::Ring),
+      halving_doubling_impl(CollectiveImplType::HalvingDoubling),
+      double_binary_tree_impl(CollectiveImplType::DoubleBinaryTree),
+      direct_impl(CollectiveImplType::Direct, -1),
+      bruck_impl(CollectiveImplType::Bruck),
+      pairwise_exchange_impl(CollectiveImplType::PairwiseExchange) {
+    if (!this->table_path.empty() && ifstream(this->table_path).good()) {
+        load_table();
+        return;
+    }
+
+    // calibration pass: tabulate every dimension configured as "auto"
+    const vector<pair<ComType, const vector<CollectiveImpl*>*>>
+        implementations = {
+            {ComType::All_Reduce,
+             &sys->all_reduce_implementation_per_dimension},
+            {ComType::Reduce_Scatter,
+             &sys->reduce_scatter_implementation_per_dimension},
+            {ComType::All_Gather,
+             &sys->all_gather_implementation_per_dimension},
+            {ComType::All_to_All,
+             &sys->all_to_all_implementation_per_dimension}};
+    for (const auto& collective : implementations) {
+        const vector<CollectiveImpl*>& per_dimension = *collective.second;
+        for (uint64_t dim = 0; dim < per_dimension.size() &&
+                               dim < sys->physical_dims.size();
+             dim++) {
+            if (per_dimension[dim]->type == CollectiveImplType::Auto &&
+                sys->physical_dims[dim] > 1) {
+                get_thresholds(collective.first, dim, sys->physical_dims[dim]);
+            }
+        }
+    }
+    if (!this->table_path.empty() && sys->id == 0) {
+        write_table();
+    }
+}
+
+CollectiveTuner::~CollectiveTuner() {
+    for (auto& tree : trees) {
+        delete tree.second;
+    }
+}
+
+CollectiveTuner::Choice CollectiveTuner::select(ComType collective_type,
+                                                int dimension,
+                                                RingTopology* ring,
+                                                uint64_t data_size) {
+    int npus = ring->get_nodes_in_ring();
+    CollectiveImplType implementation = CollectiveImplType::Ring;
+    for (const Threshold& threshold :
+         get_thresholds(collective_type, dimension, npus)) {
+        if (data_size < threshold.min_bytes) {
+            break;
+        }
+        implementation = threshold.implementation;
+    }
+
+    // a loaded table may name an algorithm this phase cannot run
+    if (implementation == CollectiveImplType::DoubleBinaryTree &&
+        (collective_type != ComType::All_Reduce || ring->get_stride() < 0)) {
+        implementation = CollectiveImplType::Ring;
+    }
+    if (implementation == CollectiveImplType::DoubleBinaryTree &&
+        !is_power_of_two(npus)) {
+        implementation = CollectiveImplType::Ring;
+    }
+    if ((implementation == CollectiveImplType::Bruck ||
+         implementation == CollectiveImplType::PairwiseExchange) &&
+        collective_type != ComType::All_to_All) {
+        implementation = CollectiveImplType::Ring;
+    }
+
+    switch (implementation) {
+    case CollectiveImplType::HalvingDoubling:
+        return {&halving_doubling_impl, ring};
+    case CollectiveImplType::DoubleBinaryTree:
+        return {&double_binary_tree_impl,
+                tree_topology(ring, collective_type)};
+    case CollectiveImplType::Direct:
+        return {&direct_impl, ring};
+    case CollectiveImplType::Bruck:
+        return {&bruck_impl, ring};
+    case CollectiveImplType::PairwiseExchange:
+        return {&pairwise_exchange_impl, ring};
+    default:
+        return {&ring_impl, ring};
+    }
+}
+
+const vector<CollectiveTuner::Threshold>& CollectiveTuner::get_thresholds(
+    ComType collective_type, int dimension, int npus) {
+    Key key(collective_type, dimension, npus);
+    auto it = table.find(key);
+    if (it == table.end()) {
+        it = table.emplace(key, calibrate(collective_type, dimension, npus))
+                 .first;
+    }
+    return it->second;
+}
+
+vector<CollectiveTuner::Threshold> CollectiveTuner::calibrate(
+    ComType collective_type, int dimension, int npus) const {
+    vector<Threshold> thresholds;
+    thresholds.push_back({0, best(collective_type, dimension, npus, 1)});
+    uint64_t lower = 1;
+    for (int exponent = 1; exponent <= max_size_exponent; exponent++) {
+        uint64_t size = uint64_t(1) << exponent;
+        while (best(collective_type, dimension, npus, size) !=
+               thresholds.back().implementation) {
+            // smallest size in (lower, size] at which the last winner loses
+            uint64_t upper = size;
+            while (upper - lower > 1) {
+                uint64_t middle = lower + (upper - lower) / 2;
+                if (best(collective_type, dimension, npus, middle) ==
+                    thresholds.back().implementation) {
+                    lower = middle;
+                } else {
+                    upper = middle;
+                }
+            }
+            thresholds.push_back(
+                {upper, best(collective_type, dimension, npus, upper)});
+            lower = upper;
+        }
+        lower = size;
+    }
+    return thresholds;
+}
+
+vector<CollectiveImplType> CollectiveTuner::candidates(ComType collective_type,
+                                                       int npus) const {
+    // Direct is only considered for AllToAll: the per-dimension bandwidth
+    // does not account for the incast of npus - 1 concurrent flows, so the
+    // model would pick it for every reduction.
+    vector<CollectiveImplType> result = {CollectiveImplType::Ring};
+    if (collective_type == ComType::All_to_All) {
+        result.push_back(CollectiveImplType::Direct);
+        result.push_back(CollectiveImplType::Bruck);
+        result.push_back(CollectiveImplType::PairwiseExchange);
+        return result;
+    }
+    result.push_back(CollectiveImplType::HalvingDoubling);
+    // the trees only cover power-of-two NPU counts
+    if (collective_type == ComType::All_Reduce && is_power_of_two(npus)) {
+        result.push_back(CollectiveImplType::DoubleBinaryTree);
+    }
+    return result;
+}
+
+CollectiveImplType CollectiveTuner::best(ComType collective_type,
+                                         int dimension,
+                                         int npus,
+                                         uint64_t data_size) const {
+    CollectiveImplType winner = CollectiveImplType::Ring;
+    double winner_cost = numeric_limits<double>::infinity();
+    for (CollectiveImplType implementation :
+         candidates(collective_type, npus)) {
+        double c =
+            cost(implementation, collective_type, dimension, npus, data_size);
+        if (c < winner_cost) {
+            winner = implementation;
+            winner_cost = c;
+        }
+    }
+    return winner;
+}
+
+// Alpha-beta estimate (ns) of one phase over `npus` NPUs: every step pays
+// the link latency plus the endpoint delay, and every byte 1/bandwidth.
+// `data_size` is the input of the phase on each NPU.
+double CollectiveTuner::cost(CollectiveImplType implementation,
+                             ComType collective_type,
+                             int dimension,
+                             int npus,
+                             uint64_t data_size) const {
+    double p = npus;
+    double bandwidth = bandwidth_at(dimension);
+    double beta = bandwidth > 0 ? 1.0 / bandwidth : 0.0;
+    double alpha = latency_at(dimension) + sys->communication_delay;
+    double bytes = data_size;
+    double steps = ceil(log2(p));
+
+    if (collective_type == ComType::All_to_All) {
+        if (implementation == CollectiveImplType::Direct) {
+            return alpha + (p - 1) * sys->communication_delay +
+                   (p - 1) / p * bytes * beta;
+        }
+        if (implementation == CollectiveImplType::Bruck) {
+            // half of the blocks move in every step, plus reading and
+            // writing the buffer for the initial and final rotations
+            double rotation = sys->local_mem_bw > 0
+                                  ? 4 * bytes / sys->local_mem_bw * 1e9
+                                  : 0.0;
+            return steps * alpha + steps * bytes / 2 * beta + rotation;
+        }
+        if (implementation == CollectiveImplType::PairwiseExchange) {
+            return (p - 1) * alpha + (p - 1) / p * bytes * beta;
+        }
+        // every block is relayed half way around the ring on average
+        return (p - 1) * alpha + (p - 1) / 2 * bytes * beta;
+    }
+
+    // bytes every NPU has to send for one reduce-scatter or all-gather
+    double transfer =
+        (collective_type == ComType::All_Gather ? bytes * p : bytes) *
+        (p - 1) / p;
+    int passes = collective_type == ComType::All_Reduce ? 2 : 1;
+    switch (implementation) {
+    case CollectiveImplType::HalvingDoubling:
+        if (!is_power_of_two(npus)) {
+            // the extra NPUs fold their data onto a neighbour before the
+            // exchange and get the result back after it
+            double folded = exp2(floor(log2(p)));
+            double result =
+                collective_type == ComType::All_Gather ? bytes * p : bytes;
+            return passes * (log2(folded) * alpha +
+                             result * (folded - 1) / folded * beta) +
+                   2 * alpha + (bytes + result) * beta;
+        }
+        return passes * (steps * alpha + transfer * beta);
+    case CollectiveImplType::DoubleBinaryTree:
+        // reduce up and broadcast down the tree, whole chunk per level
+        return 2 * steps * (alpha + bytes * beta);
+    default:
+        return passes * ((p - 1) * alpha + transfer * beta);
+    }
+}
+
+// bytes/ns (GB/s) of the physical dimension behind a logical dimension
+double CollectiveTuner::bandwidth_at(int dimension) const {
+    if (sys->dim_to_break != -1 && dimension > sys->dim_to_break) {
+        dimension--;
+    }
+    if (dimension < 0 ||
+        static_cast<uint64_t>(dimension) >= sys->physical_dims.size()) {
+        return -1;
+    }
+    return sys->comm_NI->get_BW_at_dimension(dimension);
+}
+
+// ns; 0 when the network backend does not report it
+double CollectiveTuner::latency_at(int dimension) const {
+    if (sys->dim_to_break != -1 && dimension > sys->dim_to_break) {
+        dimension--;
+    }
+    if (dimension < 0 ||
+        static_cast<uint64_t>(dimension) >= sys->physical_dims.size()) {
+        return 0;
+    }
+    return max(0.0, sys->comm_NI->get_latency_at_dimension(dimension));
+}
+
+BasicLogicalTopology* CollectiveTuner::tree_topology(RingTopology* ring,
+                                                     ComType collective_type) {
+    tuple<int, int, int> key(ring->get_first_node(), ring->get_stride(),
+                             ring->get_nodes_in_ring());
+    auto it = trees.find(key);
+    if (it == trees.end()) {
+        it = trees
+                 .emplace(key, new DoubleBinaryTreeTopology(
+                                   sys->id, ring->get_nodes_in_ring(),
+                                   ring->get_first_node(), ring->get_stride()))
+                 .first;
+    }
+    return it->second->get_basic_topology_at_dimension(0, collective_type);
+}
+
+void CollectiveTuner::load_table() {
+    ifstream in_file(table_path);
+    json j;
+    in_file >> j;
+    for (const json& entry : j) {
+        Key key(value_of(collective_names, entry["collective"].get<string>()),
+                entry["dimension"], entry["npus"]);
+        vector<Threshold> thresholds;
+        for (const json& threshold : entry["thresholds"]) {
+            thresholds.push_back(
+                {threshold["min-bytes"],
+                 value_of(implementation_names,
+                          threshold["implementation"].get<string>())});
+        }
+        if (thresholds.empty()) {
+            Sys::sys_panic("collective tuner table: entry without thresholds "
+                           "in " +
+                           table_path);
+        }
+        table[key] = thresholds;
+    }
+}
+
+void CollectiveTuner::write_table() const {
+    json j = json::array();
+    for (const auto& entry : table) {
+        json thresholds = json::array();
+        for (const Threshold& threshold : entry.second) {
+            thresholds.push_back(
+                {{"min-bytes", threshold.min_bytes},
+                 {"implementation", name_of(implementation_names,
+                                            threshold.implementation)}});
+        }
+        j.push_back({{"collective",
+                      name_of(collective_names, get<0>(entry.first))},
+                     {"dimension", get<1>(entry.first)},
+                     {"npus", get<2>(entry.first)},
+                     {"thresholds", thresholds}});
+    }
+    ofstream out_file(table_path);
+    if (!out_file) {
+        Sys::sys_panic("Unable to open file: " + table_path);
+    }
+    out_file << j.dump(4) << "\n";
+    LoggerFactory::get_logger("system::scheduling::CollectiveTuner")
+        ->info("collective tuner table written to {}", table_path);
+}
@@ -0,0 +1,98 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __COLLECTIVE_TUNER_HH__
+#define __COLLECTIVE_TUNER_HH__
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "astra-sim/system/Common.hh"
+
+namespace AstraSim {
+
+class Sys;
+class BasicLogicalTopology;
+class RingTopology;
+class DoubleBinaryTreeTopology;
+
+// Chooses the algorithm of every collective phase running on a dimension
+// whose implementation is "auto", in the spirit of NCCL's tuner. An
+// alpha-beta cost model built from the bandwidth and link latency of the
+// dimension is summarized as a table of message size thresholds per
+// (collective, dimension, NPUs). With "collective-tuner-table" set, the table
+// is read from that file if it exists; otherwise NPU 0 calibrates it and
+// writes it there, so later runs (or hand-tuned tables) reuse it.
+class CollectiveTuner {
+  public:
+    // Concrete implementation of a phase and the topology to run it on.
+    struct Choice {
+        CollectiveImpl* implementation;
+        BasicLogicalTopology* topology;
+    };
+
+    CollectiveTuner(Sys* sys, std::string table_path);
+    ~CollectiveTuner();
+
+    Choice select(ComType collective_type,
+                  int dimension,
+                  RingTopology* ring,
+                  uint64_t data_size);
+
+  private:
+    // `implementation` is used from `min_bytes` up to the next threshold.
+    struct Threshold {
+        uint64_t min_bytes;
+        CollectiveImplType implementation;
+    };
+    // (collective, logical dimension, NPUs in the dimension)
+    using Key = std::tuple<ComType, int, int>;
+
+    const std::vector<Threshold>& get_thresholds(ComType collective_type,
+                                                 int dimension,
+                                                 int npus);
+    std::vector<Threshold> calibrate(ComType collective_type,
+                                     int dimension,
+                                     int npus) const;
+    std::vector<CollectiveImplType> candidates(ComType collective_type,
+                                               int npus) const;
+    CollectiveImplType best(ComType collective_type,
+                            int dimension,
+                            int npus,
+                            uint64_t data_size) const;
+    double cost(CollectiveImplType implementation,
+                ComType collective_type,
+                int dimension,
+                int npus,
+                uint64_t data_size) const;
+    double bandwidth_at(int dimension) const;
+    double latency_at(int dimension) const;
+    BasicLogicalTopology* tree_topology(RingTopology* ring,
+                                        ComType collective_type);
+
+    void load_table();
+    void write_table() const;
+
+    Sys* sys;
+    std::string table_path;
+    std::map<Key, std::vector<Threshold>> table;
+    // double binary trees over the NPUs of a ring, by (first NPU, stride,
+    // NPUs)
+    std::map<std::tuple<int, int, int>, DoubleBinaryTreeTopology*> trees;
+
+    CollectiveImpl ring_impl;
+    CollectiveImpl halving_doubling_impl;
+    CollectiveImpl double_binary_tree_impl;
+    DirectCollectiveImpl direct_impl;
+    CollectiveImpl bruck_impl;
+    CollectiveImpl pairwise_exchange_impl;
+};
+
+}  // namespace AstraSim
+
+#endif /* __COLLECTIVE_TUNER_HH__ */
@@ -14,9 +14,9 @@ LICENSE file in the root directory of this source tree.
 
 using namespace AstraSim;
 
-std::map<long long, std::vector<int>> OfflineGreedy::chunk_schedule;
-std::map<long long, int> OfflineGreedy::schedule_consumer;
-std::map<long long, uint64_t> OfflineGreedy::global_chunk_size;
+std::map<OfflineGreedy::ScheduleKey,
+         std::pair<std::shared_ptr<const CollectiveSchedule>, int>>
+    OfflineGreedy::collective_schedule;
 
 DimElapsedTime::DimElapsedTime(int dim_num) {
     this->dim_num = dim_num;
@@ -24,6 +24,7 @@ DimElapsedTime::DimElapsedTime(int dim_num) {
 }
 OfflineGreedy::OfflineGreedy(Sys* sys) {
     this->sys = sys;
+    this->last_reset = 0;
     if (sys->dim_to_break == -1) {
         this->dim_size = sys->physical_dims;
         this->dim_BW.resize(this->dim_size.size());
@@ -60,6 +61,16 @@ OfflineGreedy::OfflineGreedy(Sys* sys) {
         logger->info(buffer.str());
     }
 }
+OfflineGreedy::OfflineGreedy(std::vector<int> dim_size,
+                             std::vector<double> dim_BW) {
+    this->sys = nullptr;
+    this->last_reset = 0;
+    this->dim_size = dim_size;
+    this->dim_BW = dim_BW;
+    for (uint64_t i = 0; i < this->dim_size.size(); i++) {
+        this->dim_elapsed_time.push_back(DimElapsedTime(i));
+    }
+}
 uint64_t OfflineGreedy::get_chunk_size_from_elapsed_time(double elapsed_time,
                                                          DimElapsedTime dim,
                                                          ComType comm_type) {
@@ -84,249 +95,268 @@ void OfflineGreedy::reset_loads() {
         i++;
     }
 }
-std::vector<int> OfflineGreedy::get_chunk_scheduling(
-    long long chunk_id,
-    uint64_t& remaining_data_size,
+void OfflineGreedy::sort_dims_by_load() {
+    // Re-establish the ascending load order left by the previous chunk. There
+    // are only a handful of dims, so an in-place insertion pass is cheaper
+    // than std::sort and keeps ties in their previous order.
+    for (uint64_t i = 1; i < dim_elapsed_time.size(); i++) {
+        DimElapsedTime dim = dim_elapsed_time[i];
+        uint64_t j = i;
+        while (j > 0 && dim < dim_elapsed_time[j - 1]) {
+            dim_elapsed_time[j] = dim_elapsed_time[j - 1];
+            j--;
+        }
+        dim_elapsed_time[j] = dim;
+    }
+}
+std::shared_ptr<const CollectiveSchedule>
+OfflineGreedy::get_collective_schedule(
+    const RingTopology::Table* group,
+    long long first_chunk_id,
+    uint64_t data_size,
     uint64_t recommended_chunk_size,
     std::vector<bool>& dimensions_involved,
     InterDimensionScheduling inter_dim_scheduling,
     ComType comm_type) {
-    if (chunk_schedule.find(chunk_id) != chunk_schedule.end()) {
-        schedule_consumer[chunk_id]++;
-        if (schedule_consumer[chunk_id] ==
-            static_cast<int64_t>(sys->all_sys.size())) {
-            std::vector<int> res = chunk_schedule[chunk_id];
-            remaining_data_size -= global_chunk_size[chunk_id];
-            chunk_schedule.erase(chunk_id);
-            schedule_consumer.erase(chunk_id);
-            global_chunk_size.erase(chunk_id);
-            return res;
+    ScheduleKey key(group, first_chunk_id);
+    auto it = collective_schedule.find(key);
+    if (it == collective_schedule.end()) {
+        // loads are tracked by a single scheduler so that all ranks see the
+        // same schedule, no matter which of them issues the collective first
+        OfflineGreedy* scheduler = sys->all_sys[0]->offline_greedy;
+        if (scheduler->last_reset != Sys::boostedTick()) {
+            scheduler->reset_loads();
+            scheduler->last_reset = Sys::boostedTick();
         }
-        remaining_data_size -= global_chunk_size[chunk_id];
-        return chunk_schedule[chunk_id];
+        int consumers = group == nullptr ? sys->all_sys.size()
+                                         : group->index_to_id.size();
+        std::shared_ptr<const CollectiveSchedule> schedule =
+            scheduler->compute_collective_schedule(
+                data_size, recommended_chunk_size, dimensions_involved,
+                inter_dim_scheduling, comm_type);
+        it = collective_schedule
+                 .insert(std::make_pair(key, std::make_pair(schedule,
+                                                            consumers)))
+                 .first;
     }
-    if (sys->id != 0) {
-        return sys->all_sys[0]->offline_greedy->get_chunk_scheduling(
-            chunk_id, remaining_data_size, recommended_chunk_size,
-            dimensions_involved, inter_dim_scheduling, comm_type);
-    } else {
-        if (comm_type == ComType::All_Reduce) {
-            comm_type = ComType::Reduce_Scatter;
-        }
-        std::sort(dim_elapsed_time.begin(), dim_elapsed_time.end());
-        if (comm_type == ComType::All_Gather) {
-            std::reverse(dim_elapsed_time.begin(), dim_elapsed_time.end());
-        }
-        std::vector<int> result;
-        uint64_t chunk_size = recommended_chunk_size;
-        bool chunk_size_calculated = false;
-        if (inter_dim_scheduling == InterDimensionScheduling::OfflineGreedy) {
-            global_chunk_size[chunk_id] =
-                std::min(remaining_data_size, chunk_size);
-            remaining_data_size -= std::min(remaining_data_size, chunk_size);
+    std::shared_ptr<const CollectiveSchedule> result = it->second.first;
+    if (--it->second.second == 0) {
+        collective_schedule.erase(it);
+    }
+    return result;
+}
+std::shared_ptr<CollectiveSchedule> OfflineGreedy::compute_collective_schedule(
+    uint64_t data_size,
+    uint64_t recommended_chunk_size,
+    std::vector<bool>& dimensions_involved,
+    InterDimensionScheduling inter_dim_scheduling,
+    ComType comm_type) {
+    std::shared_ptr<CollectiveSchedule> schedule =
+        std::make_shared<CollectiveSchedule>();
+    uint64_t remaining_data_size = data_size;
+    while (remaining_data_size > 0) {
+        uint64_t chunk_size = 0;
+        schedule->dim_order.push_back(get_chunk_scheduling(
+            remaining_data_size, recommended_chunk_size, dimensions_involved,
+            inter_dim_scheduling, comm_type, chunk_size));
+        schedule->chunk_size.push_back(chunk_size);
+        if (chunk_size == 0) {
+            break;
         }
-        int dim_elapsed_time_pointer = -1;
-        for (auto& dim : dim_elapsed_time) {
-            dim_elapsed_time_pointer++;
-            if (!dimensions_involved[dim.dim_num] ||
-                dim_size[dim.dim_num] == 1) {
-                result.push_back(dim.dim_num);
-                continue;
-            } else if (inter_dim_scheduling ==
-                           InterDimensionScheduling::OfflineGreedyFlex &&
-                       !chunk_size_calculated) {
-                chunk_size_calculated = true;
-                if (comm_type == ComType::Reduce_Scatter) {
-                    double load_difference =
-                        fabs(dim_elapsed_time.back().elapsed_time -
-                             dim.elapsed_time);
-                    chunk_size = get_chunk_size_from_elapsed_time(
-                        load_difference, dim, ComType::Reduce_Scatter);
-                } else {
-                    int lastIndex = dim_elapsed_time.size() - 1;
-                    while (!dimensions_involved[dim_elapsed_time[lastIndex]
-                                                    .dim_num] ||
-                           dim_size[dim_elapsed_time[lastIndex].dim_num] == 1) {
-                        lastIndex--;
-                    }
-                    double load_difference =
-                        fabs(dim_elapsed_time[lastIndex].elapsed_time -
-                             dim.elapsed_time);
-                    chunk_size = get_chunk_size_from_elapsed_time(
-                        load_difference, dim_elapsed_time[lastIndex],
-                        ComType::All_Gather);
+    }
+    return schedule;
+}
+std::vector<int> OfflineGreedy::get_chunk_scheduling(
+    uint64_t& remaining_data_size,
+    uint64_t recommended_chunk_size,
+    std::vector<bool>& dimensions_involved,
+    InterDimensionScheduling inter_dim_scheduling,
+    ComType comm_type,
+    uint64_t& chunk_size_out) {
+    chunk_size_out = 0;
+    if (comm_type == ComType::All_Reduce) {
+        comm_type = ComType::Reduce_Scatter;
+    }
+    sort_dims_by_load();
+    if (comm_type == ComType::All_Gather) {
+        std::reverse(dim_elapsed_time.begin(), dim_elapsed_time.end());
+    }
+    std::vector<int> result;
+    uint64_t chunk_size = recommended_chunk_size;
+    bool chunk_size_calculated = false;
+    if (inter_dim_scheduling == InterDimensionScheduling::OfflineGreedy) {
+        chunk_size_out = std::min(remaining_data_size, chunk_size);
+        remaining_data_size -= chunk_size_out;
+    }
+    int dim_elapsed_time_pointer = -1;
+    for (auto& dim : dim_elapsed_time) {
+        dim_elapsed_time_pointer++;
+        if (!dimensions_involved[dim.dim_num] || dim_size[dim.dim_num] == 1) {
+            result.push_back(dim.dim_num);
+            continue;
+        } else if (inter_dim_scheduling ==
+                       InterDimensionScheduling::OfflineGreedyFlex &&
+                   !chunk_size_calculated) {
+            chunk_size_calculated = true;
+            if (comm_type == ComType::Reduce_Scatter) {
+                double load_difference =
+                    fabs(dim_elapsed_time.back().elapsed_time -
+                         dim.elapsed_time);
+                chunk_size = get_chunk_size_from_elapsed_time(
+                    load_difference, dim, ComType::Reduce_Scatter);
+            } else {
+                int lastIndex = dim_elapsed_time.size() - 1;
+                while (!dimensions_involved[dim_elapsed_time[lastIndex]
+                                                .dim_num] ||
+                       dim_size[dim_elapsed_time[lastIndex].dim_num] == 1) {
                     lastIndex--;
-                    while (dim_elapsed_time_pointer <= lastIndex) {
-                        if (dimensions_involved[dim_elapsed_time[lastIndex]
-                                                    .dim_num] &&
-                            dim_size[dim_elapsed_time[lastIndex].dim_num] > 1) {
-                            chunk_size /=
-                                dim_size[dim_elapsed_time[lastIndex].dim_num];
-                        }
-                        lastIndex--;
-                    }
                 }
-                if (chunk_size < (recommended_chunk_size)) {
-                    result.resize(dim_elapsed_time.size());
-                    std::iota(std::begin(result), std::end(result), 0);
-                    global_chunk_size[chunk_id] =
-                        std::min(remaining_data_size, recommended_chunk_size);
-                    chunk_size =
-                        std::min(remaining_data_size, recommended_chunk_size);
-                    remaining_data_size -=
-                        std::min(remaining_data_size, recommended_chunk_size);
-                    chunk_schedule[chunk_id] = result;
-                    schedule_consumer[chunk_id] = 1;
-                    std::vector<DimElapsedTime> myReordered;
-                    myReordered.resize(dim_elapsed_time.size(),
-                                       dim_elapsed_time[0]);
-                    for (uint64_t myDim = 0; myDim < dim_elapsed_time.size();
-                         myDim++) {
-                        for (uint64_t searchDim = 0;
-                             searchDim < dim_elapsed_time.size(); searchDim++) {
-                            if (dim_elapsed_time[searchDim].dim_num ==
-                                static_cast<uint64_t>(myDim)) {
-                                myReordered[myDim] =
-                                    dim_elapsed_time[searchDim];
-                                break;
-                            }
-                        }
+                double load_difference =
+                    fabs(dim_elapsed_time[lastIndex].elapsed_time -
+                         dim.elapsed_time);
+                chunk_size = get_chunk_size_from_elapsed_time(
+                    load_difference, dim_elapsed_time[lastIndex],
+                    ComType::All_Gather);
+                lastIndex--;
+                while (dim_elapsed_time_pointer <= lastIndex) {
+                    if (dimensions_involved[dim_elapsed_time[lastIndex]
+                                                .dim_num] &&
+                        dim_size[dim_elapsed_time[lastIndex].dim_num] > 1) {
+                        chunk_size /=
+                            dim_size[dim_elapsed_time[lastIndex].dim_num];
                     }
-                    dim_elapsed_time = myReordered;
-                    if (comm_type == ComType::All_Gather) {
-                        std::reverse(dim_elapsed_time.begin(),
-                                     dim_elapsed_time.end());
+                    lastIndex--;
+                }
+            }
+            if (chunk_size < (recommended_chunk_size)) {
+                result.resize(dim_elapsed_time.size());
+                std::iota(std::begin(result), std::end(result), 0);
+                chunk_size =
+                    std::min(remaining_data_size, recommended_chunk_size);
+                chunk_size_out = chunk_size;
+                remaining_data_size -= chunk_size;
+                std::vector<int> schedule = result;
+                std::vector<DimElapsedTime> myReordered(
+                    dim_elapsed_time.size(), dim_elapsed_time[0]);
+                for (auto& myDim : dim_elapsed_time) {
+                    myReordered[myDim.dim_num] = myDim;
+                }
+                dim_elapsed_time.swap(myReordered);
+                if (comm_type == ComType::All_Gather) {
+                    std::reverse(dim_elapsed_time.begin(),
+                                 dim_elapsed_time.end());
+                }
+                for (uint64_t myDim = 0; myDim < dim_elapsed_time.size();
+                     myDim++) {
+                    if (!dimensions_involved[myDim] || dim_size[myDim] == 1) {
+                        result.push_back(myDim);
+                        continue;
                     }
-                    for (uint64_t myDim = 0; myDim < dim_elapsed_time.size();
-                         myDim++) {
-                        if (!dimensions_involved[myDim] ||
-                            dim_size[myDim] == 1) {
-                            result.push_back(myDim);
-                            continue;
-                        }
-                        if (comm_type == ComType::Reduce_Scatter) {
-                            dim_elapsed_time[myDim].elapsed_time +=
-                                ((((double)chunk_size) / 1048576) *
-                                 (((double)(dim_size[myDim] - 1)) /
-                                  (dim_size[myDim]))) /
-                                (dim_BW[myDim] / dim_BW[0]);
-                            chunk_size /= dim_size[myDim];
-                        } else {
-                            dim_elapsed_time[myDim].elapsed_time +=
-                                ((((double)chunk_size) / 1048576) *
-                                 (((double)(dim_size[myDim] - 1)))) /
-                                (dim_BW[myDim] / dim_BW[0]);
-                            chunk_size *= dim_size[myDim];
-                        }
+                    if (comm_type == ComType::Reduce_Scatter) {
+                        dim_elapsed_time[myDim].elapsed_time +=
+                            ((((double)chunk_size) / 1048576) *
+                             (((double)(dim_size[myDim] - 1)) /
+                              (dim_size[myDim]))) /
+                            (dim_BW[myDim] / dim_BW[0]);
+                        chunk_size /= dim_size[myDim];
+                    } else {
+                        dim_elapsed_time[myDim].elapsed_time +=
+                            ((((double)chunk_size) / 1048576) *
+                             (((double)(dim_size[myDim] - 1)))) /
+                            (dim_BW[myDim] / dim_BW[0]);
+                        chunk_size *= dim_size[myDim];
                     }
-                    return result;
-                } else {
-                    global_chunk_size[chunk_id] =
-                        std::min(remaining_data_size, chunk_size);
-                    remaining_data_size -=
-                        std::min(remaining_data_size, chunk_size);
                 }
-            } else if (inter_dim_scheduling ==
-                           InterDimensionScheduling::OfflineGreedy &&
-                       !chunk_size_calculated) {
-                chunk_size_calculated = true;
-                uint64_t diff_size = 0;
-                if (comm_type == ComType::Reduce_Scatter) {
-                    double load_difference =
-                        fabs(dim_elapsed_time.back().elapsed_time -
-                             dim.elapsed_time);
-                    diff_size = get_chunk_size_from_elapsed_time(
-                        load_difference, dim, ComType::Reduce_Scatter);
-                } else {
-                    int lastIndex = dim_elapsed_time.size() - 1;
-                    while (!dimensions_involved[dim_elapsed_time[lastIndex]
-                                                    .dim_num] ||
-                           dim_size[dim_elapsed_time[lastIndex].dim_num] == 1) {
-                        lastIndex--;
-                    }
-                    double load_difference =
-                        fabs(dim_elapsed_time[lastIndex].elapsed_time -
-                             dim.elapsed_time);
-                    diff_size = get_chunk_size_from_elapsed_time(
-                        load_difference, dim_elapsed_time[lastIndex],
-                        ComType::All_Gather);
+                return schedule;
+            } else {
+                chunk_size_out = std::min(remaining_data_size, chunk_size);
+                remaining_data_size -= chunk_size_out;
+            }
+        } else if (inter_dim_scheduling ==
+                       InterDimensionScheduling::OfflineGreedy &&
+                   !chunk_size_calculated) {
+            chunk_size_calculated = true;
+            uint64_t diff_size = 0;
+            if (comm_type == ComType::Reduce_Scatter) {
+                double load_difference =
+                    fabs(dim_elapsed_time.back().elapsed_time -
+                         dim.elapsed_time);
+                diff_size = get_chunk_size_from_elapsed_time(
+                    load_difference, dim, ComType::Reduce_Scatter);
+            } else {
+                int lastIndex = dim_elapsed_time.size() - 1;
+                while (!dimensions_involved[dim_elapsed_time[lastIndex]
+                                                .dim_num] ||
+                       dim_size[dim_elapsed_time[lastIndex].dim_num] == 1) {
                     lastIndex--;
-                    while (dim_elapsed_time_pointer <= lastIndex) {
-                        if (dimensions_involved[dim_elapsed_time[lastIndex]
-                                                    .dim_num] &&
-                            dim_size[dim_elapsed_time[lastIndex].dim_num] > 1) {
-                            diff_size /=
-                                dim_size[dim_elapsed_time[lastIndex].dim_num];
-                        }
-                        lastIndex--;
-                    }
                 }
-                if (diff_size < (recommended_chunk_size / 16)) {
-                    result.resize(dim_elapsed_time.size());
-                    std::iota(std::begin(result), std::end(result), 0);
-                    chunk_schedule[chunk_id] = result;
-                    schedule_consumer[chunk_id] = 1;
-                    std::vector<DimElapsedTime> myReordered;
-                    myReordered.resize(dim_elapsed_time.size(),
-                                       dim_elapsed_time[0]);
-                    for (uint64_t myDim = 0; myDim < dim_elapsed_time.size();
-                         myDim++) {
-                        for (uint64_t searchDim = 0;
-                             searchDim < dim_elapsed_time.size(); searchDim++) {
-                            if (dim_elapsed_time[searchDim].dim_num ==
-                                static_cast<uint64_t>(myDim)) {
-                                myReordered[myDim] =
-                                    dim_elapsed_time[searchDim];
-                                break;
-                            }
-                        }
+                double load_difference =
+                    fabs(dim_elapsed_time[lastIndex].elapsed_time -
+                         dim.elapsed_time);
+                diff_size = get_chunk_size_from_elapsed_time(
+                    load_difference, dim_elapsed_time[lastIndex],
+                    ComType::All_Gather);
+                lastIndex--;
+                while (dim_elapsed_time_pointer <= lastIndex) {
+                    if (dimensions_involved[dim_elapsed_time[lastIndex]
+                                                .dim_num] &&
+                        dim_size[dim_elapsed_time[lastIndex].dim_num] > 1) {
+                        diff_size /=
+                            dim_size[dim_elapsed_time[lastIndex].dim_num];
                     }
-                    dim_elapsed_time = myReordered;
-                    if (comm_type == ComType::All_Gather) {
-                        std::reverse(dim_elapsed_time.begin(),
-                                     dim_elapsed_time.end());
+                    lastIndex--;
+                }
+            }
+            if (diff_size < (recommended_chunk_size / 16)) {
+                result.resize(dim_elapsed_time.size());
+                std::iota(std::begin(result), std::end(result), 0);
+                std::vector<DimElapsedTime> myReordered(
+                    dim_elapsed_time.size(), dim_elapsed_time[0]);
+                for (auto& myDim : dim_elapsed_time) {
+                    myReordered[myDim.dim_num] = myDim;
+                }
+                dim_elapsed_time.swap(myReordered);
+                if (comm_type == ComType::All_Gather) {
+                    std::reverse(dim_elapsed_time.begin(),
+                                 dim_elapsed_time.end());
+                }
+                for (uint64_t myDim = 0; myDim < dim_elapsed_time.size();
+                     myDim++) {
+                    if (!dimensions_involved[myDim] || dim_size[myDim] == 1) {
+                        // result.push_back(myDim);
+                        continue;
                     }
-                    for (uint64_t myDim = 0; myDim < dim_elapsed_time.size();
-                         myDim++) {
-                        if (!dimensions_involved[myDim] ||
-                            dim_size[myDim] == 1) {
-                            // result.push_back(myDim);
-                            continue;
-                        }
-                        if (comm_type == ComType::Reduce_Scatter) {
-                            dim_elapsed_time[myDim].elapsed_time +=
-                                ((((double)chunk_size) / 1048576) *
-                                 (((double)(dim_size[myDim] - 1)) /
-                                  (dim_size[myDim]))) /
-                                (dim_BW[myDim] / dim_BW[0]);
-                            chunk_size /= dim_size[myDim];
-                        } else {
-                            dim_elapsed_time[myDim].elapsed_time +=
-                                ((((double)chunk_size) / 1048576) *
-                                 (((double)(dim_size[myDim] - 1)))) /
-                                (dim_BW[myDim] / dim_BW[0]);
-                            chunk_size *= dim_size[myDim];
-                        }
+                    if (comm_type == ComType::Reduce_Scatter) {
+                        dim_elapsed_time[myDim].elapsed_time +=
+                            ((((double)chunk_size) / 1048576) *
+                             (((double)(dim_size[myDim] - 1)) /
+                              (dim_size[myDim]))) /
+                            (dim_BW[myDim] / dim_BW[0]);
+                        chunk_size /= dim_size[myDim];
+                    } else {
+                        dim_elapsed_time[myDim].elapsed_time +=
+                            ((((double)chunk_size) / 1048576) *
+                             (((double)(dim_size[myDim] - 1)))) /
+                            (dim_BW[myDim] / dim_BW[0]);
+                        chunk_size *= dim_size[myDim];
                     }
-                    return result;
                 }
-            }
-            result.push_back(dim.dim_num);
-            if (comm_type == ComType::Reduce_Scatter) {
-                dim.elapsed_time += ((((double)chunk_size) / 1048576) *
-                                     (((double)(dim_size[dim.dim_num] - 1)) /
-                                      (dim_size[dim.dim_num]))) /
-                                    (dim_BW[dim.dim_num] / dim_BW[0]);
-                chunk_size /= dim_size[dim.dim_num];
-            } else {
-                dim.elapsed_time += ((((double)chunk_size) / 1048576) *
-                                     (((double)(dim_size[dim.dim_num] - 1)))) /
-                                    (dim_BW[dim.dim_num] / dim_BW[0]);
-                chunk_size *= dim_size[dim.dim_num];
+                return result;
             }
         }
-        chunk_schedule[chunk_id] = result;
-        schedule_consumer[chunk_id] = 1;
-        return result;
+        result.push_back(dim.dim_num);
+        if (comm_type == ComType::Reduce_Scatter) {
+            dim.elapsed_time += ((((double)chunk_size) / 1048576) *
+                                 (((double)(dim_size[dim.dim_num] - 1)) /
+                                  (dim_size[dim.dim_num]))) /
+                                (dim_BW[dim.dim_num] / dim_BW[0]);
+            chunk_size /= dim_size[dim.dim_num];
+        } else {
+            dim.elapsed_time += ((((double)chunk_size) / 1048576) *
+                                 (((double)(dim_size[dim.dim_num] - 1)))) /
+                                (dim_BW[dim.dim_num] / dim_BW[0]);
+            chunk_size *= dim_size[dim.dim_num];
+        }
     }
+    return result;
 }
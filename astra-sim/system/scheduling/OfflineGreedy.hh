@@ -6,10 +6,14 @@ LICENSE file in the root directory of this source tree.
 #ifndef __OFFLINE_GREEDY_HH__
 #define __OFFLINE_GREEDY_HH__
 
+#include <map>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "astra-sim/system/Common.hh"
 #include "astra-sim/system/Sys.hh"
+#include "astra-sim/system/topology/RingTopology.hh"
 
 namespace AstraSim {
 
@@ -22,27 +26,62 @@ class DimElapsedTime {
         return (elapsed_time < dimElapsedTime.elapsed_time);
     }
 };
+// Themis schedule of one collective: the dimension order and the size of
+// every chunk, computed once and shared by all ranks taking part in it.
+class CollectiveSchedule {
+  public:
+    std::vector<std::vector<int>> dim_order;
+    std::vector<uint64_t> chunk_size;
+};
 class OfflineGreedy {
   public:
     Sys* sys;
     std::vector<DimElapsedTime> dim_elapsed_time;
     std::vector<double> dim_BW;
     std::vector<int> dim_size;
+    Tick last_reset;
     OfflineGreedy(Sys* sys);
+    OfflineGreedy(std::vector<int> dim_size, std::vector<double> dim_BW);
     void reset_loads();
+    // `group` is the interned member table of the communicator group, or
+    // nullptr for a collective over all NPUs.
+    std::shared_ptr<const CollectiveSchedule> get_collective_schedule(
+        const RingTopology::Table* group,
+        long long first_chunk_id,
+        uint64_t data_size,
+        uint64_t recommended_chunk_size,
+        std::vector<bool>& dimensions_involved,
+        InterDimensionScheduling inter_dim_scheduling,
+        ComType comm_type);
+    std::shared_ptr<CollectiveSchedule> compute_collective_schedule(
+        uint64_t data_size,
+        uint64_t recommended_chunk_size,
+        std::vector<bool>& dimensions_involved,
+        InterDimensionScheduling inter_dim_scheduling,
+        ComType comm_type);
     std::vector<int> get_chunk_scheduling(
-        long long chunk_id,
         uint64_t& remaining_data_size,
         uint64_t recommended_chunk_size,
         std::vector<bool>& dimensions_involved,
         InterDimensionScheduling inter_dim_scheduling,
-        ComType comm_type);
+        ComType comm_type,
+        uint64_t& chunk_size_out);
     uint64_t get_chunk_size_from_elapsed_time(double elapsed_time,
                                               DimElapsedTime dim,
                                               ComType comm_type);
-    static std::map<long long, std::vector<int>> chunk_schedule;
-    static std::map<long long, int> schedule_consumer;
-    static std::map<long long, uint64_t> global_chunk_size;
+
+    // Keyed by (member table, first chunk id) so that collectives of
+    // different communicator groups never share an entry. Tables are interned
+    // by RingTopology::get_table, so every rank of a group passes the same
+    // pointer. The int counts the ranks that still have to fetch the
+    // schedule.
+    typedef std::pair<const RingTopology::Table*, long long> ScheduleKey;
+    static std::map<ScheduleKey,
+                    std::pair<std::shared_ptr<const CollectiveSchedule>, int>>
+        collective_schedule;
+
+  private:
+    void sort_dims_by_load();
 };
 
 }  // namespace AstraSim
@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #include "astra-sim/system/topology/BinaryTree.hh"
 #include "astra-sim/common/Logging.hh"
 
+#include <cassert>
 #include <iostream>
 
 using namespace std;
@@ -18,108 +19,134 @@ BinaryTree::BinaryTree(
     this->start = start;
     this->tree_type = tree_type;
     this->stride = stride;
-    tree = new Node(-1, nullptr, nullptr, nullptr);
+    this->table = get_table(tree_type, total_tree_nodes);
+}
+
+BinaryTree::~BinaryTree() {}
+
+shared_ptr<const BinaryTree::Table> BinaryTree::get_table(
+    TreeType tree_type, int total_tree_nodes) {
+    static map<pair<TreeType, int>, weak_ptr<const Table>> tables;
+    auto key = make_pair(tree_type, total_tree_nodes);
+    auto it = tables.find(key);
+    if (it != tables.end()) {
+        shared_ptr<const Table> table = it->second.lock();
+        if (table != nullptr) {
+            return table;
+        }
+    }
+
+    auto table = make_shared<Table>();
     int depth = 1;
     int tmp = total_tree_nodes;
     while (tmp > 1) {
         depth++;
         tmp /= 2;
     }
+    // The root has a single child subtree: on its right for RootMin (so the
+    // root is the first node in order) and on its left for RootMax (so the
+    // root is the last one).
+    int root;
+    int subtree;
     if (tree_type == TreeType::RootMin) {
-        tree->right_child = initialize_tree(depth - 1, tree);
+        root = build_subtree(*table, 0);
+        subtree = build_subtree(*table, depth - 1);
+        table->right_child[root] = subtree;
     } else {
-        tree->left_child = initialize_tree(depth - 1, tree);
+        subtree = build_subtree(*table, depth - 1);
+        root = build_subtree(*table, 0);
+        table->left_child[root] = subtree;
     }
-    build_tree(tree);
-}
+    table->parent[subtree] = root;
 
-BinaryTree::~BinaryTree() {
-    for (auto n : node_list) {
-        delete n.second;
-    }
+    tables[key] = table;
+    return table;
 }
 
-Node* BinaryTree::initialize_tree(int depth, Node* parent) {
-    Node* tmp = new Node(-1, parent, nullptr, nullptr);
+// Appends a complete subtree in in-order and returns the position of its
+// root. A depth below 2 yields a single node.
+int BinaryTree::build_subtree(Table& table, int depth) {
+    int left = -1;
     if (depth > 1) {
-        tmp->left_child = initialize_tree(depth - 1, tmp);
-        tmp->right_child = initialize_tree(depth - 1, tmp);
+        left = build_subtree(table, depth - 1);
+    }
+    int self = table.parent.size();
+    table.parent.push_back(-1);
+    table.left_child.push_back(left);
+    table.right_child.push_back(-1);
+    if (left != -1) {
+        table.parent[left] = self;
     }
-    return tmp;
+    if (depth > 1) {
+        int right = build_subtree(table, depth - 1);
+        table.right_child[self] = right;
+        table.parent[right] = self;
+    }
+    return self;
 }
 
-void BinaryTree::build_tree(Node* node) {
-    if (node->left_child != nullptr) {
-        build_tree(node->left_child);
-    }
-    node->id = start;
-    node_list[start] = node;
-    start += stride;
-    if (node->right_child != nullptr) {
-        build_tree(node->right_child);
+int BinaryTree::position_of(int id) const {
+    assert(id >= start && (id - start) % stride == 0);
+    int position = (id - start) / stride;
+    assert(position < static_cast<int>(table->parent.size()));
+    return position;
+}
+
+int BinaryTree::id_at(int position) const {
+    if (position == -1) {
+        return -1;
     }
-    return;
+    return start + position * stride;
 }
 
 int BinaryTree::get_parent_id(int id) {
-    Node* parent = this->node_list[id]->parent;
-    if (parent != nullptr) {
-        return parent->id;
-    }
-    return -1;
+    return id_at(table->parent[position_of(id)]);
 }
 
 int BinaryTree::get_right_child_id(int id) {
-    Node* child = this->node_list[id]->right_child;
-    if (child != nullptr) {
-        return child->id;
-    }
-    return -1;
+    return id_at(table->right_child[position_of(id)]);
 }
 
 int BinaryTree::get_left_child_id(int id) {
-    Node* child = this->node_list[id]->left_child;
-    if (child != nullptr) {
-        return child->id;
-    }
-    return -1;
+    return id_at(table->left_child[position_of(id)]);
 }
 
 BinaryTree::Type BinaryTree::get_node_type(int id) {
-    Node* node = this->node_list[id];
-    if (node->parent == nullptr) {
+    int position = position_of(id);
+    if (table->parent[position] == -1) {
         return Type::Root;
-    } else if (node->left_child == nullptr && node->right_child == nullptr) {
+    } else if (table->left_child[position] == -1 &&
+               table->right_child[position] == -1) {
         return Type::Leaf;
     } else {
         return Type::Intermediate;
     }
 }
 
-void BinaryTree::print(Node* node) {
+void BinaryTree::print() {
     auto logger = LoggerFactory::get_logger("system::topology::BinaryTree");
-    logger->debug("I am node: {}", node->id);
-    if (node->left_child != nullptr) {
-        logger->debug("and my left child is {}", node->left_child->id);
-    }
-    if (node->right_child != nullptr) {
-        logger->debug("and my right child is {}", node->right_child->id);
-    }
-    if (node->parent != nullptr) {
-        logger->debug("and my parent is {}", node->parent->id);
-    }
-    BinaryTree::Type typ = get_node_type(node->id);
-    if (typ == BinaryTree::Type::Root) {
-        logger->debug("and I am Root");
-    } else if (typ == BinaryTree::Type::Intermediate) {
-        logger->debug("and I am Intermediate");
-    } else if (typ == BinaryTree::Type::Leaf) {
-        logger->debug("and I am Leaf");
-    }
-    if (node->left_child != nullptr) {
-        print(node->left_child);
-    }
-    if (node->right_child != nullptr) {
-        print(node->right_child);
+    for (uint64_t position = 0; position < table->parent.size(); position++) {
+        int node = id_at(position);
+        ASTRA_LOG_DEBUG(logger, "I am node: {}", node);
+        if (get_left_child_id(node) != -1) {
+            ASTRA_LOG_DEBUG(logger, "and my left child is {}",
+                            get_left_child_id(node));
+        }
+        if (get_right_child_id(node) != -1) {
+            ASTRA_LOG_DEBUG(logger, "and my right child is {}",
+                            get_right_child_id(node));
+        }
+        if (get_parent_id(node) != -1) {
+            ASTRA_LOG_DEBUG(logger, "and my parent is {}",
+                            get_parent_id(node));
+        }
+        BinaryTree::Type typ = get_node_type(node);
+        if (typ == BinaryTree::Type::Root) {
+            ASTRA_LOG_DEBUG(logger, "and I am Root");
+        } else if (typ == BinaryTree::Type::Intermediate) {
+            ASTRA_LOG_DEBUG(logger, "and I am Intermediate");
+        } else if (typ == BinaryTree::Type::Leaf) {
+            ASTRA_LOG_DEBUG(logger, "and I am Leaf");
+        }
     }
 }
@@ -7,10 +7,11 @@ LICENSE file in the root directory of this source tree.
 #define __BINARY_TREE_HH__
 
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "astra-sim/system/Common.hh"
 #include "astra-sim/system/topology/BasicLogicalTopology.hh"
-#include "astra-sim/system/topology/Node.hh"
 
 namespace AstraSim {
 
@@ -19,6 +20,17 @@ class BinaryTree : public BasicLogicalTopology {
     enum class TreeType { RootMax, RootMin };
     enum class Type { Leaf, Root, Intermediate };
 
+    // Immutable tree shape in in-order positions (-1 means no such node).
+    // It only depends on the tree type and size, so all trees of the same
+    // shape share one instance and map positions to ids as start + i * stride.
+    struct Table {
+        std::vector<int> parent;
+        std::vector<int> left_child;
+        std::vector<int> right_child;
+    };
+    static std::shared_ptr<const Table> get_table(TreeType tree_type,
+                                                  int total_tree_nodes);
+
     BinaryTree(int id,
                TreeType tree_type,
                int total_tree_nodes,
@@ -30,20 +42,22 @@ class BinaryTree : public BasicLogicalTopology {
         return total_tree_nodes;
     }
 
-    Node* initialize_tree(int depth, Node* parent);
-    void build_tree(Node* node);
     int get_parent_id(int id);
     int get_left_child_id(int id);
     int get_right_child_id(int id);
     Type get_node_type(int id);
-    void print(Node* node);
+    void print();
 
     int total_tree_nodes;
     int start;
     TreeType tree_type;
     int stride;
-    Node* tree;
-    std::map<int, Node*> node_list;
+    std::shared_ptr<const Table> table;
+
+  private:
+    static int build_subtree(Table& table, int depth);
+    int position_of(int id) const;
+    int id_at(int position) const;
 };
 
 }  // namespace AstraSim
@@ -24,8 +24,17 @@ GeneralComplexTopology::GeneralComplexTopology(
     assert(collective_impl.size() <= dimension_size.size());
     for (uint64_t dim = 0; dim < collective_impl.size(); dim++) {
         if (collective_impl[dim]->type == CollectiveImplType::Ring ||
+            collective_impl[dim]->type == CollectiveImplType::PipelinedRing ||
             collective_impl[dim]->type == CollectiveImplType::Direct ||
             collective_impl[dim]->type == CollectiveImplType::HalvingDoubling ||
+            collective_impl[dim]->type == CollectiveImplType::Bruck ||
+            collective_impl[dim]->type ==
+                CollectiveImplType::InNetworkReduction ||
+            collective_impl[dim]->type ==
+                CollectiveImplType::PairwiseExchange ||
+            // "auto" phases run on the ring; the CollectiveTuner builds the
+            // trees itself when it picks DoubleBinaryTree.
+            collective_impl[dim]->type == CollectiveImplType::Auto ||
             // While executing a collective according a Chakra ET representation
             // does not need information on the logical topology, The system
             // layer's logic of defining and invoking "collective phase" objects
@@ -54,7 +63,9 @@ GeneralComplexTopology::GeneralComplexTopology(
             dimension_topology.push_back(ring);
             return;
         } else if (collective_impl[dim]->type ==
-                   CollectiveImplType::DoubleBinaryTree) {
+                       CollectiveImplType::DoubleBinaryTree ||
+                   collective_impl[dim]->type ==
+                       CollectiveImplType::PipelinedDoubleBinaryTree) {
             if (dim == last_dim) {
                 DoubleBinaryTreeTopology* DBT = new DoubleBinaryTreeTopology(
                     id, dimension_size[dim], id % offset, offset);
@@ -72,6 +83,10 @@ GeneralComplexTopology::GeneralComplexTopology(
     }
 }
 
+GeneralComplexTopology::GeneralComplexTopology(
+    std::vector<LogicalTopology*> dimension_topology)
+    : dimension_topology(std::move(dimension_topology)) {}
+
 GeneralComplexTopology::~GeneralComplexTopology() {
     for (uint64_t i = 0; i < dimension_topology.size(); i++) {
         delete dimension_topology[i];
@@ -17,6 +17,9 @@ class GeneralComplexTopology : public ComplexLogicalTopology {
     GeneralComplexTopology(int id,
                            std::vector<int> dimension_size,
                            std::vector<CollectiveImpl*> collective_impl);
+    // takes ownership of prebuilt per-dimension topologies
+    explicit GeneralComplexTopology(
+        std::vector<LogicalTopology*> dimension_topology);
     ~GeneralComplexTopology();
 
     int get_num_of_dimensions() override;
@@ -12,7 +12,34 @@ LICENSE file in the root directory of this source tree.
 using namespace std;
 using namespace AstraSim;
 
+shared_ptr<const RingTopology::Table> RingTopology::get_table(
+    const std::vector<int>& NPUs) {
+    // Tables are kept alive by the topologies using them; the registry only
+    // lets ranks that are built later find the already existing instance.
+    static map<vector<int>, weak_ptr<const Table>> tables;
+    auto it = tables.find(NPUs);
+    if (it != tables.end()) {
+        shared_ptr<const Table> table = it->second.lock();
+        if (table != nullptr) {
+            return table;
+        }
+    }
+    auto table = make_shared<Table>();
+    table->index_to_id = NPUs;
+    table->id_to_index.reserve(NPUs.size());
+    for (uint64_t i = 0; i < NPUs.size(); i++) {
+        table->id_to_index[NPUs[i]] = i;
+    }
+    tables[NPUs] = table;
+    return table;
+}
+
 RingTopology::RingTopology(Dimension dimension, int id, std::vector<int> NPUs)
+    : RingTopology(dimension, id, get_table(NPUs)) {}
+
+RingTopology::RingTopology(Dimension dimension,
+                           int id,
+                           shared_ptr<const Table> table)
     : BasicLogicalTopology(BasicLogicalTopology::BasicTopology::Ring) {
     name = "local";
     if (dimension == Dimension::Vertical) {
@@ -20,17 +47,16 @@ RingTopology::RingTopology(Dimension dimension, int id, std::vector<int> NPUs)
     } else if (dimension == Dimension::Horizontal) {
         name = "horizontal";
     }
+    this->table = std::move(table);
     this->id = id;
-    this->total_nodes_in_ring = NPUs.size();
+    this->total_nodes_in_ring = this->table->index_to_id.size();
     this->dimension = dimension;
+    this->base = -1;
     this->offset = -1;
     this->index_in_ring = -1;
-    for (int i = 0; i < total_nodes_in_ring; i++) {
-        id_to_index[NPUs[i]] = i;
-        index_to_id[i] = NPUs[i];
-        if (id == NPUs[i]) {
-            index_in_ring = i;
-        }
+    auto it = this->table->id_to_index.find(id);
+    if (it != this->table->id_to_index.end()) {
+        index_in_ring = it->second;
     }
 
     LoggerFactory::get_logger("system::topology::RingTopology")
@@ -41,6 +67,7 @@ RingTopology::RingTopology(Dimension dimension, int id, std::vector<int> NPUs)
 
     assert(index_in_ring >= 0);
 }
+
 RingTopology::RingTopology(Dimension dimension,
                            int id,
                            int total_nodes_in_ring,
@@ -65,95 +92,66 @@ RingTopology::RingTopology(Dimension dimension,
     this->index_in_ring = index_in_ring;
     this->dimension = dimension;
     this->offset = offset;
+    this->base = id - index_in_ring * offset;
+    if (base < 0) {
+        LoggerFactory::get_logger("system::topology::RingTopology")
+            ->critical("at dim: {} at id: {} index_in_ring: {} offset: {}, "
+                       "first node of the ring would be {}",
+                       name, id, index_in_ring, offset, base);
+    }
+    assert(base >= 0);
+}
 
-    id_to_index[id] = index_in_ring;
-    index_to_id[index_in_ring] = id;
-    int tmp = id;
-    for (int i = 0; i < total_nodes_in_ring - 1; i++) {
-        tmp = get_receiver_homogeneous(tmp, RingTopology::Direction::Clockwise,
-                                       offset);
+int RingTopology::index_of(int node_id) const {
+    if (table != nullptr) {
+        auto it = table->id_to_index.find(node_id);
+        assert(it != table->id_to_index.end());
+        return it->second;
     }
+    assert(node_id >= base && (node_id - base) % offset == 0);
+    int index = (node_id - base) / offset;
+    assert(index < total_nodes_in_ring);
+    return index;
 }
 
-int RingTopology::get_receiver_homogeneous(int node_id,
-                                           Direction direction,
-                                           int offset) {
-    assert(id_to_index.find(node_id) != id_to_index.end());
-    int index = id_to_index[node_id];
-    if (direction == RingTopology::Direction::Clockwise) {
-        int receiver = node_id + offset;
-        if (index == total_nodes_in_ring - 1) {
-            receiver -= (total_nodes_in_ring * offset);
-            index = 0;
-        } else {
-            index++;
-        }
-        if (receiver < 0) {
-            LoggerFactory::get_logger("system::topology::RingTopology")
-                ->critical("at dim: {} at id: {} dimension: {} index: {}, node "
-                           "id: {}, offset: {}, index_in_ring {} receiver {}",
-                           name, id, name, index, node_id, offset,
-                           index_in_ring, receiver);
-        }
-        assert(receiver >= 0);
-        id_to_index[receiver] = index;
-        index_to_id[index] = receiver;
-        return receiver;
-    } else {
-        int receiver = node_id - offset;
-        if (index == 0) {
-            receiver += (total_nodes_in_ring * offset);
-            index = total_nodes_in_ring - 1;
-        } else {
-            index--;
-        }
-        if (receiver < 0) {
-            LoggerFactory::get_logger("system::topology::RingTopology")
-                ->critical("at dim: {} at id: {} dimension: {} index: {}, node "
-                           "id: {}, offset: {}, index_in_ring {} receiver {}",
-                           name, id, name, index, node_id, offset,
-                           index_in_ring, receiver);
-        }
-        assert(receiver >= 0);
-        id_to_index[receiver] = index;
-        index_to_id[index] = receiver;
-        return receiver;
+int RingTopology::id_at(int index) const {
+    if (table != nullptr) {
+        return table->index_to_id[index];
     }
+    return base + index * offset;
 }
 
 int RingTopology::get_receiver(int node_id, Direction direction) {
-    assert(id_to_index.find(node_id) != id_to_index.end());
-    int index = id_to_index[node_id];
+    int index = index_of(node_id);
     if (direction == RingTopology::Direction::Clockwise) {
         index++;
         if (index == total_nodes_in_ring) {
             index = 0;
         }
-        return index_to_id[index];
+        return id_at(index);
     } else {
         index--;
         if (index < 0) {
             index = total_nodes_in_ring - 1;
         }
-        return index_to_id[index];
+        return id_at(index);
     }
 }
 
 int RingTopology::get_sender(int node_id, Direction direction) {
-    assert(id_to_index.find(node_id) != id_to_index.end());
-    int index = id_to_index[node_id];
+    int index = index_of(node_id);
     if (direction == RingTopology::Direction::Anticlockwise) {
         index++;
         if (index == total_nodes_in_ring) {
             index = 0;
         }
-        return index_to_id[index];
+        return id_at(index);
     } else {
         index--;
         if (index < 0) {
             index = total_nodes_in_ring - 1;
         }
-        return index_to_id[index];
+        return id_at(index);
     }
 }
 
@@ -161,6 +159,14 @@ int RingTopology::get_index_in_ring() {
     return index_in_ring;
 }
 
+int RingTopology::get_first_node() const {
+    return base;
+}
+
+int RingTopology::get_stride() const {
+    return offset;
+}
+
 RingTopology::Dimension RingTopology::get_dimension() {
     return dimension;
 }
@@ -175,14 +181,5 @@ int RingTopology::get_nodes_in_ring() {
 
 bool RingTopology::is_enabled() {
     assert(offset > 0);
-    int tmp_index = index_in_ring;
-    int tmp_id = id;
-    while (tmp_index > 0) {
-        tmp_index--;
-        tmp_id -= offset;
-    }
-    if (tmp_id == 0) {
-        return true;
-    }
-    return false;
+    return base == 0;
 }
@@ -7,6 +7,7 @@ LICENSE file in the root directory of this source tree.
 #define __RING_TOPOLOGY_HH__
 
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -19,6 +20,15 @@ class RingTopology : public BasicLogicalTopology {
   public:
     enum class Direction { Clockwise, Anticlockwise };
     enum class Dimension { Local, Vertical, Horizontal, NA };
+
+    // Immutable member list of a custom ring. All ranks of the same ring
+    // share one instance (see get_table()); each rank only keeps its index.
+    struct Table {
+        std::vector<int> index_to_id;
+        std::unordered_map<int, int> id_to_index;
+    };
+    static std::shared_ptr<const Table> get_table(const std::vector<int>& NPUs);
+
     int get_num_of_nodes_in_dimension(int dimension) override;
     RingTopology(Dimension dimension,
                  int id,
@@ -26,27 +36,36 @@ class RingTopology : public BasicLogicalTopology {
                  int index_in_ring,
                  int offset);
     RingTopology(Dimension dimension, int id, std::vector<int> NPUs);
+    RingTopology(Dimension dimension,
+                 int id,
+                 std::shared_ptr<const Table> table);
     virtual int get_receiver(int node_id, Direction direction);
     virtual int get_sender(int node_id, Direction direction);
     int get_nodes_in_ring();
     bool is_enabled();
     Dimension get_dimension();
     int get_index_in_ring();
+    // First NPU and NPU id stride of a ring over evenly spaced NPUs; both are
+    // -1 for rings built from an explicit NPU list.
+    int get_first_node() const;
+    int get_stride() const;
+
+    // position of an NPU in the ring and the NPU at a position
+    int index_of(int node_id) const;
+    int id_at(int index) const;
 
   private:
-    std::unordered_map<int, int> id_to_index;
-    std::unordered_map<int, int> index_to_id;
+    // homogeneous rings (table == nullptr) are resolved arithmetically as
+    // base, base + offset, ..., base + (total_nodes_in_ring - 1) * offset
+    std::shared_ptr<const Table> table;
 
     std::string name;
     int id;
+    int base;
     int offset;
     int total_nodes_in_ring;
     int index_in_ring;
     Dimension dimension;
-
-    virtual int get_receiver_homogeneous(int node_id,
-                                         Direction direction,
-                                         int offset);
 };
 
 }  // namespace AstraSim
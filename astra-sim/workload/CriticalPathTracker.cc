@@ -0,0 +1,165 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/workload/CriticalPathTracker.hh"
+
+#include <json/json.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace AstraSim;
+using json = nlohmann::json;
+
+/**
+ * @brief 构造函数
+ */
+CriticalPathTracker::CriticalPathTracker() : last_finished(no_record) {}
+
+/**
+ * @brief 查找或登记归因类别
+ * @param category 归因类别
+ * @return 类别下标
+ */
+uint32_t CriticalPathTracker::get_category_index(
+    const NodeCategory& category) {
+    string key = category.kind + '\0' + category.collective + '\0' +
+                 category.comm_group + '\0' + category.dims;
+    auto it = category_index.find(key);
+    if (it != category_index.end()) {
+        return it->second;
+    }
+    uint32_t index = static_cast<uint32_t>(categories.size());
+    categories.push_back(category);
+    category_index.emplace(std::move(key), index);
+    return index;
+}
+
+/**
+ * @brief 记录节点被调度，触发者为最近完成的节点
+ */
+void CriticalPathTracker::node_issued(uint64_t node_id,
+                                      const NodeCategory& category,
+                                      Tick tick) {
+    NodeRecord record;
+    record.node_id = node_id;
+    record.start = tick;
+    record.end = tick;
+    record.category = get_category_index(category);
+    record.trigger = last_finished;
+    record.finished = false;
+    record_index[node_id] = static_cast<uint32_t>(records.size());
+    records.push_back(record);
+}
+
+/**
+ * @brief 记录节点完成
+ */
+void CriticalPathTracker::node_finished(uint64_t node_id, Tick tick) {
+    auto it = record_index.find(node_id);
+    if (it == record_index.end()) {
+        return;
+    }
+    NodeRecord& record = records[it->second];
+    record.end = tick;
+    record.finished = true;
+    last_finished = it->second;
+}
+
+/**
+ * @brief 沿触发者链回溯关键路径，并按类别汇总
+ *
+ * 路径上每个节点贡献其执行时间（结束 - 开始）；由于节点在触发者完成的
+ * 同一时刻被调度，各段首尾相接，总和即为最后一个节点的完成时刻减去
+ * 路径起点的调度时刻。
+ */
+string CriticalPathTracker::report(int sys_id) const {
+    struct CategoryStats {
+        uint64_t nodes = 0;
+        Tick busy_ticks = 0;
+        uint64_t critical_nodes = 0;
+        Tick critical_ticks = 0;
+    };
+    vector<CategoryStats> stats(categories.size());
+
+    // 所有已完成节点的执行时间（可能与其他节点重叠）
+    uint32_t last = no_record;
+    for (uint32_t i = 0; i < records.size(); i++) {
+        const NodeRecord& record = records[i];
+        if (!record.finished) {
+            continue;
+        }
+        stats[record.category].nodes++;
+        stats[record.category].busy_ticks += record.end - record.start;
+        if (last == no_record || record.end >= records[last].end) {
+            last = i;
+        }
+    }
+
+    // 回溯关键路径
+    vector<pair<Tick, uint32_t>> path_nodes;
+    Tick path_start = 0;
+    Tick path_end = 0;
+    if (last != no_record) {
+        path_end = records[last].end;
+        for (uint32_t i = last; i != no_record; i = records[i].trigger) {
+            const NodeRecord& record = records[i];
+            Tick ticks = record.end - record.start;
+            stats[record.category].critical_nodes++;
+            stats[record.category].critical_ticks += ticks;
+            path_nodes.emplace_back(ticks, i);
+            path_start = record.start;
+        }
+    }
+
+    json j;
+    j["sys"] = sys_id;
+    j["finish_tick"] = path_end;
+    j["critical_path"] = {{"start_tick", path_start},
+                          {"ticks", path_end - path_start},
+                          {"nodes", path_nodes.size()}};
+
+    json category_list = json::array();
+    for (uint32_t i = 0; i < categories.size(); i++) {
+        const NodeCategory& category = categories[i];
+        json entry = {{"kind", category.kind},
+                      {"nodes", stats[i].nodes},
+                      {"busy_ticks", stats[i].busy_ticks},
+                      {"critical_path_nodes", stats[i].critical_nodes},
+                      {"exposed_ticks", stats[i].critical_ticks}};
+        if (!category.collective.empty()) {
+            entry["collective"] = category.collective;
+        }
+        if (!category.comm_group.empty()) {
+            entry["comm_group"] = category.comm_group;
+        }
+        if (!category.dims.empty()) {
+            entry["dims"] = category.dims;
+        }
+        category_list.push_back(std::move(entry));
+    }
+    j["categories"] = std::move(category_list);
+
+    // 关键路径上耗时最长的节点
+    constexpr size_t top_count = 10;
+    size_t count = min(top_count, path_nodes.size());
+    partial_sort(path_nodes.begin(), path_nodes.begin() + count,
+                 path_nodes.end(),
+                 [](const pair<Tick, uint32_t>& a,
+                    const pair<Tick, uint32_t>& b) {
+                     return a.first > b.first;
+                 });
+    json top_nodes = json::array();
+    for (size_t i = 0; i < count; i++) {
+        const NodeRecord& record = records[path_nodes[i].second];
+        top_nodes.push_back({{"node_id", record.node_id},
+                             {"start_tick", record.start},
+                             {"ticks", path_nodes[i].first},
+                             {"category", record.category}});
+    }
+    j["top_critical_nodes"] = std::move(top_nodes);
+
+    return j.dump();
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __CRITICAL_PATH_TRACKER_HH__
+#define __CRITICAL_PATH_TRACKER_HH__
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "astra-sim/system/Common.hh"
+
+namespace AstraSim {
+
+/**
+ * @brief 节点的归因类别：节点类型，以及集合通信的类型、通信组和维度
+ */
+struct NodeCategory {
+    std::string kind;        ///< compute_gpu / compute_cpu / memory / collective / send / recv / invalid
+    std::string collective;  ///< 集合通信类型（例如 ALL_REDUCE），其余节点为空
+    std::string comm_group;  ///< 通信组名称（pg_name），未指定时为 "default"
+    std::string dims;        ///< 涉及的维度（例如 "0,1"），未指定时为 "all"
+};
+
+/**
+ * @class CriticalPathTracker
+ * @brief 记录每个 ET 节点的开始/结束时刻，并在结束时计算关键路径。
+ *
+ * 一个节点总是在另一个节点完成时被调度（依赖被释放或硬件资源被释放），
+ * 因此只需为每个节点记录“触发者”——调度它之前最后完成的节点。
+ * 沿触发者链从最后完成的节点回溯即得到关键路径，路径上各节点的
+ * 执行时间之和等于总时长，可以直接归因到集合通信类型、通信组和维度。
+ * 每个节点只占用一条定长记录，不需要保存 ET 依赖边。
+ */
+class CriticalPathTracker {
+  public:
+    CriticalPathTracker();
+
+    /**
+     * @brief 记录节点被调度
+     * @param node_id 节点 ID
+     * @param category 节点的归因类别
+     * @param tick 调度时刻
+     */
+    void node_issued(uint64_t node_id,
+                     const NodeCategory& category,
+                     Tick tick);
+
+    /**
+     * @brief 记录节点完成，之后调度的节点都以它为触发者
+     * @param node_id 节点 ID
+     * @param tick 完成时刻
+     */
+    void node_finished(uint64_t node_id, Tick tick);
+
+    /**
+     * @brief 计算关键路径，并生成 JSON 格式的报告
+     * @param sys_id NPU ID
+     * @return JSON 字符串
+     */
+    std::string report(int sys_id) const;
+
+  private:
+    static constexpr uint32_t no_record = UINT32_MAX;
+
+    struct NodeRecord {
+        uint64_t node_id;
+        Tick start;
+        Tick end;
+        uint32_t category;  ///< categories 中的下标
+        uint32_t trigger;   ///< 触发者在 records 中的下标，no_record 表示无
+        bool finished;
+    };
+
+    uint32_t get_category_index(const NodeCategory& category);
+
+    std::vector<NodeRecord> records;
+    std::unordered_map<uint64_t, uint32_t> record_index;  ///< 节点 ID -> 记录下标
+    std::vector<NodeCategory> categories;
+    std::unordered_map<std::string, uint32_t> category_index;
+    uint32_t last_finished;  ///< 最近完成的节点的记录下标
+};
+
+}  // namespace AstraSim
+
+#endif /* __CRITICAL_PATH_TRACKER_HH__ */
@@ -0,0 +1,141 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/workload/GraphFeeder.hh"
+
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+using namespace AstraSim;
+using namespace Chakra;
+
+// ChakraGraphFeeder：直接转发给 Chakra::ETFeeder
+
+ChakraGraphFeeder::ChakraGraphFeeder(const string& filename)
+    : feeder(filename) {}
+
+void ChakraGraphFeeder::removeNode(uint64_t node_id) {
+    feeder.removeNode(node_id);
+}
+
+bool ChakraGraphFeeder::hasNodesToIssue() {
+    return feeder.hasNodesToIssue();
+}
+
+shared_ptr<ETFeederNode> ChakraGraphFeeder::getNextIssuableNode() {
+    return feeder.getNextIssuableNode();
+}
+
+void ChakraGraphFeeder::pushBackIssuableNode(uint64_t node_id) {
+    feeder.pushBackIssuableNode(node_id);
+}
+
+shared_ptr<ETFeederNode> ChakraGraphFeeder::lookupNode(uint64_t node_id) {
+    return feeder.lookupNode(node_id);
+}
+
+void ChakraGraphFeeder::freeChildrenNodes(uint64_t node_id) {
+    feeder.freeChildrenNodes(node_id);
+}
+
+// InMemoryGraphFeeder
+
+/**
+ * @brief 添加节点
+ * @param node Chakra 节点
+ */
+void InMemoryGraphFeeder::add_node(shared_ptr<ChakraProtoMsg::Node> node) {
+    uint64_t node_id = node->id();
+    nodes[node_id] = make_shared<ETFeederNode>(node);
+}
+
+/**
+ * @brief 建立父子关系，并把没有依赖的节点放入调度队列
+ */
+void InMemoryGraphFeeder::finalize() {
+    for (auto& entry : nodes) {
+        const shared_ptr<ETFeederNode>& node = entry.second;
+        const shared_ptr<ChakraProtoMsg::Node> proto = node->getChakraNode();
+        bool has_parent = false;
+        auto add_parent = [&](uint64_t parent_id) {
+            auto parent = nodes.find(parent_id);
+            if (parent == nodes.end()) {
+                return;
+            }
+            parent->second->addChild(node);
+            node->addDepUnresolvedParentID(parent_id);
+            has_parent = true;
+        };
+        for (int i = 0; i < proto->data_deps_size(); i++) {
+            add_parent(proto->data_deps(i));
+        }
+        for (int i = 0; i < proto->ctrl_deps_size(); i++) {
+            add_parent(proto->ctrl_deps(i));
+        }
+        if (!has_parent) {
+            dep_free_nodes.push(entry.first);
+            dep_free_node_ids.insert(entry.first);
+        }
+    }
+}
+
+void InMemoryGraphFeeder::removeNode(uint64_t node_id) {
+    nodes.erase(node_id);
+}
+
+bool InMemoryGraphFeeder::hasNodesToIssue() {
+    return !nodes.empty();
+}
+
+shared_ptr<ETFeederNode> InMemoryGraphFeeder::getNextIssuableNode() {
+    while (!dep_free_nodes.empty()) {
+        uint64_t node_id = dep_free_nodes.top();
+        dep_free_nodes.pop();
+        dep_free_node_ids.erase(node_id);
+        auto it = nodes.find(node_id);
+        if (it != nodes.end()) {
+            return it->second;
+        }
+    }
+    return nullptr;
+}
+
+void InMemoryGraphFeeder::pushBackIssuableNode(uint64_t node_id) {
+    if (dep_free_node_ids.insert(node_id).second) {
+        dep_free_nodes.push(node_id);
+    }
+}
+
+shared_ptr<ETFeederNode> InMemoryGraphFeeder::lookupNode(uint64_t node_id) {
+    auto it = nodes.find(node_id);
+    if (it == nodes.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+/**
+ * @brief 释放子节点对该节点的依赖，依赖全部解除的子节点进入调度队列
+ * @param node_id 已完成的节点 ID
+ */
+void InMemoryGraphFeeder::freeChildrenNodes(uint64_t node_id) {
+    auto it = nodes.find(node_id);
+    if (it == nodes.end()) {
+        return;
+    }
+    for (const auto& child : it->second->getChildren()) {
+        vector<uint64_t> parents = child->getDepUnresolvedParentIDs();
+        auto parent = find(parents.begin(), parents.end(), node_id);
+        if (parent == parents.end()) {
+            continue;
+        }
+        parents.erase(parent);
+        child->setDepUnresolvedParentIDs(parents);
+        if (parents.empty()) {
+            pushBackIssuableNode(child->id());
+        }
+    }
+}
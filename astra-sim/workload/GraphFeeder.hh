@@ -0,0 +1,113 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __GRAPH_FEEDER_HH__
+#define __GRAPH_FEEDER_HH__
+
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "extern/graph_frontend/chakra/src/feeder/et_feeder.h"  // Chakra ETFeeder 与 ETFeederNode
+
+namespace AstraSim {
+
+/**
+ * @class GraphFeeder
+ * @brief Workload 读取执行图的接口。
+ *
+ * 接口与 Chakra::ETFeeder 一致，Workload 可以透明地使用从 `.et` 文件
+ * 读取的图（ChakraGraphFeeder）或在内存中构造的图（InMemoryGraphFeeder）。
+ */
+class GraphFeeder {
+  public:
+    virtual ~GraphFeeder() = default;
+
+    /// 从图中移除已完成的节点
+    virtual void removeNode(uint64_t node_id) = 0;
+
+    /// 是否还有尚未完成的节点
+    virtual bool hasNodesToIssue() = 0;
+
+    /// 取出下一个无依赖的节点，没有时返回 nullptr
+    virtual std::shared_ptr<Chakra::ETFeederNode> getNextIssuableNode() = 0;
+
+    /// 将暂时无法调度的节点放回无依赖队列
+    virtual void pushBackIssuableNode(uint64_t node_id) = 0;
+
+    /// 按 ID 查找节点
+    virtual std::shared_ptr<Chakra::ETFeederNode> lookupNode(
+        uint64_t node_id) = 0;
+
+    /// 节点完成后释放其子节点的依赖
+    virtual void freeChildrenNodes(uint64_t node_id) = 0;
+};
+
+/**
+ * @class ChakraGraphFeeder
+ * @brief 从 Chakra `.et` 文件按窗口读取执行图。
+ */
+class ChakraGraphFeeder : public GraphFeeder {
+  public:
+    explicit ChakraGraphFeeder(const std::string& filename);
+
+    void removeNode(uint64_t node_id) override;
+    bool hasNodesToIssue() override;
+    std::shared_ptr<Chakra::ETFeederNode> getNextIssuableNode() override;
+    void pushBackIssuableNode(uint64_t node_id) override;
+    std::shared_ptr<Chakra::ETFeederNode> lookupNode(uint64_t node_id) override;
+    void freeChildrenNodes(uint64_t node_id) override;
+
+  private:
+    Chakra::ETFeeder feeder;
+};
+
+/**
+ * @class InMemoryGraphFeeder
+ * @brief 在内存中构造的执行图，不需要任何输入文件。
+ *
+ * 依赖处理与 Chakra::ETFeeder 相同：数据依赖与控制依赖都视为父节点，
+ * 无依赖节点按 ID 从小到大调度。所有节点添加完毕后调用 finalize()。
+ */
+class InMemoryGraphFeeder : public GraphFeeder {
+  public:
+    InMemoryGraphFeeder() = default;
+
+    /**
+     * @brief 添加节点，父节点可以在之后添加
+     * @param node Chakra 节点（ID、类型、依赖、属性）
+     */
+    void add_node(std::shared_ptr<ChakraProtoMsg::Node> node);
+
+    /**
+     * @brief 建立父子关系，并把没有依赖的节点放入调度队列
+     */
+    void finalize();
+
+    void removeNode(uint64_t node_id) override;
+    bool hasNodesToIssue() override;
+    std::shared_ptr<Chakra::ETFeederNode> getNextIssuableNode() override;
+    void pushBackIssuableNode(uint64_t node_id) override;
+    std::shared_ptr<Chakra::ETFeederNode> lookupNode(uint64_t node_id) override;
+    void freeChildrenNodes(uint64_t node_id) override;
+
+  private:
+    std::unordered_map<uint64_t, std::shared_ptr<Chakra::ETFeederNode>> nodes;
+
+    /// 无依赖节点的 ID，最小堆
+    std::priority_queue<uint64_t,
+                        std::vector<uint64_t>,
+                        std::greater<uint64_t>>
+        dep_free_nodes;
+    std::unordered_set<uint64_t> dep_free_node_ids;
+};
+
+}  // namespace AstraSim
+
+#endif /* __GRAPH_FEEDER_HH__ */
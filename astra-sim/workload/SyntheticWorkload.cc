@@ -0,0 +1,442 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/workload/SyntheticWorkload.hh"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include "astra-sim/system/CommunicatorGroup.hh"
+#include "astra-sim/system/Sys.hh"
+
+using namespace std;
+using namespace AstraSim;
+
+namespace {
+
+/**
+ * @brief 逐个构造 Chakra 节点，节点 ID 按创建顺序递增
+ */
+class GraphBuilder {
+  public:
+    explicit GraphBuilder(InMemoryGraphFeeder* feeder)
+        : feeder(feeder), next_id(0) {}
+
+    uint64_t compute(const string& name,
+                     uint64_t duration_us,
+                     const vector<uint64_t>& deps) {
+        auto node = new_node(name, ChakraProtoMsg::COMP_NODE, deps);
+        node->set_duration_micros(duration_us);
+        return add(node);
+    }
+
+    uint64_t collective(const string& name,
+                        ChakraProtoMsg::CollectiveCommType comm_type,
+                        uint64_t comm_size,
+                        const string& pg_name,
+                        const vector<uint64_t>& deps) {
+        auto node = new_node(name, ChakraProtoMsg::COMM_COLL_NODE, deps);
+        add_int64_attr(node, "comm_type", comm_type);
+        add_int64_attr(node, "comm_size", comm_size);
+        if (!pg_name.empty()) {
+            auto attr = node->add_attr();
+            attr->set_name("pg_name");
+            attr->set_string_val(pg_name);
+        }
+        return add(node);
+    }
+
+    uint64_t send(const string& name,
+                  int dst,
+                  int tag,
+                  uint64_t comm_size,
+                  const vector<uint64_t>& deps) {
+        auto node = new_node(name, ChakraProtoMsg::COMM_SEND_NODE, deps);
+        add_int32_attr(node, "comm_dst", dst);
+        add_int32_attr(node, "comm_tag", tag);
+        add_int64_attr(node, "comm_size", comm_size);
+        return add(node);
+    }
+
+    uint64_t recv(const string& name,
+                  int src,
+                  int tag,
+                  uint64_t comm_size,
+                  const vector<uint64_t>& deps) {
+        auto node = new_node(name, ChakraProtoMsg::COMM_RECV_NODE, deps);
+        add_int32_attr(node, "comm_src", src);
+        add_int32_attr(node, "comm_tag", tag);
+        add_int64_attr(node, "comm_size", comm_size);
+        return add(node);
+    }
+
+    // 迭代结束节点（optimizer step），供稳态检测识别迭代边界
+    uint64_t iteration_end(uint64_t duration_us,
+                           uint64_t num_iterations,
+                           const vector<uint64_t>& deps) {
+        auto node =
+            new_node("optimizer_step", ChakraProtoMsg::COMP_NODE, deps);
+        node->set_duration_micros(duration_us);
+        auto attr = node->add_attr();
+        attr->set_name("is_iteration_end");
+        attr->set_bool_val(true);
+        add_int64_attr(node, "num_iterations", num_iterations);
+        return add(node);
+    }
+
+  private:
+    shared_ptr<ChakraProtoMsg::Node> new_node(const string& name,
+                                              ChakraProtoMsg::NodeType type,
+                                              const vector<uint64_t>& deps) {
+        auto node = make_shared<ChakraProtoMsg::Node>();
+        node->set_id(next_id++);
+        node->set_name(name);
+        node->set_type(type);
+        for (uint64_t dep : deps) {
+            node->add_data_deps(dep);
+        }
+        // 合成负载全部在 GPU 上执行
+        auto attr = node->add_attr();
+        attr->set_name("is_cpu_op");
+        attr->set_bool_val(false);
+        return node;
+    }
+
+    static void add_int64_attr(const shared_ptr<ChakraProtoMsg::Node>& node,
+                               const string& name,
+                               int64_t value) {
+        auto attr = node->add_attr();
+        attr->set_name(name);
+        attr->set_int64_val(value);
+    }
+
+    static void add_int32_attr(const shared_ptr<ChakraProtoMsg::Node>& node,
+                               const string& name,
+                               int32_t value) {
+        auto attr = node->add_attr();
+        attr->set_name(name);
+        attr->set_int32_val(value);
+    }
+
+    uint64_t add(const shared_ptr<ChakraProtoMsg::Node>& node) {
+        feeder->add_node(node);
+        return node->id();
+    }
+
+    InMemoryGraphFeeder* feeder;
+    uint64_t next_id;
+};
+
+/**
+ * @brief 解析非负整数参数
+ */
+uint64_t parse_count(const string& key, const string& value) {
+    size_t pos = 0;
+    uint64_t result = 0;
+    try {
+        result = stoull(value, &pos);
+    } catch (const exception&) {
+        pos = 0;
+    }
+    if (pos == 0 || pos != value.size()) {
+        Sys::sys_panic("synthetic workload: invalid value '" + value +
+                       "' for " + key);
+    }
+    return result;
+}
+
+}  // namespace
+
+/**
+ * @brief 解析 `<pattern>[,key=value...]` 形式的生成参数
+ */
+SyntheticWorkload::SyntheticWorkload(const string& spec, int npus_count)
+    : pattern(Pattern::DataParallel),
+      npus_count(npus_count),
+      iterations(1),
+      layers(8),
+      compute_us(100),
+      size(1048576),
+      tp(8),
+      ep(npus_count),
+      pp(npus_count),
+      microbatches(4) {
+    stringstream ss(spec);
+    string token;
+    bool first = true;
+    while (getline(ss, token, ',')) {
+        size_t eq = token.find('=');
+        string key = token.substr(0, eq);
+        string value = eq == string::npos ? "" : token.substr(eq + 1);
+        // 第一项可以省略 "pattern="
+        if (first && eq == string::npos) {
+            value = key;
+            key = "pattern";
+        }
+        first = false;
+
+        if (key == "pattern") {
+            if (value == "dp" || value == "dp_allreduce") {
+                pattern = Pattern::DataParallel;
+            } else if (value == "tp_dp") {
+                pattern = Pattern::TensorDataParallel;
+            } else if (value == "moe") {
+                pattern = Pattern::MixtureOfExperts;
+            } else if (value == "pipeline") {
+                pattern = Pattern::Pipeline;
+            } else {
+                Sys::sys_panic("synthetic workload: unknown pattern '" +
+                               value + "'");
+            }
+        } else if (key == "iterations") {
+            iterations = parse_count(key, value);
+        } else if (key == "layers") {
+            layers = parse_count(key, value);
+        } else if (key == "compute_us") {
+            compute_us = parse_count(key, value);
+        } else if (key == "size") {
+            size = parse_count(key, value);
+        } else if (key == "tp") {
+            tp = static_cast<int>(parse_count(key, value));
+        } else if (key == "ep") {
+            ep = static_cast<int>(parse_count(key, value));
+        } else if (key == "pp") {
+            pp = static_cast<int>(parse_count(key, value));
+        } else if (key == "microbatches") {
+            microbatches = parse_count(key, value);
+        } else {
+            Sys::sys_panic("synthetic workload: unknown parameter '" + key +
+                           "'");
+        }
+    }
+
+    if (iterations == 0 || layers == 0 || microbatches == 0) {
+        Sys::sys_panic(
+            "synthetic workload: iterations, layers and microbatches must be "
+            "positive");
+    }
+    // 只检查当前模式用到的组大小
+    int group_size = 1;
+    if (pattern == Pattern::TensorDataParallel) {
+        group_size = tp;
+    } else if (pattern == Pattern::MixtureOfExperts) {
+        group_size = ep;
+    } else if (pattern == Pattern::Pipeline) {
+        group_size = pp;
+    }
+    if (group_size <= 0 || npus_count % group_size != 0) {
+        Sys::sys_panic("synthetic workload: group size " +
+                       to_string(group_size) +
+                       " does not divide the number of NPUs " +
+                       to_string(npus_count));
+    }
+}
+
+/**
+ * @brief 生成某个 NPU 的执行图
+ */
+InMemoryGraphFeeder* SyntheticWorkload::generate(int npu_id) const {
+    InMemoryGraphFeeder* feeder = new InMemoryGraphFeeder();
+    GraphBuilder builder(feeder);
+    const uint64_t step_us = max<uint64_t>(1, compute_us / 10);
+
+    // 每次迭代的第一个节点依赖上一次迭代的 optimizer step
+    vector<uint64_t> iteration_deps;
+    for (uint64_t it = 0; it < iterations; it++) {
+        vector<uint64_t> deps = iteration_deps;
+        vector<uint64_t> grads;
+        string suffix = "_" + to_string(it);
+
+        switch (pattern) {
+        case Pattern::DataParallel: {
+            for (uint64_t l = 0; l < layers; l++) {
+                deps = {builder.compute("fwd_" + to_string(l) + suffix,
+                                        compute_us, deps)};
+            }
+            for (uint64_t l = layers; l-- > 0;) {
+                uint64_t bwd = builder.compute(
+                    "bwd_" + to_string(l) + suffix, 2 * compute_us, deps);
+                deps = {bwd};
+                grads.push_back(builder.collective(
+                    "grad_allreduce_" + to_string(l) + suffix,
+                    ChakraProtoMsg::ALL_REDUCE, size, "", {bwd}));
+            }
+            break;
+        }
+        case Pattern::TensorDataParallel: {
+            bool has_dp = npus_count / tp > 1;
+            for (uint64_t l = 0; l < layers; l++) {
+                uint64_t fwd = builder.compute(
+                    "fwd_" + to_string(l) + suffix, compute_us, deps);
+                deps = {fwd};
+                if (tp > 1) {
+                    deps = {builder.collective(
+                        "fwd_tp_allreduce_" + to_string(l) + suffix,
+                        ChakraProtoMsg::ALL_REDUCE, size, "tp", deps)};
+                }
+            }
+            for (uint64_t l = layers; l-- > 0;) {
+                uint64_t bwd = builder.compute(
+                    "bwd_" + to_string(l) + suffix, 2 * compute_us, deps);
+                deps = {bwd};
+                if (tp > 1) {
+                    deps = {builder.collective(
+                        "bwd_tp_allreduce_" + to_string(l) + suffix,
+                        ChakraProtoMsg::ALL_REDUCE, size, "tp", deps)};
+                }
+                // 参数按 TP 切分，每个 NPU 只同步自己的分片
+                if (has_dp) {
+                    grads.push_back(builder.collective(
+                        "grad_dp_allreduce_" + to_string(l) + suffix,
+                        ChakraProtoMsg::ALL_REDUCE, size / tp, "dp",
+                        {bwd}));
+                }
+            }
+            break;
+        }
+        case Pattern::MixtureOfExperts: {
+            string ep_group = ep < npus_count ? "ep" : "";
+            for (uint64_t l = 0; l < layers; l++) {
+                string layer = to_string(l) + suffix;
+                uint64_t attn =
+                    builder.compute("fwd_attn_" + layer, compute_us, deps);
+                uint64_t dispatch = builder.collective(
+                    "fwd_dispatch_" + layer, ChakraProtoMsg::ALL_TO_ALL, size,
+                    ep_group, {attn});
+                uint64_t expert = builder.compute("fwd_expert_" + layer,
+                                                  compute_us, {dispatch});
+                deps = {builder.collective("fwd_combine_" + layer,
+                                           ChakraProtoMsg::ALL_TO_ALL, size,
+                                           ep_group, {expert})};
+            }
+            for (uint64_t l = layers; l-- > 0;) {
+                string layer = to_string(l) + suffix;
+                uint64_t combine = builder.collective(
+                    "bwd_combine_" + layer, ChakraProtoMsg::ALL_TO_ALL, size,
+                    ep_group, deps);
+                uint64_t expert = builder.compute("bwd_expert_" + layer,
+                                                  2 * compute_us, {combine});
+                uint64_t dispatch = builder.collective(
+                    "bwd_dispatch_" + layer, ChakraProtoMsg::ALL_TO_ALL, size,
+                    ep_group, {expert});
+                uint64_t attn = builder.compute("bwd_attn_" + layer,
+                                                2 * compute_us, {dispatch});
+                deps = {attn};
+                // 非专家参数在所有 NPU 间同步
+                grads.push_back(builder.collective(
+                    "grad_allreduce_" + layer, ChakraProtoMsg::ALL_REDUCE,
+                    size, "", {attn}));
+            }
+            break;
+        }
+        case Pattern::Pipeline: {
+            // 连续的 npus_count / pp 个 NPU 组成一个 stage，stage 内做数据并行
+            int stage_size = npus_count / pp;
+            int stage = npu_id / stage_size;
+            int prev = npu_id - stage_size;
+            int next = npu_id + stage_size;
+            uint64_t stage_us =
+                compute_us * max<uint64_t>(1, layers / static_cast<uint64_t>(pp));
+            // 每次迭代使用不同的 tag，前向与反向的 tag 也互不重叠
+            int tag_base = static_cast<int>(it * 2 * microbatches);
+            int bwd_tag_base = tag_base + static_cast<int>(microbatches);
+            vector<uint64_t> sends;
+
+            for (uint64_t m = 0; m < microbatches; m++) {
+                string mb = to_string(m) + suffix;
+                vector<uint64_t> fwd_deps = deps;
+                if (stage > 0) {
+                    fwd_deps.push_back(builder.recv(
+                        "fwd_recv_" + mb, prev, tag_base + static_cast<int>(m),
+                        size, iteration_deps));
+                }
+                uint64_t fwd =
+                    builder.compute("fwd_" + mb, stage_us, fwd_deps);
+                deps = {fwd};
+                if (stage < pp - 1) {
+                    sends.push_back(builder.send(
+                        "fwd_send_" + mb, next, tag_base + static_cast<int>(m),
+                        size, {fwd}));
+                }
+            }
+            for (uint64_t m = 0; m < microbatches; m++) {
+                string mb = to_string(m) + suffix;
+                vector<uint64_t> bwd_deps = deps;
+                if (stage < pp - 1) {
+                    bwd_deps.push_back(builder.recv(
+                        "bwd_recv_" + mb, next,
+                        bwd_tag_base + static_cast<int>(m), size,
+                        iteration_deps));
+                }
+                uint64_t bwd =
+                    builder.compute("bwd_" + mb, 2 * stage_us, bwd_deps);
+                deps = {bwd};
+                if (stage > 0) {
+                    sends.push_back(builder.send(
+                        "bwd_send_" + mb, prev,
+                        bwd_tag_base + static_cast<int>(m), size, {bwd}));
+                }
+            }
+            grads = sends;
+            if (stage_size > 1) {
+                grads.push_back(builder.collective(
+                    "grad_dp_allreduce" + suffix, ChakraProtoMsg::ALL_REDUCE,
+                    size, "dp", deps));
+            }
+            break;
+        }
+        }
+
+        grads.insert(grads.end(), deps.begin(), deps.end());
+        iteration_deps = {builder.iteration_end(step_us, iterations, grads)};
+    }
+
+    feeder->finalize();
+    return feeder;
+}
+
+/**
+ * @brief 创建该 NPU 所属的通信组
+ */
+map<string, CommunicatorGroup*> SyntheticWorkload::create_comm_groups(
+    Sys* sys) const {
+    map<string, CommunicatorGroup*> groups;
+    auto add_group = [&](const string& name, int group_id, int first,
+                         int stride, int count) {
+        if (count <= 1) {
+            // 单个 NPU 的组不会产生通信节点
+            return;
+        }
+        vector<int> involved_NPUs;
+        for (int i = 0; i < count; i++) {
+            involved_NPUs.push_back(first + i * stride);
+        }
+        groups[name] = new CommunicatorGroup(group_id, involved_NPUs, sys);
+    };
+
+    int id = sys->id;
+    switch (pattern) {
+    case Pattern::DataParallel:
+        break;
+    case Pattern::TensorDataParallel:
+        // TP 组为连续的 tp 个 NPU，DP 组为各 TP 组中相同位置的 NPU
+        add_group("tp", 1, id - id % tp, 1, tp);
+        add_group("dp", 2, id % tp, tp, npus_count / tp);
+        break;
+    case Pattern::MixtureOfExperts:
+        // ep 等于 NPU 总数时使用默认的全局通信
+        if (ep < npus_count) {
+            add_group("ep", 1, id - id % ep, 1, ep);
+        }
+        break;
+    case Pattern::Pipeline: {
+        int stage_size = npus_count / pp;
+        add_group("dp", 1, id - id % stage_size, 1, stage_size);
+        break;
+    }
+    }
+    return groups;
+}
@@ -0,0 +1,85 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __SYNTHETIC_WORKLOAD_HH__
+#define __SYNTHETIC_WORKLOAD_HH__
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "astra-sim/workload/GraphFeeder.hh"
+
+namespace AstraSim {
+
+class Sys;
+class CommunicatorGroup;
+
+/**
+ * @class SyntheticWorkload
+ * @brief 在内存中生成常见训练图，用于在没有输入文件的情况下做大规模测试。
+ *
+ * 通过 workload 配置 `synthetic:<pattern>[,key=value...]` 选择，例如
+ * `synthetic:tp_dp,tp=8,layers=16,iterations=2`。支持的模式：
+ *  - `dp`：数据并行，反向每层之后对梯度做 AllReduce；
+ *  - `tp_dp`：张量并行 + 数据并行，前向/反向每层做 TP AllReduce，
+ *    梯度在 DP 组内 AllReduce；
+ *  - `moe`：每层两次 All-to-All（分发与合并）的专家并行；
+ *  - `pipeline`：GPipe 式流水线，相邻 stage 之间用 send/recv 传递激活与梯度。
+ *
+ * 参数（括号内为默认值）：iterations (1)、layers (8)、compute_us (100)、
+ * size (1048576 字节)、tp (8)、ep (NPU 总数)、pp (NPU 总数)、
+ * microbatches (4)。每次迭代以一个带 "is_iteration_end" 属性的
+ * optimizer_step 节点结束，可直接用于稳态检测。
+ */
+class SyntheticWorkload {
+  public:
+    /**
+     * @brief 解析生成参数
+     * @param spec `synthetic:` 之后的部分
+     * @param npus_count NPU 总数
+     */
+    SyntheticWorkload(const std::string& spec, int npus_count);
+
+    /**
+     * @brief 生成某个 NPU 的执行图
+     * @param npu_id NPU ID
+     * @return 已 finalize 的内存执行图，由调用者释放
+     */
+    InMemoryGraphFeeder* generate(int npu_id) const;
+
+    /**
+     * @brief 创建该 NPU 所属的通信组（组名 -> 通信组）
+     *
+     * 同一模式下互不相交的组使用相同的 ID：流 ID 只需在包含同一 NPU 的
+     * 组之间区分，这样 NPU 数量很大时组 ID 也不会溢出流 ID 空间。
+     *
+     * @param sys 该 NPU 的 Sys
+     */
+    std::map<std::string, CommunicatorGroup*> create_comm_groups(
+        Sys* sys) const;
+
+    /// workload 配置中表示合成负载的前缀
+    static constexpr const char* prefix = "synthetic:";
+
+  private:
+    enum class Pattern { DataParallel, TensorDataParallel, MixtureOfExperts,
+                         Pipeline };
+
+    Pattern pattern;
+    int npus_count;
+    uint64_t iterations;
+    uint64_t layers;
+    uint64_t compute_us;
+    uint64_t size;
+    int tp;
+    int ep;
+    int pp;
+    uint64_t microbatches;
+};
+
+}  // namespace AstraSim
+
+#endif /* __SYNTHETIC_WORKLOAD_HH__ */
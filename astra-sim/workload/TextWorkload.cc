@@ -0,0 +1,491 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/workload/TextWorkload.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include "astra-sim/system/Sys.hh"
+
+using namespace std;
+using namespace AstraSim;
+
+namespace {
+
+// 本次 pass 中尚未生成的节点
+constexpr int64_t no_node = -1;
+
+/**
+ * @brief 文本文件中的一层，以及最近一次 pass 中为它生成的节点
+ */
+struct Layer {
+    string name;
+    uint64_t fwd_comp_time;
+    string fwd_comm_type;
+    uint64_t fwd_comm_size;
+    uint64_t ig_comp_time;
+    string ig_comm_type;
+    uint64_t ig_comm_size;
+    uint64_t wg_comp_time;
+    string wg_comm_type;
+    uint64_t wg_comm_size;
+
+    int64_t fwd_comp = no_node;
+    int64_t fwd_comm = no_node;
+    int64_t ig_comp = no_node;
+    int64_t ig_comm = no_node;
+    int64_t wg_comp = no_node;
+    int64_t wg_comm = no_node;
+};
+
+/**
+ * @brief 按转换器的命名与属性构造节点，节点 ID 按创建顺序递增
+ */
+class TextGraphBuilder {
+  public:
+    explicit TextGraphBuilder(vector<shared_ptr<ChakraProtoMsg::Node>>* nodes)
+        : nodes(nodes), next_id(0) {}
+
+    int64_t compute(const Layer& layer,
+                    const string& phase,
+                    uint64_t comp_time,
+                    const vector<int64_t>& deps) {
+        auto node = new_node("COMP_NODE_" + layer.name + "_" + phase,
+                             ChakraProtoMsg::COMP_NODE, deps);
+        node->set_duration_micros(comp_time);
+        return add(node);
+    }
+
+    // 类型为 NONE 或大小为 0 时不生成节点，返回 parent 供后续节点依赖
+    int64_t comm(const string& layer_name,
+                 const string& comm_type,
+                 uint64_t comm_size,
+                 const vector<bool>& involved_dim,
+                 int64_t parent) {
+        if (comm_type == "NONE" || comm_size == 0) {
+            return parent;
+        }
+        auto node = new_node("COMM_COLL_NODE_" + layer_name + "_" + comm_type,
+                             ChakraProtoMsg::COMM_COLL_NODE, {parent});
+        auto attr = node->add_attr();
+        attr->set_name("comm_type");
+        attr->set_int64_val(to_comm_type(comm_type));
+        attr = node->add_attr();
+        attr->set_name("comm_size");
+        attr->set_int64_val(comm_size);
+        attr = node->add_attr();
+        attr->set_name("involved_dim");
+        for (bool involved : involved_dim) {
+            attr->mutable_bool_list()->add_values(involved);
+        }
+        return add(node);
+    }
+
+  private:
+    shared_ptr<ChakraProtoMsg::Node> new_node(const string& name,
+                                              ChakraProtoMsg::NodeType type,
+                                              const vector<int64_t>& deps) {
+        auto node = make_shared<ChakraProtoMsg::Node>();
+        node->set_id(next_id++);
+        node->set_name(name);
+        node->set_type(type);
+        // 大小为 0 的通信不生成节点，同一个父节点可能在 deps 中出现两次
+        for (size_t i = 0; i < deps.size(); i++) {
+            if (deps[i] != no_node &&
+                find(deps.begin(), deps.begin() + i, deps[i]) ==
+                    deps.begin() + i) {
+                node->add_data_deps(deps[i]);
+            }
+        }
+        auto attr = node->add_attr();
+        attr->set_name("is_cpu_op");
+        attr->set_bool_val(false);
+        return node;
+    }
+
+    static ChakraProtoMsg::CollectiveCommType to_comm_type(
+        const string& comm_type) {
+        if (comm_type == "ALLREDUCE") {
+            return ChakraProtoMsg::ALL_REDUCE;
+        } else if (comm_type == "ALLTOALL") {
+            return ChakraProtoMsg::ALL_TO_ALL;
+        } else if (comm_type == "ALLGATHER") {
+            return ChakraProtoMsg::ALL_GATHER;
+        } else if (comm_type == "REDUCESCATTER") {
+            return ChakraProtoMsg::REDUCE_SCATTER;
+        }
+        Sys::sys_panic("text workload: unknown communication type '" +
+                       comm_type + "'");
+        return ChakraProtoMsg::ALL_REDUCE;
+    }
+
+    int64_t add(const shared_ptr<ChakraProtoMsg::Node>& node) {
+        nodes->push_back(node);
+        return static_cast<int64_t>(node->id());
+    }
+
+    vector<shared_ptr<ChakraProtoMsg::Node>>* nodes;
+    uint64_t next_id;
+};
+
+/**
+ * @brief 解析非负整数
+ */
+uint64_t parse_count(const string& what, const string& value) {
+    size_t pos = 0;
+    uint64_t result = 0;
+    try {
+        result = stoull(value, &pos);
+    } catch (const exception&) {
+        pos = 0;
+    }
+    if (pos == 0 || pos != value.size()) {
+        Sys::sys_panic("text workload: invalid value '" + value + "' for " +
+                       what);
+    }
+    return result;
+}
+
+/**
+ * @brief 解析一层的描述
+ */
+Layer parse_layer(const string& line) {
+    stringstream ss(line);
+    vector<string> cols;
+    string col;
+    while (ss >> col) {
+        cols.push_back(col);
+    }
+    // 第 12 列（更新延迟）转换器同样不使用
+    if (cols.size() < 11) {
+        Sys::sys_panic("text workload: expected at least 11 columns in '" +
+                       line + "'");
+    }
+    Layer layer;
+    layer.name = cols[0];
+    layer.fwd_comp_time = parse_count(layer.name, cols[2]);
+    layer.fwd_comm_type = cols[3];
+    layer.fwd_comm_size = parse_count(layer.name, cols[4]);
+    layer.ig_comp_time = parse_count(layer.name, cols[5]);
+    layer.ig_comm_type = cols[6];
+    layer.ig_comm_size = parse_count(layer.name, cols[7]);
+    layer.wg_comp_time = parse_count(layer.name, cols[8]);
+    layer.wg_comm_type = cols[9];
+    layer.wg_comm_size = parse_count(layer.name, cols[10]);
+    return layer;
+}
+
+// MICRO：每层只有权重梯度通信，互不依赖
+void convert_micro(TextGraphBuilder& builder,
+                   vector<Layer>& layers,
+                   uint64_t passes,
+                   const vector<bool>& all_dims) {
+    for (uint64_t pass = 0; pass < passes; pass++) {
+        for (Layer& layer : layers) {
+            builder.comm(layer.name, layer.wg_comm_type, layer.wg_comm_size,
+                         all_dims, no_node);
+        }
+    }
+}
+
+// DATA：前向逐层计算，反向每层权重梯度计算之后做梯度通信；下一次 pass
+// 的前向等待该层的梯度通信
+void convert_data(TextGraphBuilder& builder,
+                  vector<Layer>& layers,
+                  uint64_t passes,
+                  const vector<bool>& all_dims) {
+    size_t n = layers.size();
+    for (uint64_t pass = 0; pass < passes; pass++) {
+        int64_t fwd = no_node;
+        for (size_t idx = 0; idx < n; idx++) {
+            Layer& layer = layers[idx];
+            fwd = builder.compute(
+                layer, "FWD", layer.fwd_comp_time,
+                {idx != 0 ? layers[idx - 1].fwd_comp : no_node,
+                 layer.wg_comm});
+            layer.fwd_comp = fwd;
+        }
+        for (size_t idx = 0; idx < n; idx++) {
+            Layer& layer = layers[n - 1 - idx];
+            int64_t wg = builder.compute(
+                layer, "BWD_WG", layer.wg_comp_time,
+                {idx == 0 ? fwd : layers[n - idx].ig_comp});
+            layer.wg_comm = builder.comm(layer.name, layer.wg_comm_type,
+                                         layer.wg_comm_size, all_dims, wg);
+            if (idx != n - 1) {
+                layer.ig_comp = builder.compute(layer, "BWD_IG",
+                                                layer.ig_comp_time, {wg});
+            }
+        }
+    }
+}
+
+// MODEL：每层前向与输入梯度计算之后做通信，权重梯度只在本地计算
+void convert_model(TextGraphBuilder& builder,
+                   vector<Layer>& layers,
+                   uint64_t passes,
+                   const vector<bool>& all_dims) {
+    size_t n = layers.size();
+    for (uint64_t pass = 0; pass < passes; pass++) {
+        int64_t fwd_comm = no_node;
+        for (size_t idx = 0; idx < n; idx++) {
+            Layer& layer = layers[idx];
+            int64_t fwd = builder.compute(
+                layer, "FWD", layer.fwd_comp_time,
+                {idx != 0 ? layers[idx - 1].fwd_comm : no_node,
+                 layer.wg_comp});
+            layer.fwd_comp = fwd;
+            fwd_comm = builder.comm(layer.name, layer.fwd_comm_type,
+                                    layer.fwd_comm_size, all_dims, fwd);
+            layer.fwd_comm = fwd_comm;
+        }
+        for (size_t idx = 0; idx < n; idx++) {
+            Layer& layer = layers[n - 1 - idx];
+            vector<int64_t> deps = {fwd_comm};
+            if (idx != 0) {
+                deps = {layers[n - idx].wg_comp, layers[n - idx].ig_comm};
+            }
+            int64_t ig =
+                builder.compute(layer, "BWD_IG", layer.ig_comp_time, deps);
+            if (idx != n - 1) {
+                layer.ig_comm = builder.comm(layer.name, layer.ig_comm_type,
+                                             layer.ig_comm_size, all_dims, ig);
+            }
+            layer.wg_comp =
+                builder.compute(layer, "BWD_WG", layer.wg_comp_time, {ig});
+        }
+    }
+}
+
+// HYBRID_DATA_MODEL / HYBRID_MODEL_DATA：前向与输入梯度通信在模型并行
+// 维度上，权重梯度通信在数据并行维度上
+void convert_hybrid(TextGraphBuilder& builder,
+                    vector<Layer>& layers,
+                    uint64_t passes,
+                    const vector<bool>& model_dims,
+                    const vector<bool>& data_dims) {
+    size_t n = layers.size();
+    for (uint64_t pass = 0; pass < passes; pass++) {
+        int64_t fwd_comm = no_node;
+        for (size_t idx = 0; idx < n; idx++) {
+            Layer& layer = layers[idx];
+            int64_t fwd = builder.compute(
+                layer, "FWD", layer.fwd_comp_time,
+                {layer.wg_comm,
+                 idx != 0 ? layers[idx - 1].fwd_comm : no_node});
+            layer.fwd_comp = fwd;
+            fwd_comm = builder.comm(layer.name, layer.fwd_comm_type,
+                                    layer.fwd_comm_size, model_dims, fwd);
+            layer.fwd_comm = fwd_comm;
+        }
+        for (size_t idx = 0; idx < n; idx++) {
+            Layer& layer = layers[n - 1 - idx];
+            int64_t ig = builder.compute(
+                layer, "BWD_IG", layer.ig_comp_time,
+                {idx == 0 ? fwd_comm : layers[n - idx].ig_comm});
+            if (idx != n - 1) {
+                layer.ig_comm = builder.comm(
+                    layer.name + "_IG_COMM_", layer.ig_comm_type,
+                    layer.ig_comm_size, model_dims, ig);
+            }
+            int64_t wg =
+                builder.compute(layer, "BWD_WG", layer.wg_comp_time, {ig});
+            layer.wg_comm = builder.comm(layer.name, layer.wg_comm_type,
+                                         layer.wg_comm_size, data_dims, wg);
+        }
+    }
+}
+
+// HYBRID_DLRM：第 0 层（embedding）前向之后做 All-to-All，第
+// last_bottom_layer 层（bottom MLP 的最后一层）之后的前向等待它；反向在
+// 回到 bottom MLP 时做 embedding 的输入梯度通信
+void convert_dlrm(TextGraphBuilder& builder,
+                  vector<Layer>& layers,
+                  uint64_t passes,
+                  const vector<bool>& all_dims,
+                  size_t last_bottom_layer) {
+    size_t n = layers.size();
+    for (uint64_t pass = 0; pass < passes; pass++) {
+        int64_t fwd = no_node;
+        for (size_t idx = 0; idx < n; idx++) {
+            Layer& layer = layers[idx];
+            vector<int64_t> deps = {
+                layer.wg_comm != no_node ? layer.wg_comm : layer.wg_comp,
+                idx != 0 ? layers[idx - 1].fwd_comp : no_node};
+            if (idx == last_bottom_layer) {
+                deps.push_back(layers[0].fwd_comm);
+            }
+            fwd = builder.compute(layer, "FWD", layer.fwd_comp_time, deps);
+            layer.fwd_comp = fwd;
+            if (layer.fwd_comm_type == "ALLTOALL") {
+                layer.fwd_comm = builder.comm(layer.name, layer.fwd_comm_type,
+                                              layer.fwd_comm_size, all_dims,
+                                              fwd);
+            }
+        }
+        for (size_t idx = 0; idx < n; idx++) {
+            Layer& layer = layers[n - 1 - idx];
+            vector<int64_t> deps = {fwd};
+            if (idx != 0) {
+                deps = {layers[n - idx].ig_comp, layers[n - idx - 1].ig_comm};
+            }
+            int64_t wg =
+                builder.compute(layer, "BWD_WG", layer.wg_comp_time, deps);
+            layer.wg_comp = wg;
+            layer.wg_comm = no_node;
+            if (layer.wg_comm_type != "NONE") {
+                layer.wg_comm = builder.comm(layer.name, layer.wg_comm_type,
+                                             layer.wg_comm_size, all_dims, wg);
+            }
+            int64_t ig = no_node;
+            if (idx != n - 1) {
+                ig = builder.compute(layer, "BWD_IG", layer.ig_comp_time,
+                                     {wg});
+                layer.ig_comp = ig;
+            }
+            if (n - idx - 1 == last_bottom_layer + 1) {
+                layers[0].ig_comm =
+                    builder.comm(layers[0].name, layers[0].ig_comm_type,
+                                 layers[0].ig_comm_size, all_dims, ig);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 读取文本负载并生成所有 NPU 共用的执行图
+ */
+vector<shared_ptr<ChakraProtoMsg::Node>> convert(const string& filename,
+                                                 uint64_t passes,
+                                                 int dims_count) {
+    ifstream file(filename);
+    if (!file) {
+        Sys::sys_panic("text workload: cannot open " + filename);
+    }
+    string line;
+    getline(file, line);
+    stringstream header(line);
+    string parallelism;
+    header >> parallelism;
+    getline(file, line);
+    stringstream count(line);
+    string layers_count;
+    count >> layers_count;
+    uint64_t num_layers = parse_count("the number of layers", layers_count);
+
+    vector<Layer> layers;
+    while (layers.size() < num_layers && getline(file, line)) {
+        if (line.find_first_not_of(" \t\r") == string::npos) {
+            continue;
+        }
+        layers.push_back(parse_layer(line));
+    }
+    if (layers.empty() || layers.size() != num_layers) {
+        Sys::sys_panic("text workload: " + filename + " declares " +
+                       to_string(num_layers) + " layers but describes " +
+                       to_string(layers.size()));
+    }
+
+    vector<shared_ptr<ChakraProtoMsg::Node>> nodes;
+    TextGraphBuilder builder(&nodes);
+    vector<bool> all_dims(dims_count, true);
+    if (parallelism == "MICRO") {
+        convert_micro(builder, layers, passes, all_dims);
+    } else if (parallelism == "DATA") {
+        convert_data(builder, layers, passes, all_dims);
+    } else if (parallelism == "MODEL") {
+        convert_model(builder, layers, passes, all_dims);
+    } else if (parallelism == "HYBRID_DATA_MODEL" ||
+               parallelism == "HYBRID_MODEL_DATA") {
+        if (dims_count < 2) {
+            Sys::sys_panic("text workload: " + parallelism +
+                           " needs at least two dimensions");
+        }
+        // 模型并行与数据并行分别使用第一维和其余维度（或相反）
+        vector<bool> first_dim(dims_count, false);
+        first_dim[0] = true;
+        vector<bool> other_dims(dims_count, true);
+        other_dims[0] = false;
+        if (parallelism == "HYBRID_DATA_MODEL") {
+            convert_hybrid(builder, layers, passes, first_dim, other_dims);
+        } else {
+            convert_hybrid(builder, layers, passes, other_dims, first_dim);
+        }
+    } else if (parallelism == "HYBRID_DLRM") {
+        string last_bottom_layer;
+        header >> last_bottom_layer;
+        uint64_t last_bottom = parse_count("the last bottom layer of "
+                                           "HYBRID_DLRM",
+                                           last_bottom_layer);
+        if (last_bottom + 1 >= num_layers) {
+            Sys::sys_panic("text workload: the last bottom layer of "
+                           "HYBRID_DLRM must be followed by a top layer");
+        }
+        // 第 0 层是 embedding，它的 All-to-All 在第 0 层前向之后才发出；
+        // last_bottom 为 0 时第 0 层前向会依赖上一次 pass 的 All-to-All
+        if (last_bottom == 0) {
+            Sys::sys_panic("text workload: the last bottom layer of "
+                           "HYBRID_DLRM must come after the embedding layer");
+        }
+        convert_dlrm(builder, layers, passes, all_dims, last_bottom);
+    } else {
+        Sys::sys_panic("text workload: unsupported parallelism '" +
+                       parallelism + "' in " + filename);
+    }
+    return nodes;
+}
+
+}  // namespace
+
+/**
+ * @brief 解析 `<文件>[,passes=N]`，同一配置只转换一次
+ */
+TextWorkload::TextWorkload(const string& spec, int dims_count) {
+    // 所有 NPU 使用相同的配置，第一个 NPU 转换后其余 NPU 直接复用
+    static map<pair<string, int>, shared_ptr<const Graph>> graphs;
+    auto cached = graphs.find(make_pair(spec, dims_count));
+    if (cached != graphs.end()) {
+        graph = cached->second;
+        return;
+    }
+
+    stringstream ss(spec);
+    string filename;
+    getline(ss, filename, ',');
+    uint64_t passes = 1;
+    string token;
+    while (getline(ss, token, ',')) {
+        size_t eq = token.find('=');
+        string key = token.substr(0, eq);
+        string value = eq == string::npos ? "" : token.substr(eq + 1);
+        if (key == "passes") {
+            passes = parse_count(key, value);
+        } else {
+            Sys::sys_panic("text workload: unknown parameter '" + key + "'");
+        }
+    }
+    if (passes == 0) {
+        Sys::sys_panic("text workload: passes must be positive");
+    }
+
+    graph = make_shared<const Graph>(convert(filename, passes, dims_count));
+    graphs[make_pair(spec, dims_count)] = graph;
+}
+
+/**
+ * @brief 用共享的节点构造一个 NPU 的执行图
+ */
+InMemoryGraphFeeder* TextWorkload::generate() const {
+    InMemoryGraphFeeder* feeder = new InMemoryGraphFeeder();
+    for (const auto& node : *graph) {
+        feeder->add_node(node);
+    }
+    feeder->finalize();
+    return feeder;
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __TEXT_WORKLOAD_HH__
+#define __TEXT_WORKLOAD_HH__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "astra-sim/workload/GraphFeeder.hh"
+
+namespace AstraSim {
+
+/**
+ * @class TextWorkload
+ * @brief 直接读取文本格式（按层描述）的负载，在内存中构造执行图。
+ *
+ * 通过 workload 配置 `text:<文件>[,passes=N]` 选择，例如
+ * `text:examples/text_converter/text_workloads/Resnet50_DataParallel.txt`，
+ * 不再需要先用 Chakra 的文本转换器为每个 NPU 生成 `.et` 文件。
+ * 文件格式见 examples/text_converter/text_workloads/README.md，支持的并行
+ * 方式与转换器相同：MICRO、DATA、MODEL、HYBRID_DATA_MODEL、
+ * HYBRID_MODEL_DATA 和 HYBRID_DLRM。
+ *
+ * 生成的依赖关系、节点名称和计算时间（duration_micros）与转换器的输出
+ * 一致；类型为 NONE 或大小为 0 的通信不生成节点，依赖它的节点改为依赖
+ * 对应的计算节点。所有 NPU 的执行图相同，因此同一文件只解析一次，
+ * 各 NPU 共享同一组 Chakra 节点，只各自维护调度状态。
+ */
+class TextWorkload {
+  public:
+    /**
+     * @brief 读取（或复用已读取的）文本负载
+     * @param spec `text:` 之后的部分
+     * @param dims_count 逻辑拓扑的维度数，用于通信节点的 involved_dim
+     */
+    TextWorkload(const std::string& spec, int dims_count);
+
+    /**
+     * @brief 生成一个 NPU 的执行图
+     * @return 已 finalize 的内存执行图，由调用者释放
+     */
+    InMemoryGraphFeeder* generate() const;
+
+    /// workload 配置中表示文本负载的前缀
+    static constexpr const char* prefix = "text:";
+
+  private:
+    using Graph = std::vector<std::shared_ptr<ChakraProtoMsg::Node>>;
+
+    std::shared_ptr<const Graph> graph;
+};
+
+}  // namespace AstraSim
+
+#endif /* __TEXT_WORKLOAD_HH__ */
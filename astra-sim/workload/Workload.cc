@@ -12,6 +12,8 @@ LICENSE file in the root directory of this source tree.
 #include "astra-sim/system/RecvPacketEventHandlerData.hh" // 接收数据包处理
 #include "astra-sim/system/SendPacketEventHandlerData.hh" // 发送数据包处理
 #include "astra-sim/system/WorkloadLayerHandlerData.hh" // 训练层任务数据处理
+#include "astra-sim/workload/SyntheticWorkload.hh" // 内存生成的合成负载
+#include "astra-sim/workload/TextWorkload.hh" // 直接读取的文本负载
 #include <json/json.hpp> // JSON 解析库
 
 #include <iostream> // 标准输入输出
@@ -23,6 +25,9 @@ using namespace AstraSim;
 using namespace Chakra;
 using json = nlohmann::json; // 使用 nlohmann::json 进行 JSON 解析
 
+// 热点路径（issue/call）中使用的 logger，只解析一次
+static LoggerHandle workload_logger("workload");
+
 typedef ChakraProtoMsg::NodeType ChakraNodeType; // 定义计算任务节点类型别名
 typedef ChakraProtoMsg::CollectiveCommType ChakraCollectiveCommType; // 定义集合通信类型别名
 
@@ -34,37 +39,51 @@ typedef ChakraProtoMsg::CollectiveCommType ChakraCollectiveCommType; // 定义
  * @param comm_group_filename 通信组配置文件
  */
 Workload::Workload(Sys* sys, string et_filename, string comm_group_filename) {
-
-    // 生成 workload 文件名，例如 "et_filename.sys_id.et"
-    string workload_filename = et_filename + "." + to_string(sys->id) + ".et";
-
-    // 检查 workload 文件是否存在
-    if (access(workload_filename.c_str(), R_OK) < 0) {
-        string error_msg;
-        if (errno == ENOENT) { // 文件不存在
-            error_msg =
-                "workload file: " + workload_filename + " does not exist";
-        } else if (errno == EACCES) { // 文件存在但无权限
-            error_msg = "workload file: " + workload_filename +
-                        " exists but is not readable";
-        } else { // 其他未知错误
-            error_msg =
-                "Unknown workload file: " + workload_filename + " access error";
-        }
-        LoggerFactory::get_logger("workload")->critical(error_msg);
-        exit(EXIT_FAILURE); // 终止程序
-    }
-
-    // 初始化 ETFeeder 解析任务文件
-    this->et_feeder = new ETFeeder(workload_filename);
     this->comm_group = nullptr;
     // TODO: parametrize the number of available hardware resources
     // TODO: 允许参数化硬件资源数量
     this->hw_resource = new HardwareResource(1);
     this->sys = sys;
 
-    // 初始化通信组
-    initialize_comm_group(comm_group_filename);
+    // "synthetic:<pattern>,..." 表示在内存中生成执行图，不读取任何文件
+    // "text:<file>,..." 表示直接读取文本格式的负载，不需要生成 .et 文件
+    const string synthetic_prefix = SyntheticWorkload::prefix;
+    const string text_prefix = TextWorkload::prefix;
+    if (et_filename.compare(0, synthetic_prefix.size(), synthetic_prefix) ==
+        0) {
+        SyntheticWorkload synthetic(
+            et_filename.substr(synthetic_prefix.size()), sys->total_nodes);
+        this->et_feeder = synthetic.generate(sys->id);
+        this->comm_groups = synthetic.create_comm_groups(sys);
+    } else if (et_filename.compare(0, text_prefix.size(), text_prefix) == 0) {
+        TextWorkload text(et_filename.substr(text_prefix.size()),
+                          sys->get_logical_topology(ComType::All_Reduce)
+                              ->get_num_of_dimensions());
+        this->et_feeder = text.generate();
+        // 与转换后的 .et 文件一样使用通信组配置文件
+        initialize_comm_group(comm_group_filename);
+    } else {
+        initialize_et_feeder(et_filename);
+        // 初始化通信组
+        initialize_comm_group(comm_group_filename);
+    }
+
+    // 稳态检测状态
+    this->completed_iterations = 0;
+    this->total_iterations = sys->total_iterations;
+    this->last_boundary_tick = 0;
+    this->last_boundary_tics_gpu_ops = 0;
+    this->steady = false;
+
+    // 开启关键路径报告时记录每个节点的开始/结束时刻
+    this->critical_path = nullptr;
+    if (!sys->critical_path_report_path.empty()) {
+        this->critical_path = new CriticalPathTracker();
+    }
+
+    // 检查点：只有开启检查点保存时才记录已完成的节点
+    this->record_finished_nodes = false;
+    this->in_flight_remote_mem_ops = 0;
 
     // 设定工作负载初始状态为未完成
     this->is_finished = false;
@@ -74,8 +93,9 @@ Workload::Workload(Sys* sys, string et_filename, string comm_group_filename) {
  * @brief 析构函数，释放 Workload 相关资源
  */
 Workload::~Workload() {
-    if (this->comm_group != nullptr) {
-        delete this->comm_group;
+    // comm_group 指向 comm_groups 中的某个通信组，不能重复释放
+    for (auto& group : comm_groups) {
+        delete group.second;
     }
     if (this->et_feeder != nullptr) {
         delete this->et_feeder;
@@ -83,11 +103,48 @@ Workload::~Workload() {
     if (this->hw_resource != nullptr) {
         delete this->hw_resource;
     }
+    if (this->critical_path != nullptr) {
+        delete this->critical_path;
+    }
+}
+
+/**
+ * @brief 打开当前 NPU 的 Chakra 执行图文件
+ *
+ * @param et_filename 执行图文件名前缀，实际文件为 "<et_filename>.<sys_id>.et"
+ */
+void Workload::initialize_et_feeder(string et_filename) {
+    // 生成 workload 文件名，例如 "et_filename.sys_id.et"
+    string workload_filename = et_filename + "." + to_string(sys->id) + ".et";
+
+    // 检查 workload 文件是否存在
+    if (access(workload_filename.c_str(), R_OK) < 0) {
+        string error_msg;
+        if (errno == ENOENT) { // 文件不存在
+            error_msg =
+                "workload file: " + workload_filename + " does not exist";
+        } else if (errno == EACCES) { // 文件存在但无权限
+            error_msg = "workload file: " + workload_filename +
+                        " exists but is not readable";
+        } else { // 其他未知错误
+            error_msg =
+                "Unknown workload file: " + workload_filename + " access error";
+        }
+        workload_logger->critical(error_msg);
+        exit(EXIT_FAILURE); // 终止程序
+    }
+
+    // 初始化 ETFeeder 解析任务文件
+    this->et_feeder = new ChakraGraphFeeder(workload_filename);
 }
 
 /**
  * @brief 初始化通信组
- * 
+ *
+ * JSON 文件的每个键是一个通信组名称（例如 "tp"、"dp" 或 "0"、"1"），
+ * 值为该组包含的 NPU ID 列表。当前 NPU 所属的每个组都会被创建，
+ * 因此一个 NPU 可以同时属于 TP、PP、DP、EP 等多个并发的通信组。
+ *
  * @param comm_group_filename 包含通信组信息的 JSON 文件路径
  */
 void Workload::initialize_comm_group(string comm_group_filename) {
@@ -103,8 +160,14 @@ void Workload::initialize_comm_group(string comm_group_filename) {
     inFile.open(comm_group_filename); // 打开通信组配置文件
     inFile >> j; // 读取 JSON 数据
 
-    // 遍历 JSON 数据，解析通信组信息
+    // 通信组 ID 由组名的排序位置决定（从 1 开始）：nlohmann::json 的对象
+    // 按键名排序存储，遍历顺序与文件中的书写顺序无关。所有 NPU 读取同一个
+    // 文件，因此同名通信组在每个 NPU 上的 ID 一致，流 ID 空间也互不重叠
+    // Note: All NPUs should create comm group with identical ids if
+    // they want to communicate with each other
+    int group_id = 0;
     for (json::iterator it = j.begin(); it != j.end(); ++it) {
+        group_id++;
         bool in_comm_group = false; // 标志当前 ID 是否属于该通信组
 
         // 检查当前系统 ID 是否属于该通信组
@@ -120,18 +183,81 @@ void Workload::initialize_comm_group(string comm_group_filename) {
             for (auto id : it.value()) {
                 involved_NPUs.push_back(id); // 记录该通信组的所有 NPU ID
             }
-            comm_group = new CommunicatorGroup(1, involved_NPUs, sys);
-            // 注意：所有 NPU 必须创建相同 ID 的通信组，否则无法通信
-            // Note: All NPUs should create comm group with identical ids if
-            // they want to communicate with each other
+            CommunicatorGroup* group =
+                new CommunicatorGroup(group_id, involved_NPUs, sys);
+            comm_groups[it.key()] = group;
+            // 未指定通信组的节点沿用按组名排序后最后一个匹配的通信组
+            // （与旧行为一致）
+            comm_group = group;
         }
     }
 }
 
+/**
+ * @brief 根据 ET 节点的 "pg_name" 属性选择通信组
+ *
+ * 属性可以是字符串或整数形式的组名。没有该属性的节点使用默认通信组
+ * `comm_group`；属性所指的组若不包含当前 NPU，则视为配置错误。
+ *
+ * @param node 通信任务节点
+ * @return 该节点使用的通信组，nullptr 表示使用全部 NPU
+ */
+CommunicatorGroup* Workload::get_comm_group(
+    shared_ptr<Chakra::ETFeederNode> node) {
+    if (!node->has_other_attr("pg_name")) {
+        return comm_group;
+    }
+
+    string pg_name = get_pg_name(node);
+    auto it = comm_groups.find(pg_name);
+    if (it == comm_groups.end()) {
+        workload_logger->critical(
+            "node {} (ET node {}) is not part of communicator group \"{}\"",
+            sys->id, node->id(), pg_name);
+        exit(EXIT_FAILURE);
+    }
+    return it->second;
+}
+
+/**
+ * @brief 读取节点的 "pg_name" 属性（字符串或整数）
+ *
+ * @param node 任务节点
+ * @return 通信组名称，节点没有该属性时返回空字符串
+ */
+string Workload::get_pg_name(shared_ptr<Chakra::ETFeederNode> node) {
+    if (!node->has_other_attr("pg_name")) {
+        return "";
+    }
+
+    const ChakraProtoMsg::AttributeProto& attr =
+        node->get_other_attr("pg_name");
+    string pg_name;
+    if (attr.has_string_val()) {
+        pg_name = attr.string_val();
+    } else if (attr.has_int64_val()) {
+        pg_name = to_string(attr.int64_val());
+    } else if (attr.has_uint64_val()) {
+        pg_name = to_string(attr.uint64_val());
+    } else if (attr.has_int32_val()) {
+        pg_name = to_string(attr.int32_val());
+    } else if (attr.has_uint32_val()) {
+        pg_name = to_string(attr.uint32_val());
+    } else {
+        cerr << "Expected string or integer pg_name but found another type."
+             << endl;
+        exit(EXIT_FAILURE);
+    }
+    return pg_name;
+}
+
 /**
  * @brief 处理无依赖的任务节点，并将可执行的任务调度出去
  */
 void Workload::issue_dep_free_nodes() {
+    if (is_finished) { // 已快进结束的 workload 不再调度新任务
+        return;
+    }
 
     std::queue<shared_ptr<Chakra::ETFeederNode>> push_back_queue; // 用于存储暂时无法执行的任务
     shared_ptr<Chakra::ETFeederNode> node = et_feeder->getNextIssuableNode(); // 获取下一个可执行的任务节点
@@ -160,7 +286,10 @@ void Workload::issue_dep_free_nodes() {
  * @param node 需要执行的任务节点
  */
 void Workload::issue(shared_ptr<Chakra::ETFeederNode> node) {
-    auto logger = LoggerFactory::get_logger("workload"); // 获取日志记录器
+    if (critical_path != nullptr) { // 记录节点开始时刻
+        critical_path->node_issued(node->id(), get_node_category(node),
+                                   Sys::boostedTick());
+    }
 
     if (sys->replay_only) { // 如果系统处于回放模式
         hw_resource->occupy(node); // 占用计算资源
@@ -169,11 +298,12 @@ void Workload::issue(shared_ptr<Chakra::ETFeederNode> node) {
         if ((node->type() == ChakraNodeType::MEM_LOAD_NODE) ||
             (node->type() == ChakraNodeType::MEM_STORE_NODE)) { // 处理内存加载或存储任务
             if (sys->trace_enabled) {  // 如果启用日志追踪，则记录调试信息
-                logger->debug("issue,sys->id={}, tick={}, node->id={}, "
-                              "node->name={}, node->type={}",
-                              sys->id, Sys::boostedTick(), node->id(),
-                              node->name(),
-                              static_cast<uint64_t>(node->type()));
+                ASTRA_LOG_DEBUG(workload_logger,
+                                "issue,sys->id={}, tick={}, node->id={}, "
+                                "node->name={}, node->type={}",
+                                sys->id, Sys::boostedTick(), node->id(),
+                                node->name(),
+                                static_cast<uint64_t>(node->type()));
             }
             issue_remote_mem(node); // 执行远程内存操作
         } else if (node->is_cpu_op() ||
@@ -183,11 +313,12 @@ void Workload::issue(shared_ptr<Chakra::ETFeederNode> node) {
                 skip_invalid(node); // 跳过无效任务
             } else { // 任务有效，执行计算
                 if (sys->trace_enabled) { // 记录调试信息
-                    logger->debug("issue,sys->id={}, tick={}, node->id={}, "
-                                  "node->name={}, node->type={}",
-                                  sys->id, Sys::boostedTick(), node->id(),
-                                  node->name(),
-                                  static_cast<uint64_t>(node->type()));
+                    ASTRA_LOG_DEBUG(workload_logger,
+                                    "issue,sys->id={}, tick={}, node->id={}, "
+                                    "node->name={}, node->type={}",
+                                    sys->id, Sys::boostedTick(), node->id(),
+                                    node->name(),
+                                    static_cast<uint64_t>(node->type()));
                 }
                 issue_comp(node); // 执行计算任务
             }
@@ -196,13 +327,12 @@ void Workload::issue(shared_ptr<Chakra::ETFeederNode> node) {
                     (node->type() == ChakraNodeType::COMM_SEND_NODE) ||
                     (node->type() == ChakraNodeType::COMM_RECV_NODE))) {  // 处理通信任务
             if (sys->trace_enabled) { // 记录调试信息
-                if (sys->trace_enabled) {
-                    logger->debug("issue,sys->id={}, tick={}, node->id={}, " //当前NPU的ID,获取当前仿真时间的时间戳(tick),任务节点ID
-                                  "node->name={}, node->type={}", //任务名称,任务的类型
-                                  sys->id, Sys::boostedTick(), node->id(),
-                                  node->name(),
-                                  static_cast<uint64_t>(node->type()));
-                }
+                ASTRA_LOG_DEBUG(workload_logger,
+                                "issue,sys->id={}, tick={}, node->id={}, " //当前NPU的ID,获取当前仿真时间的时间戳(tick),任务节点ID
+                                "node->name={}, node->type={}", //任务名称,任务的类型
+                                sys->id, Sys::boostedTick(), node->id(),
+                                node->name(),
+                                static_cast<uint64_t>(node->type()));
             }
             issue_comm(node); // 执行通信任务
         } else if (node->type() == ChakraNodeType::INVALID_NODE) { // 如果任务无效
@@ -252,7 +382,9 @@ void Workload::issue_remote_mem(shared_ptr<Chakra::ETFeederNode> node) {
     wlhd->node_id = node->id(); // 记录任务节点 ID
 
     // 远程内存访问，读取或写入指定张量大小的数据
+    in_flight_remote_mem_ops++;
     sys->remote_mem->issue(node->tensor_size(), wlhd);
+    Sys::backend_sequence++;
 }
 
 /**
@@ -348,6 +480,9 @@ void Workload::issue_comm(shared_ptr<Chakra::ETFeederNode> node) {
     // 处理集合通信 (Collective Communication) 任务
     if (!node->is_cpu_op() &&
         (node->type() == ChakraNodeType::COMM_COLL_NODE)) {
+        // 按节点的 pg_name 属性选择通信组，每个组有独立的流 ID 空间和
+        // CollectivePlan 缓存
+        CommunicatorGroup* group = get_comm_group(node);
 
         // 调用系统接口，生成 All-Reduce 集合通信任务
         if (node->comm_type() == ChakraCollectiveCommType::ALL_REDUCE) {
@@ -355,7 +490,7 @@ void Workload::issue_comm(shared_ptr<Chakra::ETFeederNode> node) {
             DataSet* fp =
                 sys->generate_all_reduce(node->comm_size(), // 通信数据大小
                                          involved_dim, // 涉及的通信维度
-                                         comm_group, // 通信组
+                                         group, // 通信组
                                          node->comm_priority()); // 任务的通信优先级
             // 记录集合通信节点 ID 对应的任务 ID
             collective_comm_node_id_map[fp->my_id] = node->id();
@@ -369,7 +504,7 @@ void Workload::issue_comm(shared_ptr<Chakra::ETFeederNode> node) {
             // 调用系统接口，生成 All-to-All 集合通信任务
             DataSet* fp =
                 sys->generate_all_to_all(node->comm_size(), involved_dim,
-                                         comm_group, node->comm_priority());
+                                         group, node->comm_priority());
             // 记录任务 ID 映射
             collective_comm_node_id_map[fp->my_id] = node->id();
             // 存储任务 DataSet 结构
@@ -381,7 +516,7 @@ void Workload::issue_comm(shared_ptr<Chakra::ETFeederNode> node) {
         } else if (node->comm_type() == ChakraCollectiveCommType::ALL_GATHER) {
             DataSet* fp =
                 sys->generate_all_gather(node->comm_size(), involved_dim,
-                                         comm_group, node->comm_priority());
+                                         group, node->comm_priority());
 
              // 记录任务 ID 映射
              collective_comm_node_id_map[fp->my_id] = node->id();
@@ -396,7 +531,7 @@ void Workload::issue_comm(shared_ptr<Chakra::ETFeederNode> node) {
             // 调用系统接口，生成 Reduce-Scatter 集合通信任务
             DataSet* fp =
                 sys->generate_reduce_scatter(node->comm_size(), involved_dim,
-                                             comm_group, node->comm_priority());
+                                             group, node->comm_priority());
 
              // 记录任务 ID 映射
              collective_comm_node_id_map[fp->my_id] = node->id();
@@ -488,16 +623,21 @@ void Workload::issue_comm(shared_ptr<Chakra::ETFeederNode> node) {
             rcehd); // 事件处理数据                            
     } else {
         // 处理未知的通信类型，记录错误并终止程序
-        LoggerFactory::get_logger("workload") // 获取 "workload" 相关的日志记录器
-            ->critical("Unknown communication node type"); // 记录关键错误信息
+        workload_logger->critical("Unknown communication node type"); // 记录关键错误信息
         exit(EXIT_FAILURE);
     }
 }
 
 // 释放无效节点，移除其子节点及自身
 void Workload::skip_invalid(shared_ptr<Chakra::ETFeederNode> node) {
+    if (critical_path != nullptr) {
+        critical_path->node_finished(node->id(), Sys::boostedTick());
+    }
     et_feeder->freeChildrenNodes(node->id()); // 释放当前节点的所有子节点
     et_feeder->removeNode(node->id()); // 从 ETFeeder 中移除当前节点
+    if (record_finished_nodes) {
+        finished_node_ids.push_back(node->id());
+    }
 }
 
 // 事件回调函数，处理计算任务或通信任务的完成事件
@@ -515,14 +655,22 @@ void Workload::call(EventType event, CallData* data) {
 
         // 如果启用了 trace 记录，则记录调试信息
         if (sys->trace_enabled) {
-            LoggerFactory::get_logger("workload")
-                ->debug("callback,sys->id={}, tick={}, node->id={}, "
-                        "node->name={}, node->type={}",
-                        sys->id, Sys::boostedTick(), node->id(), node->name(),
-                        static_cast<uint64_t>(node->type()));
+            ASTRA_LOG_DEBUG(workload_logger,
+                            "callback,sys->id={}, tick={}, node->id={}, "
+                            "node->name={}, node->type={}",
+                            sys->id, Sys::boostedTick(), node->id(),
+                            node->name(), static_cast<uint64_t>(node->type()));
         }
 
         hw_resource->release(node); // 释放该节点占用的硬件资源
+        if (critical_path != nullptr) { // 记录节点结束时刻
+            critical_path->node_finished(node_id, Sys::boostedTick());
+        }
+
+        // 迭代边界：记录迭代时长，所有 NPU 都进入稳态后快进
+        if (sys->steady_state_iterations > 0 && is_iteration_boundary(node)) {
+            finish_iteration(node);
+        }
 
         et_feeder->freeChildrenNodes(node_id); // 释放该节点的子节点
 
@@ -535,6 +683,9 @@ void Workload::call(EventType event, CallData* data) {
         delete collective_comm_wrapper_map[int_data->data];
         collective_comm_wrapper_map.erase(int_data->data);
         et_feeder->removeNode(node_id); // 从 ETFeeder 中移除该任务节点
+        if (record_finished_nodes) {
+            finished_node_ids.push_back(node_id);
+        }
 
     } else { // 处理非集合通信任务的回调
         if (data == nullptr) { // 如果 data 为空，说明没有具体的任务数据
@@ -546,32 +697,56 @@ void Workload::call(EventType event, CallData* data) {
 
             // 如果启用了 trace 记录，则记录调试信息
             if (sys->trace_enabled) {
-                LoggerFactory::get_logger("workload")
-                    ->debug("callback,sys->id={}, tick={}, node->id={}, "
-                            "node->name={}, node->type={}",
-                            sys->id, Sys::boostedTick(), node->id(),
-                            node->name(), static_cast<uint64_t>(node->type()));
+                ASTRA_LOG_DEBUG(
+                    workload_logger,
+                    "callback,sys->id={}, tick={}, node->id={}, "
+                    "node->name={}, node->type={}",
+                    sys->id, Sys::boostedTick(), node->id(), node->name(),
+                    static_cast<uint64_t>(node->type()));
             }
 
             hw_resource->release(node);
+            if (!sys->replay_only &&
+                (node->type() == ChakraNodeType::MEM_LOAD_NODE ||
+                 node->type() == ChakraNodeType::MEM_STORE_NODE)) {
+                // 远程内存的完成回调不经过 Sys::handleEvent
+                Sys::backend_sequence++;
+                in_flight_remote_mem_ops--;
+            }
+            if (critical_path != nullptr) {
+                critical_path->node_finished(node->id(), Sys::boostedTick());
+            }
+
+            if (sys->steady_state_iterations > 0 &&
+                is_iteration_boundary(node)) {
+                finish_iteration(node);
+            }
 
             et_feeder->freeChildrenNodes(node->id());
 
             issue_dep_free_nodes();
 
             et_feeder->removeNode(wlhd->node_id);
+            if (record_finished_nodes) {
+                finished_node_ids.push_back(wlhd->node_id);
+            }
             delete wlhd;
         }
     }
 
-    // 检查是否所有任务都已完成
-    if (!et_feeder->hasNodesToIssue() && // 没有可调度的任务
+    // 检查是否所有任务都已完成（快进结束时已经报告过）
+    if (!is_finished && // 未被快进结束
+        !et_feeder->hasNodesToIssue() && // 没有可调度的任务
         (hw_resource->num_in_flight_cpu_ops == 0) && // 无 CPU 计算任务
         (hw_resource->num_in_flight_gpu_comp_ops == 0) && // 无 GPU 计算任务
         (hw_resource->num_in_flight_gpu_comm_ops == 0)) { // 无 GPU 通信任务
         report(); // 记录任务完成情况
         sys->comm_NI->sim_notify_finished(); // 通知系统所有任务已完成
         is_finished = true; // 标记 Workload 任务已完成
+        sys->notify_workload_finished(); // 所有 workload 完成后导出利用率热力图
+        if (sys->steady_state_iterations > 0) {
+            Sys::try_fast_forward(); // 其余 NPU 可能只在等待该 NPU
+        }
     }
 }
 
@@ -580,15 +755,265 @@ void Workload::fire() {
     call(EventType::General, NULL); // 触发通用事件处理，不附带数据
 }
 
+// 判断节点是否标记一次迭代的结束
+bool Workload::is_iteration_boundary(shared_ptr<Chakra::ETFeederNode> node) {
+    if (node->has_other_attr("is_iteration_end")) {
+        const ChakraProtoMsg::AttributeProto& attr =
+            node->get_other_attr("is_iteration_end");
+        if (attr.has_bool_val()) {
+            return attr.bool_val();
+        } else if (attr.has_int64_val()) {
+            return attr.int64_val() != 0;
+        } else if (attr.has_int32_val()) {
+            return attr.int32_val() != 0;
+        }
+    }
+    return !sys->iteration_marker.empty() &&
+           node->name() == sys->iteration_marker;
+}
+
+// 在迭代边界处记录迭代时长，并判断最近 K 次迭代是否一致
+void Workload::finish_iteration(shared_ptr<Chakra::ETFeederNode> node) {
+    Tick now = Sys::boostedTick();
+    Tick duration = now - last_boundary_tick;
+    // 与 report() 相同：暴露通信时间 = 迭代时长 - GPU 计算时间
+    uint64_t gpu_ops = hw_resource->tics_gpu_ops - last_boundary_tics_gpu_ops;
+    Tick exposed_comm = duration > gpu_ops ? duration - gpu_ops : 0;
+
+    completed_iterations++;
+    last_boundary_tick = now;
+    last_boundary_tics_gpu_ops = hw_resource->tics_gpu_ops;
+    if (total_iterations == 0 && node->has_other_attr("num_iterations")) {
+        const ChakraProtoMsg::AttributeProto& attr =
+            node->get_other_attr("num_iterations");
+        if (attr.has_int64_val()) {
+            total_iterations = attr.int64_val();
+        } else if (attr.has_uint64_val()) {
+            total_iterations = attr.uint64_val();
+        } else if (attr.has_int32_val()) {
+            total_iterations = attr.int32_val();
+        }
+    }
+
+    // 只保留最近 K 次迭代
+    recent_iteration_ticks.push_back(duration);
+    recent_exposed_comm_ticks.push_back(exposed_comm);
+    if (recent_iteration_ticks.size() >
+        static_cast<size_t>(sys->steady_state_iterations)) {
+        recent_iteration_ticks.pop_front();
+        recent_exposed_comm_ticks.pop_front();
+    }
+
+    if (sys->trace_enabled) {
+        ASTRA_LOG_DEBUG(workload_logger,
+                        "iteration,sys->id={}, tick={}, iteration={}, "
+                        "duration={}, exposed_comm={}",
+                        sys->id, now, completed_iterations, duration,
+                        exposed_comm);
+    }
+
+    bool was_steady = steady;
+    steady = false;
+    if (recent_iteration_ticks.size() ==
+        static_cast<size_t>(sys->steady_state_iterations)) {
+        Tick min_ticks = recent_iteration_ticks.front();
+        Tick max_ticks = recent_iteration_ticks.front();
+        double sum = 0;
+        for (auto ticks : recent_iteration_ticks) {
+            min_ticks = min(min_ticks, ticks);
+            max_ticks = max(max_ticks, ticks);
+            sum += ticks;
+        }
+        double mean = sum / recent_iteration_ticks.size();
+        steady = (max_ticks - min_ticks) <= sys->steady_state_tolerance * mean;
+    }
+    if (steady && !was_steady) {
+        workload_logger->info(
+            "sys[{}] reached steady state after {} iterations", sys->id,
+            completed_iterations);
+    }
+
+    if (is_steady()) {
+        Sys::try_fast_forward();
+    }
+}
+
+// 已进入稳态，且迭代总数已知、仍有剩余迭代可以外推
+bool Workload::is_steady() const {
+    return steady && total_iterations > completed_iterations;
+}
+
+// 停止模拟并外推剩余迭代
+void Workload::fast_forward() {
+    double mean_iteration = 0;
+    double mean_exposed_comm = 0;
+    for (size_t i = 0; i < recent_iteration_ticks.size(); i++) {
+        mean_iteration += recent_iteration_ticks[i];
+        mean_exposed_comm += recent_exposed_comm_ticks[i];
+    }
+    mean_iteration /= recent_iteration_ticks.size();
+    mean_exposed_comm /= recent_exposed_comm_ticks.size();
+
+    // 预测值从最后一个迭代边界开始外推
+    uint64_t remaining = total_iterations - completed_iterations;
+    Tick projected_ticks = last_boundary_tick +
+                           static_cast<Tick>(remaining * mean_iteration);
+    Tick boundary_exposed_comm =
+        last_boundary_tick > last_boundary_tics_gpu_ops
+            ? last_boundary_tick - last_boundary_tics_gpu_ops
+            : 0;
+    Tick projected_exposed_comm =
+        boundary_exposed_comm +
+        static_cast<Tick>(remaining * mean_exposed_comm);
+
+    Tick curr_tick = Sys::boostedTick();
+    workload_logger->info(
+        "sys[{}] fast-forwarded after {} of {} iterations: simulated "
+        "{} cycles, exposed communication {} cycles; projected {} "
+        "cycles, exposed communication {} cycles.",
+        sys->id, completed_iterations, total_iterations, curr_tick,
+        curr_tick - hw_resource->tics_gpu_ops, projected_ticks,
+        projected_exposed_comm);
+
+    finish_critical_path();
+    is_finished = true;
+    sys->comm_NI->sim_notify_finished();
+    sys->notify_workload_finished();
+}
+
+// 判断是否没有进行中的通信任务与远程内存访问（接收任务由网络后端的回调
+// 跟踪器判断）
+bool Workload::is_quiescent() const {
+    return collective_comm_wrapper_map.empty() &&
+           (hw_resource->num_in_flight_gpu_comm_ops == 0) &&
+           (in_flight_remote_mem_ops == 0);
+}
+
+// 从检查点恢复 ET 图的执行进度
+void Workload::restore(const unordered_set<uint64_t>& finished_nodes,
+                       const vector<pair<uint64_t, Tick>>& in_flight_nodes) {
+    unordered_map<uint64_t, Tick> in_flight(in_flight_nodes.begin(),
+                                            in_flight_nodes.end());
+    vector<shared_ptr<Chakra::ETFeederNode>> push_back_nodes;
+    Tick now = Sys::boostedTick();
+    uint64_t replayed_nodes = 0;
+
+    // 已完成的节点只释放依赖而不模拟；释放后新变为无依赖的节点会被
+    // getNextIssuableNode() 继续返回，因此一次遍历即可按拓扑顺序回放
+    shared_ptr<Chakra::ETFeederNode> node = et_feeder->getNextIssuableNode();
+    while (node != nullptr) {
+        uint64_t node_id = node->id();
+        if (finished_nodes.count(node_id) != 0) {
+            et_feeder->freeChildrenNodes(node_id);
+            et_feeder->removeNode(node_id);
+            if (record_finished_nodes) {
+                finished_node_ids.push_back(node_id);
+            }
+            replayed_nodes++;
+        } else if (in_flight.count(node_id) != 0) {
+            // 进行中的计算任务：重新占用资源，在原完成时刻触发回调
+            Tick finish_tick = in_flight[node_id];
+            if (finish_tick < now) {
+                Sys::sys_panic("checkpoint: node " + to_string(node_id) +
+                               " finishes before the checkpoint tick");
+            }
+            hw_resource->occupy(node);
+            WorkloadLayerHandlerData* wlhd = new WorkloadLayerHandlerData;
+            wlhd->sys_id = sys->id;
+            wlhd->workload = this;
+            wlhd->node_id = node_id;
+            sys->register_event(this, EventType::General, wlhd,
+                                finish_tick - now);
+            in_flight.erase(node_id);
+        } else {
+            push_back_nodes.push_back(node);
+        }
+        node = et_feeder->getNextIssuableNode();
+    }
+    for (const auto& pending : push_back_nodes) {
+        et_feeder->pushBackIssuableNode(pending->id());
+    }
+
+    // 检查点中的节点必须全部被回放，否则说明 ET 文件与检查点不一致
+    if (replayed_nodes != finished_nodes.size() ||
+        !in_flight.empty()) {
+        Sys::sys_panic("checkpoint of sys[" + to_string(sys->id) +
+                       "] does not match workload " +
+                       "(unknown or unreachable node ids)");
+    }
+
+    if (!et_feeder->hasNodesToIssue() && in_flight_nodes.empty()) {
+        is_finished = true;
+    }
+}
+
 // 记录 Workload 执行的统计信息
 void Workload::report() {
     Tick curr_tick = Sys::boostedTick(); // 获取当前的仿真时间
     // 在模拟器中，时间通常不是连续的，而是 事件驱动的，boostedTick() 记录了到目前为止 仿真器运行的总周期数。
 
-    LoggerFactory::get_logger("workload")
-        ->info("sys[{}] finished, {} cycles, exposed communication {} cycles.",
-               sys->id, curr_tick, curr_tick - hw_resource->tics_gpu_ops);
+    workload_logger->info(
+        "sys[{}] finished, {} cycles, exposed communication {} cycles.",
+        sys->id, curr_tick, curr_tick - hw_resource->tics_gpu_ops);
     // 记录系统 ID，完成的总周期数，以及未被计算隐藏的通信时间
     // hw_resource->tics_gpu_ops 是 Workload 总 GPU 计算时间，即 GPU 真正执行计算任务的时间
     // curr_tick - hw_resource->tics_gpu_ops 计算的是 暴露的通信时间，即 通信操作无法隐藏在计算之下的时间。
+
+    finish_critical_path();
+}
+
+// 节点在关键路径报告中的归因类别
+NodeCategory Workload::get_node_category(
+    shared_ptr<Chakra::ETFeederNode> node) {
+    NodeCategory category;
+    if (node->is_cpu_op()) {
+        category.kind = "compute_cpu";
+    } else if (node->type() == ChakraNodeType::COMP_NODE) {
+        category.kind = "compute_gpu";
+    } else if (node->type() == ChakraNodeType::MEM_LOAD_NODE ||
+               node->type() == ChakraNodeType::MEM_STORE_NODE) {
+        category.kind = "memory";
+    } else if (node->type() == ChakraNodeType::COMM_COLL_NODE ||
+               node->type() == ChakraNodeType::COMM_SEND_NODE ||
+               node->type() == ChakraNodeType::COMM_RECV_NODE) {
+        if (node->type() == ChakraNodeType::COMM_COLL_NODE) {
+            category.kind = "collective";
+            category.collective =
+                ChakraProtoMsg::CollectiveCommType_Name(node->comm_type());
+        } else if (node->type() == ChakraNodeType::COMM_SEND_NODE) {
+            category.kind = "send";
+        } else {
+            category.kind = "recv";
+        }
+        category.comm_group = get_pg_name(node);
+        if (category.comm_group.empty()) {
+            category.comm_group = "default";
+        }
+        category.dims = "all";
+        if (node->has_other_attr("involved_dim") &&
+            node->get_other_attr("involved_dim").has_bool_list()) {
+            const ChakraProtoMsg::BoolList& bool_list =
+                node->get_other_attr("involved_dim").bool_list();
+            string dims;
+            for (int i = 0; i < bool_list.values_size(); ++i) {
+                if (bool_list.values(i)) {
+                    dims += (dims.empty() ? "" : ",") + to_string(i);
+                }
+            }
+            category.dims = dims;
+        }
+    } else {
+        category.kind = "invalid";
+    }
+    return category;
+}
+
+// 计算关键路径报告，并释放逐节点记录
+void Workload::finish_critical_path() {
+    if (critical_path == nullptr) {
+        return;
+    }
+    critical_path_report = critical_path->report(sys->id);
+    delete critical_path;
+    critical_path = nullptr;
 }
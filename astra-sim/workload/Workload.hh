@@ -6,13 +6,20 @@ LICENSE file in the root directory of this source tree.
 #ifndef __WORKLOAD_HH__
 #define __WORKLOAD_HH__
 
+#include <deque>  // 引入双端队列 std::deque
+#include <map>  // 引入有序映射 std::map
 #include <memory>  // 引入智能指针 std::shared_ptr
 #include <string>  // 引入字符串处理 std::string
 #include <unordered_map>  // 引入哈希映射 std::unordered_map
+#include <unordered_set>  // 引入哈希集合 std::unordered_set
+#include <utility>  // 引入 std::pair
+#include <vector>  // 引入动态数组 std::vector
 
 // 包含 Astra-Sim 相关头文件
 #include "astra-sim/system/Callable.hh"  // 继承自 Callable 类（事件回调机制）
 #include "astra-sim/system/CommunicatorGroup.hh"  // 处理通信组
+#include "astra-sim/workload/CriticalPathTracker.hh"  // 关键路径分析
+#include "astra-sim/workload/GraphFeeder.hh"  // 执行图读取接口（.et 文件或内存生成）
 #include "astra-sim/workload/HardwareResource.hh"  // 处理硬件资源管理
 #include "extern/graph_frontend/chakra/src/feeder/et_feeder.h"  // 任务调度器 ETFeeder
 
@@ -32,7 +39,9 @@ class Workload : public Callable {
      * @brief Workload 构造函数
      * 
      * @param sys 指向系统对象的指针
-     * @param et_filename 计算任务的输入文件名（execution trace 文件）
+     * @param et_filename 计算任务的输入文件名（execution trace 文件），
+     *        或 "synthetic:<pattern>,..." 表示在内存中生成合成负载，
+     *        或 "text:<file>,..." 表示直接读取文本格式的负载
      * @param comm_group_filename 通信组配置文件
      */
     Workload(Sys* sys,
@@ -45,6 +54,13 @@ class Workload : public Callable {
      */
     ~Workload();
 
+    /**
+     * @brief 打开当前 NPU 的 Chakra 执行图文件
+     *
+     * @param et_filename 执行图文件名前缀
+     */
+    void initialize_et_feeder(std::string et_filename);
+
     // communicator groups
     // ** 通信组初始化 **
     /**
@@ -54,6 +70,23 @@ class Workload : public Callable {
      */
     void initialize_comm_group(std::string comm_group_filename);
 
+    /**
+     * @brief 根据 ET 节点的 "pg_name" 属性选择该集合通信使用的通信组
+     *
+     * @param node 通信任务节点
+     * @return 通信组指针，nullptr 表示使用全部 NPU
+     */
+    CommunicatorGroup* get_comm_group(
+        std::shared_ptr<Chakra::ETFeederNode> node);
+
+    /**
+     * @brief 读取 ET 节点的 "pg_name" 属性
+     *
+     * @param node 任务节点
+     * @return 通信组名称，节点没有该属性时返回空字符串
+     */
+    static std::string get_pg_name(std::shared_ptr<Chakra::ETFeederNode> node);
+
     // ** 事件驱动模拟 **
     /**
      * @brief 处理无依赖的任务节点，并将可执行的任务调度出去
@@ -115,16 +148,79 @@ class Workload : public Callable {
      */
     void fire();
 
+    // ** 稳态检测与快进 **
+    /**
+     * @brief 判断节点是否标记一次迭代的结束
+     *
+     * 带有非零 "is_iteration_end" 属性的节点，或名称等于系统配置
+     * "iteration-marker" 的节点，都视为迭代边界。
+     *
+     * @param node 已完成的任务节点
+     */
+    bool is_iteration_boundary(std::shared_ptr<Chakra::ETFeederNode> node);
+
+    /**
+     * @brief 在迭代边界处记录本次迭代的时长与暴露通信时间，并判断是否进入稳态
+     *
+     * @param node 标记迭代结束的节点
+     */
+    void finish_iteration(std::shared_ptr<Chakra::ETFeederNode> node);
+
+    /**
+     * @brief 是否已进入稳态且可以外推剩余迭代
+     */
+    bool is_steady() const;
+
+    /**
+     * @brief 停止模拟，按稳态迭代时长外推剩余迭代并报告模拟值与预测值
+     */
+    void fast_forward();
+
+    // ** 检查点 **
+    /**
+     * @brief 判断该 Workload 是否没有进行中的通信任务与远程内存访问
+     *
+     * 只有进行中的计算任务（其完成时间已登记在 Sys 的事件队列中）
+     * 可以被写入检查点，集合通信、点对点发送与远程内存访问必须已经完成。
+     */
+    bool is_quiescent() const;
+
+    /**
+     * @brief 从检查点恢复 ET 图的执行进度
+     *
+     * 按依赖顺序回放已完成的节点（不做模拟），重新占用硬件资源并登记
+     * 进行中计算任务的完成事件。其余无依赖的节点留在 ETFeeder 中，
+     * 由调用者在恢复硬件资源统计后通过 issue_dep_free_nodes() 调度。
+     *
+     * @param finished_nodes 检查点时刻已经完成的节点 ID
+     * @param in_flight_nodes 检查点时刻正在执行的节点 ID 及其完成时刻
+     */
+    void restore(const std::unordered_set<uint64_t>& finished_nodes,
+                 const std::vector<std::pair<uint64_t, Tick>>& in_flight_nodes);
+
     // ** 统计与报告 **
     /**
      * @brief 记录 Workload 执行的统计信息，包括执行时间和通信时间
      */
     void report();
 
+    /**
+     * @brief 节点在关键路径报告中的归因类别（类型、集合通信类型、通信组、维度）
+     *
+     * @param node 任务节点
+     */
+    NodeCategory get_node_category(std::shared_ptr<Chakra::ETFeederNode> node);
+
+    /**
+     * @brief 结束时计算关键路径报告并释放逐节点记录
+     */
+    void finish_critical_path();
+
     // ** 成员变量 **
 
-    Chakra::ETFeeder* et_feeder;  // ETFeeder 任务调度器，用于管理任务队列
-    CommunicatorGroup* comm_group;  // 负责管理该 Workload 所属的通信组
+    GraphFeeder* et_feeder;  // 执行图调度器，用于管理任务队列（.et 文件或合成负载）
+    CommunicatorGroup* comm_group;  // 未指定 pg_name 的节点使用的默认通信组
+    std::map<std::string, CommunicatorGroup*> comm_groups;  // 该 NPU 所属的全部通信组（组名 -> 通信组）
     HardwareResource* hw_resource;  // 该 Workload 运行时使用的硬件资源
     Sys* sys;  // 指向系统管理对象的指针
 
@@ -135,6 +231,28 @@ class Workload : public Callable {
     std::unordered_map<int, DataSet*> collective_comm_wrapper_map;
     // 存储 DataSet 对象的指针，确保在任务完成后正确释放资源
 
+    std::vector<uint64_t> finished_node_ids;
+    // 已完成（已从 ETFeeder 移除）的节点 ID，按完成顺序记录，用于写入检查点
+
+    bool record_finished_nodes;
+    // 是否记录 finished_node_ids，仅在开启检查点保存时由前端打开
+
+    uint64_t in_flight_remote_mem_ops;
+    // 进行中的远程内存访问数，其完成回调不经过 Sys 的事件队列，无法写入检查点
+
+    // ** 稳态检测 **
+    uint64_t completed_iterations;  // 已完成的迭代数
+    uint64_t total_iterations;  // 迭代总数，0 表示未知
+    Tick last_boundary_tick;  // 上一个迭代边界的时刻
+    uint64_t last_boundary_tics_gpu_ops;  // 上一个迭代边界时累计的 GPU 计算时间
+    std::deque<Tick> recent_iteration_ticks;  // 最近 K 次迭代的时长
+    std::deque<Tick> recent_exposed_comm_ticks;  // 最近 K 次迭代的暴露通信时间
+    bool steady;  // 最近 K 次迭代时长是否在容差范围内一致
+
+    // ** 关键路径 **
+    CriticalPathTracker* critical_path;  // 逐节点开始/结束时刻记录，未开启时为 nullptr
+    std::string critical_path_report;  // 结束时生成的 JSON 报告
+
     bool is_finished;  // 标志 Workload 是否完成
 };
 
@@ -0,0 +1,92 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "BenchmarkHarness.hh"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace AstraSim;
+using namespace AstraSimBenchmark;
+
+// Heap accounting
+// -----------------------------------------------------------------------------
+
+namespace {
+
+std::atomic<uint64_t> allocation_count{0};
+std::atomic<uint64_t> allocated_bytes{0};
+
+void* counted_malloc(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    return counted_malloc(size);
+}
+
+void* operator new[](std::size_t size) {
+    return counted_malloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+AllocationStats AstraSimBenchmark::allocation_stats() {
+    return {allocation_count.load(std::memory_order_relaxed),
+            allocated_bytes.load(std::memory_order_relaxed)};
+}
+
+EventCounters::EventCounters(benchmark::State& state)
+    : state(state),
+      start(allocation_stats()),
+      paused_at({0, 0}),
+      excluded({0, 0}) {}
+
+void EventCounters::pause() {
+    paused_at = allocation_stats();
+}
+
+void EventCounters::resume() {
+    AllocationStats now = allocation_stats();
+    excluded.allocations += now.allocations - paused_at.allocations;
+    excluded.bytes += now.bytes - paused_at.bytes;
+}
+
+void EventCounters::finish(uint64_t events) {
+    AllocationStats end = allocation_stats();
+    end.allocations -= excluded.allocations;
+    end.bytes -= excluded.bytes;
+    double per_event = events == 0 ? 0.0 : 1.0 / events;
+    state.counters["events"] =
+        benchmark::Counter(static_cast<double>(events),
+                           benchmark::Counter::kIsRate);
+    state.counters["bytes_per_event"] =
+        static_cast<double>(end.bytes - start.bytes) * per_event;
+    state.counters["allocs_per_event"] =
+        static_cast<double>(end.allocations - start.allocations) * per_event;
+}
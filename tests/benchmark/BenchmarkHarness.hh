@@ -0,0 +1,45 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __BENCHMARK_HARNESS_HH__
+#define __BENCHMARK_HARNESS_HH__
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "tests/harness/LoopbackCluster.hh"
+
+namespace AstraSimBenchmark {
+
+// Process-wide heap allocation counters, updated by the replaced global
+// operator new.
+struct AllocationStats {
+    uint64_t allocations;
+    uint64_t bytes;
+};
+AllocationStats allocation_stats();
+
+// Reports events/sec and heap bytes/allocations per event for the timed
+// region of a benchmark. Construct before the benchmark loop, bracket
+// untimed work with pause()/resume() (next to State::PauseTiming()), then
+// call finish() with the total number of events processed.
+class EventCounters {
+  public:
+    explicit EventCounters(benchmark::State& state);
+    void pause();
+    void resume();
+    void finish(uint64_t events);
+
+  private:
+    benchmark::State& state;
+    AllocationStats start;
+    AllocationStats paused_at;
+    AllocationStats excluded;
+};
+
+}  // namespace AstraSimBenchmark
+
+#endif /* __BENCHMARK_HARNESS_HH__ */
@@ -0,0 +1,99 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "BenchmarkHarness.hh"
+#include "astra-sim/system/DataSet.hh"
+
+using namespace AstraSim;
+using namespace AstraSimBenchmark;
+using namespace AstraSimTest;
+
+namespace {
+
+const uint64_t collective_size = 1048576;
+
+std::vector<DataSet*> generate_all_reduce(SysCluster& cluster) {
+    std::vector<DataSet*> datasets;
+    std::vector<bool> involved_dimensions(1, true);
+    for (int i = 0; i < cluster.npus_count(); i++) {
+        datasets.push_back(cluster.sys(i)->generate_all_reduce(
+            collective_size, involved_dimensions, nullptr, 0));
+    }
+    return datasets;
+}
+
+void release(std::vector<DataSet*>& datasets) {
+    for (DataSet* dataset : datasets) {
+        delete dataset;
+    }
+}
+
+// Cost of Sys::generate_collective (streams, phases and the collective
+// algorithm objects) on each of range(0) NPUs. The generated collective is
+// run to completion outside the timed region.
+void BM_GenerateCollective(benchmark::State& state,
+                           const char* implementation) {
+    const int npus = state.range(0);
+    SysCluster cluster({npus}, system_configuration(implementation, 1));
+    EventCounters counters(state);
+    for (auto _ : state) {
+        std::vector<DataSet*> datasets = generate_all_reduce(cluster);
+        state.PauseTiming();
+        counters.pause();
+        cluster.run();
+        release(datasets);
+        counters.resume();
+        state.ResumeTiming();
+    }
+    counters.finish(state.iterations() * npus);
+}
+
+// End-to-end AllReduce on range(0) NPUs over the loopback network: every
+// send, receive and system event of the collective counts as one event.
+void BM_AllReduce(benchmark::State& state, const char* implementation) {
+    const int npus = state.range(0);
+    SysCluster cluster({npus}, system_configuration(implementation, 1));
+    uint64_t events = 0;
+    EventCounters counters(state);
+    for (auto _ : state) {
+        std::vector<DataSet*> datasets = generate_all_reduce(cluster);
+        events += cluster.run();
+        release(datasets);
+    }
+    counters.finish(events);
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_GenerateCollective, ring, "ring")->Arg(8)->Arg(64);
+BENCHMARK_CAPTURE(BM_GenerateCollective, direct, "direct")->Arg(8)->Arg(64);
+BENCHMARK_CAPTURE(BM_GenerateCollective, halvingDoubling, "halvingDoubling")
+    ->Arg(8)
+    ->Arg(64);
+BENCHMARK_CAPTURE(BM_GenerateCollective,
+                  doubleBinaryTree,
+                  "doubleBinaryTree")
+    ->Arg(8)
+    ->Arg(64);
+
+BENCHMARK_CAPTURE(BM_AllReduce, ring, "ring")
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(512)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AllReduce, halvingDoubling, "halvingDoubling")
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(512)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AllReduce, inNetworkReduction, "inNetworkReduction")
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(512)
+    ->Unit(benchmark::kMillisecond);
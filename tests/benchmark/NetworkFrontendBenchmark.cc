@@ -0,0 +1,73 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkHarness.hh"
+#include "common/CallbackTracker.hh"
+#include "common/ChunkIdGenerator.hh"
+
+using namespace AstraSimAnalytical;
+using namespace AstraSimBenchmark;
+
+namespace {
+
+const uint64_t chunk_size = 65536;
+
+void noop_handler(void*) {}
+
+// Chunk ids for range(0) peers on a ring, each exchanging range(1) chunks
+// with its neighbour. Every chunk costs one send and one recv lookup.
+void BM_ChunkIdGenerator(benchmark::State& state) {
+    const int peers = state.range(0);
+    const int chunks = state.range(1);
+    EventCounters counters(state);
+    for (auto _ : state) {
+        ChunkIdGenerator generator;
+        for (int chunk = 0; chunk < chunks; chunk++) {
+            for (int src = 0; src < peers; src++) {
+                int dst = (src + 1) % peers;
+                benchmark::DoNotOptimize(generator.create_send_chunk_id(
+                    chunk, src, dst, chunk_size));
+                benchmark::DoNotOptimize(generator.create_recv_chunk_id(
+                    chunk, src, dst, chunk_size));
+            }
+        }
+    }
+    counters.finish(state.iterations() * peers * chunks * 2);
+}
+
+// The CommonNetworkApi sequence for one chunk whose sim_recv() is posted
+// before the data arrives: register send, register recv, then on arrival
+// invoke both handlers and pop the entry. range(0) chunks are in flight at
+// the same time.
+void BM_CallbackTracker(benchmark::State& state) {
+    const int in_flight = state.range(0);
+    EventCounters counters(state);
+    for (auto _ : state) {
+        CallbackTracker tracker;
+        for (int chunk = 0; chunk < in_flight; chunk++) {
+            auto* entry = tracker.search_or_create_entry(chunk, 0, 1,
+                                                         chunk_size, 0);
+            entry->register_send_callback(noop_handler, nullptr);
+        }
+        for (int chunk = 0; chunk < in_flight; chunk++) {
+            auto entry = tracker.search_entry(chunk, 0, 1, chunk_size, 0);
+            entry.value()->register_recv_callback(noop_handler, nullptr);
+        }
+        for (int chunk = 0; chunk < in_flight; chunk++) {
+            auto entry = tracker.search_entry(chunk, 0, 1, chunk_size, 0);
+            entry.value()->invoke_send_handler();
+            entry.value()->invoke_recv_handler();
+            tracker.pop_entry(chunk, 0, 1, chunk_size, 0);
+        }
+    }
+    counters.finish(state.iterations() * in_flight);
+}
+
+}  // namespace
+
+BENCHMARK(BM_ChunkIdGenerator)->ArgsProduct({{8, 512}, {16, 256}});
+BENCHMARK(BM_CallbackTracker)->Arg(64)->Arg(4096)->Arg(65536);
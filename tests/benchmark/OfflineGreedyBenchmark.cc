@@ -0,0 +1,121 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <vector>
+
+#include "BenchmarkHarness.hh"
+#include "astra-sim/system/scheduling/OfflineGreedy.hh"
+
+using namespace AstraSim;
+using namespace AstraSimBenchmark;
+using namespace AstraSimTest;
+
+namespace {
+
+// 4D topology with bandwidth halving per dimension, the usual Themis setup.
+const std::vector<int> dim_size = {4, 8, 8, 16};
+const std::vector<double> dim_BW = {200, 100, 50, 25};
+const uint64_t chunk_size = 1048576;
+
+// Scheduling overhead of one collective split into range(0) chunks with
+// Themis: the schedule is computed once, then every rank indexes into it.
+void BM_ThemisSchedule(benchmark::State& state, InterDimensionScheduling sch) {
+    const uint64_t chunks = state.range(0);
+    const uint64_t ranks = state.range(1);
+    std::vector<bool> dims_involved(dim_size.size(), true);
+    OfflineGreedy offline_greedy(dim_size, dim_BW);
+    for (auto _ : state) {
+        offline_greedy.reset_loads();
+        std::shared_ptr<const CollectiveSchedule> schedule =
+            offline_greedy.compute_collective_schedule(
+                chunks * chunk_size, chunk_size, dims_involved, sch,
+                ComType::All_Reduce);
+        for (uint64_t rank = 0; rank < ranks; rank++) {
+            for (uint64_t chunk = 0; chunk < schedule->dim_order.size();
+                 chunk++) {
+                std::vector<int> dim_mapper = schedule->dim_order[chunk];
+                benchmark::DoNotOptimize(dim_mapper.data());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * chunks * ranks);
+}
+
+// Same collective with the Ascending policy, which only builds the identity
+// dimension order per chunk on every rank; the baseline for the Themis cost.
+void BM_AscendingSchedule(benchmark::State& state) {
+    const uint64_t chunks = state.range(0);
+    const uint64_t ranks = state.range(1);
+    for (auto _ : state) {
+        for (uint64_t rank = 0; rank < ranks; rank++) {
+            for (uint64_t chunk = 0; chunk < chunks; chunk++) {
+                std::vector<int> dim_mapper(dim_size.size());
+                std::iota(dim_mapper.begin(), dim_mapper.end(), 0);
+                benchmark::DoNotOptimize(dim_mapper.data());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * chunks * ranks);
+}
+
+// Shared schedule lookup as done by Sys::generate_collective. range(0)
+// collectives of range(1) ranks each are in flight at once; every rank fetches
+// all of them, so the first rank misses and computes each schedule and the
+// others hit the cached entry, which is dropped by the last one.
+void BM_ThemisScheduleCache(benchmark::State& state) {
+    const int collectives = state.range(0);
+    const int ranks = state.range(1);
+    const uint64_t chunks = 16;
+    SysCluster cluster({2, 2}, system_configuration("ring", 2));
+    // loads are tracked by the scheduler of the first Sys
+    OfflineGreedy scheduler(dim_size, dim_BW);
+    scheduler.sys = cluster.sys(0);
+    OfflineGreedy* original = cluster.sys(0)->offline_greedy;
+    cluster.sys(0)->offline_greedy = &scheduler;
+    std::vector<int> involved_NPUs(ranks);
+    std::iota(involved_NPUs.begin(), involved_NPUs.end(), 0);
+    std::shared_ptr<const RingTopology::Table> group =
+        RingTopology::get_table(involved_NPUs);
+    std::vector<bool> dims_involved(dim_size.size(), true);
+    uint64_t misses = 0;
+    for (auto _ : state) {
+        for (int rank = 0; rank < ranks; rank++) {
+            for (int collective = 0; collective < collectives; collective++) {
+                long long first_chunk_id = collective * chunks;
+                bool cached = OfflineGreedy::collective_schedule.count(
+                    OfflineGreedy::ScheduleKey(group.get(), first_chunk_id));
+                std::shared_ptr<const CollectiveSchedule> schedule =
+                    scheduler.get_collective_schedule(
+                        group.get(), first_chunk_id,
+                        chunks * chunk_size, chunk_size, dims_involved,
+                        InterDimensionScheduling::OfflineGreedy,
+                        ComType::All_Reduce);
+                benchmark::DoNotOptimize(schedule->dim_order.data());
+                misses += cached ? 0 : 1;
+            }
+        }
+    }
+    cluster.sys(0)->offline_greedy = original;
+    const uint64_t lookups = state.iterations() * collectives * ranks;
+    state.SetItemsProcessed(lookups);
+    state.counters["hit_rate"] =
+        static_cast<double>(lookups - misses) / lookups;
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_ThemisSchedule,
+                  OfflineGreedy,
+                  InterDimensionScheduling::OfflineGreedy)
+    ->ArgsProduct({{16, 256, 4096}, {64, 1024}});
+BENCHMARK_CAPTURE(BM_ThemisSchedule,
+                  OfflineGreedyFlex,
+                  InterDimensionScheduling::OfflineGreedyFlex)
+    ->ArgsProduct({{16, 256, 4096}, {64, 1024}});
+BENCHMARK(BM_AscendingSchedule)->ArgsProduct({{16, 256, 4096}, {64, 1024}});
+BENCHMARK(BM_ThemisScheduleCache)->ArgsProduct({{1, 64}, {1, 8, 1024}});
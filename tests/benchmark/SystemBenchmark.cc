@@ -0,0 +1,111 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkHarness.hh"
+#include "astra-sim/system/Callable.hh"
+#include "astra-sim/system/MemBus.hh"
+#include "astra-sim/system/SharedBusStat.hh"
+
+using namespace AstraSim;
+using namespace AstraSimBenchmark;
+using namespace AstraSimTest;
+
+namespace {
+
+class NullCallable : public Callable {
+  public:
+    void call(EventType event, CallData* data) override {}
+};
+
+// Receives LogGP completions, which hand over a SharedBusStat.
+class TransferSink : public Callable {
+  public:
+    void call(EventType event, CallData* data) override {
+        delete static_cast<SharedBusStat*>(data);
+    }
+};
+
+// Sys::try_register_event followed by Sys::call_events: range(0) events
+// spread over range(1) distinct future ticks, so both the per-tick list and
+// the tick map of the event queue are exercised.
+void BM_SysEventQueue(benchmark::State& state) {
+    const uint64_t events = state.range(0);
+    const uint64_t ticks = state.range(1);
+    SysCluster cluster({1}, system_configuration("ring", 1));
+    Sys* sys = cluster.sys(0);
+    NullCallable callable;
+    EventCounters counters(state);
+    for (auto _ : state) {
+        for (uint64_t i = 0; i < events; i++) {
+            Tick delta = 1 + i % ticks;
+            sys->try_register_event(&callable, EventType::General, nullptr,
+                                    delta);
+        }
+        cluster.run();
+    }
+    counters.finish(state.iterations() * events);
+}
+
+// range(0) transfers of range(1) bytes over a shared memory bus modelled by
+// LogGP (both directions attached, as Sys does with model-shared-bus).
+void BM_LogGPTransfer(benchmark::State& state) {
+    const uint64_t transfers = state.range(0);
+    const int bytes = state.range(1);
+    SysCluster cluster({1}, system_configuration("ring", 1));
+    Sys* sys = cluster.sys(0);
+    MemBus bus("NPU", "MA", sys, 10, 5, 5, 0.01, true, 10, true);
+    TransferSink sink;
+    EventCounters counters(state);
+    for (auto _ : state) {
+        for (uint64_t i = 0; i < transfers; i++) {
+            bus.send_from_NPU_to_MA(MemBus::Transmition::Usual, bytes, false,
+                                    false, &sink);
+        }
+        cluster.run();
+    }
+    counters.finish(state.iterations() * transfers);
+}
+
+// Whole synthetic workload on range(0) NPUs, with coalesced Sys dispatch if
+// range(1) is set. Reports the number of loopback events of one run and how
+// many of them were dispatch events; the dispatch order itself is checked by
+// SysEventTest.
+void BM_EventDispatch(benchmark::State& state, const char* workload) {
+    const int npus = state.range(0);
+    Sys::coalesce_backend_events = state.range(1) != 0;
+    uint64_t events = 0;
+    uint64_t dispatch_events = 0;
+    for (auto _ : state) {
+        SysCluster cluster({npus}, system_configuration("ring", 1), 500,
+                           workload);
+        cluster.fire();
+        events = cluster.run();
+        dispatch_events = cluster.get_network().dispatch_events;
+    }
+    Sys::coalesce_backend_events = true;
+    state.counters["backend_events"] = events;
+    state.counters["dispatch_events"] = dispatch_events;
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_EventDispatch, dp, "synthetic:dp,layers=4,iterations=2")
+    ->ArgsProduct({{8, 64}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_EventDispatch, tp_dp, "synthetic:tp_dp,tp=4,layers=4")
+    ->ArgsProduct({{16}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_EventDispatch,
+                  pipeline,
+                  "synthetic:pipeline,layers=4,microbatches=4")
+    ->ArgsProduct({{8}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SysEventQueue)->ArgsProduct({{1024, 65536}, {1, 64, 4096}});
+BENCHMARK(BM_LogGPTransfer)->ArgsProduct({{16, 1024}, {4096, 1048576}});
@@ -0,0 +1,253 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "tests/harness/LoopbackCluster.hh"
+
+#include <cstdio>
+#include <fstream>
+
+#include <unistd.h>
+
+using namespace AstraSim;
+using namespace AstraSimTest;
+
+// LoopbackNetwork
+// -----------------------------------------------------------------------------
+
+namespace {
+
+// A message in flight: delivered to the receiver after the fixed latency.
+struct Delivery {
+    LoopbackNetwork* network;
+    int src;
+    int dst;
+    int tag;
+    void (*msg_handler)(void*);
+    void* fun_arg;
+};
+
+}  // namespace
+
+LoopbackNetwork::LoopbackNetwork(Tick latency)
+    : now(0), dispatch_events(0), trace_enabled(false), latency(latency) {}
+
+void LoopbackNetwork::schedule(Tick delta,
+                               void (*fun_ptr)(void*),
+                               void* fun_arg) {
+    if (fun_ptr == &Sys::dispatch_events) {
+        dispatch_events++;
+    }
+    events[now + delta].push_back({fun_ptr, fun_arg});
+    scheduled[now + delta]++;
+}
+
+int64_t LoopbackNetwork::scheduled_events(Tick time) const {
+    auto it = scheduled.find(time);
+    return it == scheduled.end() ? 0 : it->second;
+}
+
+void LoopbackNetwork::send(int src,
+                           int dst,
+                           int tag,
+                           uint64_t count,
+                           void (*msg_handler)(void*),
+                           void* fun_arg) {
+    if (trace_enabled) {
+        trace.push_back({now, true, src, dst, tag, count});
+    }
+    schedule(latency, &LoopbackNetwork::deliver,
+             new Delivery{this, src, dst, tag, msg_handler, fun_arg});
+}
+
+void LoopbackNetwork::recv(int src,
+                           int dst,
+                           int tag,
+                           uint64_t count,
+                           void (*msg_handler)(void*),
+                           void* fun_arg) {
+    if (trace_enabled) {
+        trace.push_back({now, false, src, dst, tag, count});
+    }
+    Key key(src, dst, tag);
+    auto arrived = arrived_sends.find(key);
+    if (arrived != arrived_sends.end()) {
+        if (--arrived->second == 0) {
+            arrived_sends.erase(arrived);
+        }
+        schedule(0, msg_handler, fun_arg);
+        return;
+    }
+    posted_recvs[key].push_back({msg_handler, fun_arg});
+}
+
+void LoopbackNetwork::deliver(void* arg) {
+    Delivery* delivery = static_cast<Delivery*>(arg);
+    LoopbackNetwork* network = delivery->network;
+    (*delivery->msg_handler)(delivery->fun_arg);
+
+    Key key(delivery->src, delivery->dst, delivery->tag);
+    auto posted = network->posted_recvs.find(key);
+    if (posted != network->posted_recvs.end()) {
+        Handler handler = posted->second.front();
+        posted->second.erase(posted->second.begin());
+        if (posted->second.empty()) {
+            network->posted_recvs.erase(posted);
+        }
+        (*handler.fun_ptr)(handler.fun_arg);
+    } else {
+        network->arrived_sends[key]++;
+    }
+    delete delivery;
+}
+
+uint64_t LoopbackNetwork::run() {
+    uint64_t handled = 0;
+    while (!events.empty()) {
+        auto it = events.begin();
+        now = it->first;
+        scheduled.erase(scheduled.begin(), scheduled.lower_bound(now));
+        std::vector<Handler> handlers = std::move(it->second);
+        events.erase(it);
+        for (const Handler& handler : handlers) {
+            (*handler.fun_ptr)(handler.fun_arg);
+        }
+        handled += handlers.size();
+    }
+    return handled;
+}
+
+// LoopbackNetworkApi
+// -----------------------------------------------------------------------------
+
+LoopbackNetworkApi::LoopbackNetworkApi(int rank, LoopbackNetwork* network)
+    : AstraNetworkAPI(rank), finish_tick(0), network(network) {}
+
+int LoopbackNetworkApi::sim_send(void* buffer,
+                                 uint64_t count,
+                                 int type,
+                                 int dst,
+                                 int tag,
+                                 sim_request* request,
+                                 void (*msg_handler)(void* fun_arg),
+                                 void* fun_arg) {
+    network->send(sim_comm_get_rank(), dst, tag, count, msg_handler,
+                  fun_arg);
+    return 0;
+}
+
+int LoopbackNetworkApi::sim_recv(void* buffer,
+                                 uint64_t count,
+                                 int type,
+                                 int src,
+                                 int tag,
+                                 sim_request* request,
+                                 void (*msg_handler)(void* fun_arg),
+                                 void* fun_arg) {
+    network->recv(src, sim_comm_get_rank(), tag, count, msg_handler,
+                  fun_arg);
+    return 0;
+}
+
+void LoopbackNetworkApi::sim_schedule(timespec_t delta,
+                                      void (*fun_ptr)(void* fun_arg),
+                                      void* fun_arg) {
+    sim_schedule_ns(timespec_to_ns(delta), fun_ptr, fun_arg);
+}
+
+void LoopbackNetworkApi::sim_schedule_ns(Tick delta,
+                                         void (*fun_ptr)(void* fun_arg),
+                                         void* fun_arg) {
+    network->schedule(delta, fun_ptr, fun_arg);
+}
+
+int64_t LoopbackNetworkApi::sim_scheduled_events_ns(Tick time_ns) {
+    return network->scheduled_events(time_ns);
+}
+
+timespec_t LoopbackNetworkApi::sim_get_time() {
+    return ns_to_timespec(sim_get_time_ns());
+}
+
+Tick LoopbackNetworkApi::sim_get_time_ns() {
+    return network->now;
+}
+
+void LoopbackNetworkApi::sim_notify_finished() {
+    finish_tick = network->now;
+}
+
+// SysCluster
+// -----------------------------------------------------------------------------
+
+SysCluster::SysCluster(const std::vector<int>& physical_dims,
+                       const std::string& system_configuration,
+                       Tick latency,
+                       const std::string& workload)
+    : network(latency) {
+    char path[] = "/tmp/astrasim_benchmark_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        Sys::sys_panic("unable to create the benchmark system configuration");
+    }
+    close(fd);
+    std::ofstream(path) << system_configuration;
+
+    int npus_count = 1;
+    for (int dim : physical_dims) {
+        npus_count *= dim;
+    }
+    std::vector<int> queues_per_dim(physical_dims.size(), 1);
+    for (int i = 0; i < npus_count; i++) {
+        network_apis.push_back(
+            std::make_unique<LoopbackNetworkApi>(i, &network));
+        systems.push_back(new Sys(i, workload, "empty", path, &remote_memory,
+                                  network_apis.back().get(), physical_dims,
+                                  queues_per_dim, 1.0, 1.0, false));
+    }
+    std::remove(path);
+}
+
+void SysCluster::fire() {
+    for (Sys* sys : systems) {
+        sys->workload->fire();
+    }
+}
+
+SysCluster::~SysCluster() {
+    for (Sys* sys : systems) {
+        delete sys;
+    }
+}
+
+std::string AstraSimTest::system_configuration(
+    const std::string& implementation,
+    int dims_count) {
+    std::string implementations = "[";
+    for (int i = 0; i < dims_count; i++) {
+        implementations += (i == 0 ? "\"" : ", \"") + implementation + "\"";
+    }
+    implementations += "]";
+    return "{\n"
+           "    \"scheduling-policy\": \"LIFO\",\n"
+           "    \"endpoint-delay\": 10,\n"
+           "    \"active-chunks-per-dimension\": 1,\n"
+           "    \"preferred-dataset-splits\": 4,\n"
+           "    \"all-reduce-implementation\": " +
+           implementations +
+           ",\n"
+           "    \"all-gather-implementation\": " +
+           implementations +
+           ",\n"
+           "    \"reduce-scatter-implementation\": " +
+           implementations +
+           ",\n"
+           "    \"all-to-all-implementation\": " +
+           implementations +
+           ",\n"
+           "    \"collective-optimization\": \"localBWAware\",\n"
+           "    \"local-mem-bw\": 50,\n"
+           "    \"boost-mode\": 0\n"
+           "}\n";
+}
@@ -0,0 +1,178 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#ifndef __LOOPBACK_CLUSTER_HH__
+#define __LOOPBACK_CLUSTER_HH__
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "astra-sim/common/AstraNetworkAPI.hh"
+#include "astra-sim/system/AstraRemoteMemoryAPI.hh"
+#include "astra-sim/system/Sys.hh"
+
+// Sys instances on a loopback network, shared by the tests under tests/unit
+// and the microbenchmarks under tests/benchmark.
+namespace AstraSimTest {
+
+// Shared event loop of the loopback network: a fixed-latency, infinite
+// bandwidth fabric that only matches sends with receives. It adds almost no
+// cost of its own, so the benchmarks measure the system layer.
+class LoopbackNetwork {
+  public:
+    // A send or receive posted to the network, as recorded in the trace.
+    struct Message {
+        AstraSim::Tick tick;
+        bool send;
+        int src;
+        int dst;
+        int tag;
+        uint64_t count;
+        bool operator==(const Message& other) const {
+            return tick == other.tick && send == other.send &&
+                   src == other.src && dst == other.dst && tag == other.tag &&
+                   count == other.count;
+        }
+    };
+
+    explicit LoopbackNetwork(AstraSim::Tick latency);
+
+    void schedule(AstraSim::Tick delta, void (*fun_ptr)(void*), void* fun_arg);
+    // number of events scheduled so far for the absolute tick `time`
+    int64_t scheduled_events(AstraSim::Tick time) const;
+    void send(int src,
+              int dst,
+              int tag,
+              uint64_t count,
+              void (*msg_handler)(void*),
+              void* fun_arg);
+    void recv(int src,
+              int dst,
+              int tag,
+              uint64_t count,
+              void (*msg_handler)(void*),
+              void* fun_arg);
+
+    // Runs until no event is left; returns the number of events handled.
+    uint64_t run();
+
+    AstraSim::Tick now;
+    // events scheduled for Sys::dispatch_events, i.e. backend events spent on
+    // waking up Sys event queues
+    uint64_t dispatch_events;
+    // every send and receive in the order they were posted, when enabled
+    bool trace_enabled;
+    std::vector<Message> trace;
+
+  private:
+    struct Handler {
+        void (*fun_ptr)(void*);
+        void* fun_arg;
+    };
+    using Key = std::tuple<int, int, int>;
+
+    static void deliver(void* arg);
+
+    AstraSim::Tick latency;
+    std::map<AstraSim::Tick, std::vector<Handler>> events;
+    // per tick count of scheduled events, kept until the tick has passed
+    std::map<AstraSim::Tick, int64_t> scheduled;
+    std::map<Key, std::vector<Handler>> posted_recvs;
+    std::map<Key, uint64_t> arrived_sends;
+};
+
+class LoopbackNetworkApi : public AstraSim::AstraNetworkAPI {
+  public:
+    LoopbackNetworkApi(int rank, LoopbackNetwork* network);
+
+    int sim_send(void* buffer,
+                 uint64_t count,
+                 int type,
+                 int dst,
+                 int tag,
+                 AstraSim::sim_request* request,
+                 void (*msg_handler)(void* fun_arg),
+                 void* fun_arg) override;
+    int sim_recv(void* buffer,
+                 uint64_t count,
+                 int type,
+                 int src,
+                 int tag,
+                 AstraSim::sim_request* request,
+                 void (*msg_handler)(void* fun_arg),
+                 void* fun_arg) override;
+    void sim_schedule(AstraSim::timespec_t delta,
+                      void (*fun_ptr)(void* fun_arg),
+                      void* fun_arg) override;
+    void sim_schedule_ns(AstraSim::Tick delta,
+                         void (*fun_ptr)(void* fun_arg),
+                         void* fun_arg) override;
+    int64_t sim_scheduled_events_ns(AstraSim::Tick time_ns) override;
+    AstraSim::timespec_t sim_get_time() override;
+    AstraSim::Tick sim_get_time_ns() override;
+    void sim_notify_finished() override;
+
+    // tick at which the workload of this rank finished
+    AstraSim::Tick finish_tick;
+
+  private:
+    LoopbackNetwork* network;
+};
+
+class NullRemoteMemory : public AstraSim::AstraRemoteMemoryAPI {
+  public:
+    void set_sys(int id, AstraSim::Sys* sys) override {}
+    void issue(uint64_t tensor_size,
+               AstraSim::WorkloadLayerHandlerData* wlhd) override {}
+};
+
+// A set of Sys instances on one loopback network. The system configuration
+// is a JSON object; it is written to a temporary file for Sys to parse. The
+// workload is only run if fire() is called.
+class SysCluster {
+  public:
+    SysCluster(const std::vector<int>& physical_dims,
+               const std::string& system_configuration,
+               AstraSim::Tick latency = 500,
+               const std::string& workload = "synthetic:dp,layers=1");
+    ~SysCluster();
+
+    AstraSim::Sys* sys(int id) {
+        return systems[id];
+    }
+    int npus_count() const {
+        return static_cast<int>(systems.size());
+    }
+    uint64_t run() {
+        return network.run();
+    }
+    // starts the workload of every NPU
+    void fire();
+    AstraSim::Tick finish_tick(int id) const {
+        return network_apis[id]->finish_tick;
+    }
+    LoopbackNetwork& get_network() {
+        return network;
+    }
+
+  private:
+    LoopbackNetwork network;
+    NullRemoteMemory remote_memory;
+    std::vector<std::unique_ptr<LoopbackNetworkApi>> network_apis;
+    std::vector<AstraSim::Sys*> systems;
+};
+
+// System configuration JSON using `implementation` for every collective on
+// every dimension.
+std::string system_configuration(const std::string& implementation,
+                                  int dims_count);
+
+}  // namespace AstraSimTest
+
+#endif /* __LOOPBACK_CLUSTER_HH__ */
@@ -0,0 +1,81 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "astra-sim/system/Checkpoint.hh"
+#include "tests/harness/LoopbackCluster.hh"
+
+using namespace AstraSim;
+using namespace AstraSimTest;
+
+namespace {
+
+const char* const workload = "synthetic:dp,layers=1";
+const Tick checkpoint_tick = 1000;
+
+void advance_clock(void* arg) {}
+
+std::vector<Sys*> systems_of(SysCluster& cluster) {
+    std::vector<Sys*> systems;
+    for (int i = 0; i < cluster.npus_count(); i++) {
+        systems.push_back(cluster.sys(i));
+    }
+    return systems;
+}
+
+// The iteration tracking feeds the fast-forward projection, which starts
+// from the last iteration boundary, so it has to survive a restore.
+TEST(CheckpointTest, RestoresIterationTracking) {
+    char path[] = "/tmp/astrasim_checkpoint_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    {
+        SysCluster cluster({2}, system_configuration("ring", 1));
+        cluster.get_network().schedule(checkpoint_tick, &advance_clock,
+                                       nullptr);
+        cluster.run();
+        for (int i = 0; i < cluster.npus_count(); i++) {
+            Workload* saved = cluster.sys(i)->workload;
+            saved->completed_iterations = 3 + i;
+            saved->total_iterations = 10;
+            saved->last_boundary_tick = 900;
+            saved->last_boundary_tics_gpu_ops = 40;
+            saved->recent_iteration_ticks = {100, 110};
+            saved->recent_exposed_comm_ticks = {20, 30};
+            saved->steady = true;
+        }
+        Checkpoint::save(path, systems_of(cluster), workload);
+    }
+
+    SysCluster cluster({2}, system_configuration("ring", 1));
+    cluster.get_network().schedule(checkpoint_tick, &advance_clock, nullptr);
+    cluster.run();
+    Checkpoint(path).restore(systems_of(cluster), workload);
+    std::remove(path);
+    for (int i = 0; i < cluster.npus_count(); i++) {
+        Workload* restored = cluster.sys(i)->workload;
+        EXPECT_EQ(restored->completed_iterations, 3u + i);
+        EXPECT_EQ(restored->total_iterations, 10u);
+        EXPECT_EQ(restored->last_boundary_tick, 900u);
+        EXPECT_EQ(restored->last_boundary_tics_gpu_ops, 40u);
+        EXPECT_EQ(restored->recent_iteration_ticks,
+                  std::deque<Tick>({100, 110}));
+        EXPECT_EQ(restored->recent_exposed_comm_ticks,
+                  std::deque<Tick>({20, 30}));
+        EXPECT_TRUE(restored->steady);
+    }
+    cluster.run();
+}
+
+}  // namespace
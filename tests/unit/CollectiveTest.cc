@@ -0,0 +1,178 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "astra-sim/system/DataSet.hh"
+#include "tests/harness/LoopbackCluster.hh"
+
+using namespace AstraSim;
+using namespace AstraSimTest;
+
+namespace {
+
+const uint64_t collective_size = 1048576;
+
+// AllReduce issued on every NPU at the current tick.
+std::vector<DataSet*> generate_all_reduce(SysCluster& cluster) {
+    std::vector<DataSet*> datasets;
+    std::vector<bool> involved_dimensions(1, true);
+    for (int i = 0; i < cluster.npus_count(); i++) {
+        datasets.push_back(cluster.sys(i)->generate_all_reduce(
+            collective_size, involved_dimensions, nullptr, 0));
+    }
+    return datasets;
+}
+
+void release(std::vector<DataSet*>& datasets) {
+    for (DataSet* dataset : datasets) {
+        delete dataset;
+    }
+}
+
+// AllReduce of one NPU, issued later by the loopback network.
+struct LateAllReduce {
+    Sys* sys;
+    DataSet** dataset;
+
+    static void issue(void* arg) {
+        LateAllReduce* late = static_cast<LateAllReduce*>(arg);
+        *late->dataset = late->sys->generate_all_reduce(
+            collective_size, std::vector<bool>(1, true), nullptr, 0);
+    }
+};
+
+class AllReduceTest : public testing::TestWithParam<std::string> {};
+
+TEST_P(AllReduceTest, FinishesOnEveryNpu) {
+    SysCluster cluster({8}, system_configuration(GetParam(), 1));
+    std::vector<DataSet*> datasets = generate_all_reduce(cluster);
+    cluster.run();
+    for (DataSet* dataset : datasets) {
+        EXPECT_TRUE(dataset->is_finished());
+    }
+    release(datasets);
+}
+
+INSTANTIATE_TEST_SUITE_P(Implementations,
+                         AllReduceTest,
+                         testing::Values("ring",
+                                         "direct",
+                                         "halvingDoubling",
+                                         "doubleBinaryTree",
+                                         "pipelinedRing",
+                                         "pipelinedDoubleBinaryTree",
+                                         "inNetworkReduction"),
+                         [](const testing::TestParamInfo<std::string>& info) {
+                             return info.param;
+                         });
+
+// The last NPU joins late: the switch has to hold the result back until the
+// late input arrived, and every NPU sends the collective size exactly once,
+// to its ring neighbour, so no NPU's links carry another member's data.
+TEST(InNetworkReductionTest, WaitsForSlowestMember) {
+    const int npus = 8;
+    const Tick latency = 500;
+    const Tick late_start = 1000000;
+    SysCluster cluster({npus}, system_configuration("inNetworkReduction", 1),
+                       latency);
+    LoopbackNetwork& network = cluster.get_network();
+    std::vector<DataSet*> datasets(npus, nullptr);
+    std::vector<bool> involved_dimensions(1, true);
+    for (int i = 0; i < npus - 1; i++) {
+        datasets[i] = cluster.sys(i)->generate_all_reduce(
+            collective_size, involved_dimensions, nullptr, 0);
+    }
+    LateAllReduce late{cluster.sys(npus - 1), &datasets[npus - 1]};
+    network.trace_enabled = true;
+    network.schedule(late_start, &LateAllReduce::issue, &late);
+    cluster.run();
+
+    std::map<std::pair<int, int>, uint64_t> link_bytes;
+    for (const LoopbackNetwork::Message& message : network.trace) {
+        if (message.send) {
+            link_bytes[{message.src, message.dst}] += message.count;
+        }
+    }
+    EXPECT_EQ(link_bytes.size(), static_cast<size_t>(npus));
+    for (int i = 0; i < npus; i++) {
+        EXPECT_EQ(link_bytes[std::make_pair(i, (i + 1) % npus)],
+                  collective_size);
+    }
+    for (DataSet* dataset : datasets) {
+        ASSERT_TRUE(dataset->is_finished());
+        EXPECT_GE(dataset->finish_tick, late_start + latency);
+    }
+    release(datasets);
+}
+
+// Finish tick of the AllReduce on every NPU.
+std::vector<Tick> all_reduce_finish_ticks(
+    const std::string& system_configuration) {
+    SysCluster cluster({8}, system_configuration);
+    std::vector<DataSet*> datasets = generate_all_reduce(cluster);
+    cluster.run();
+    std::vector<Tick> finish_ticks;
+    for (DataSet* dataset : datasets) {
+        finish_ticks.push_back(dataset->finish_tick);
+    }
+    release(datasets);
+    return finish_ticks;
+}
+
+Tick all_reduce_finish_tick(const std::string& implementation) {
+    std::vector<Tick> finish_ticks =
+        all_reduce_finish_ticks(system_configuration(implementation, 1));
+    return *std::max_element(finish_ticks.begin(), finish_ticks.end());
+}
+
+// One pass through the switch instead of 2(N-1) ring steps.
+TEST(InNetworkReductionTest, FinishesBeforeRing) {
+    EXPECT_LT(all_reduce_finish_tick("inNetworkReduction"),
+              all_reduce_finish_tick("ring"));
+}
+
+// system_configuration() with collective-slice-bytes set.
+std::string sliced_configuration(const std::string& implementation,
+                                 uint64_t slice_bytes) {
+    return "{\n    \"collective-slice-bytes\": " +
+           std::to_string(slice_bytes) + "," +
+           system_configuration(implementation, 1).substr(1);
+}
+
+// With one slice per block, PipelinedRing sends the same messages at the same
+// ticks as Ring.
+TEST(PipelinedCollectiveTest, UnslicedRingMatchesRing) {
+    EXPECT_EQ(all_reduce_finish_ticks(
+                  sliced_configuration("pipelinedRing", collective_size)),
+              all_reduce_finish_ticks(system_configuration("ring", 1)));
+}
+
+// A slice is forwarded as soon as it is processed, so slices smaller than
+// the per-step block overlap the steps. PipelinedTreeAllReduce does not
+// model DoubleBinaryTree's memory bus transfers, so unsliced it is only
+// compared with itself.
+TEST(PipelinedCollectiveTest, SlicingOverlapsSteps) {
+    const uint64_t slice_bytes = 16384;
+    for (const std::string implementation :
+         {"pipelinedRing", "pipelinedDoubleBinaryTree"}) {
+        std::vector<Tick> unsliced = all_reduce_finish_ticks(
+            sliced_configuration(implementation, collective_size));
+        std::vector<Tick> sliced = all_reduce_finish_ticks(
+            sliced_configuration(implementation, slice_bytes));
+        EXPECT_LT(*std::max_element(sliced.begin(), sliced.end()),
+                  *std::max_element(unsliced.begin(), unsliced.end()))
+            << implementation;
+    }
+}
+
+}  // namespace
@@ -0,0 +1,32 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+#include "astra-sim/system/CommunicatorGroup.hh"
+#include "tests/harness/LoopbackCluster.hh"
+
+using namespace AstraSim;
+using namespace AstraSimTest;
+
+namespace {
+
+const int last_group_id =
+    std::numeric_limits<int>::max() / CommunicatorGroup::streams_per_group - 1;
+
+// The stream id block of the largest group id still fits in an int.
+TEST(CommunicatorGroupTest, LastGroupIdGetsItsStreamIds) {
+    SysCluster cluster({2}, system_configuration("ring", 1));
+    CommunicatorGroup group(last_group_id, {0, 1}, cluster.sys(0));
+    EXPECT_EQ(group.next_stream_id(),
+              last_group_id * CommunicatorGroup::streams_per_group);
+    EXPECT_EQ(group.next_stream_id(),
+              last_group_id * CommunicatorGroup::streams_per_group + 1);
+}
+
+}  // namespace
@@ -0,0 +1,53 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "astra-sim/system/scheduling/OfflineGreedy.hh"
+#include "tests/harness/LoopbackCluster.hh"
+
+using namespace AstraSim;
+using namespace AstraSimTest;
+
+namespace {
+
+// The first rank computes the shared schedule and the last one drops it.
+TEST(OfflineGreedyTest, ScheduleCacheIsReleasedByLastRank) {
+    const std::vector<int> dim_size = {2, 2};
+    const std::vector<double> dim_BW = {200, 100};
+    const uint64_t chunk_size = 1048576;
+    const int ranks = 4;
+    SysCluster cluster({2, 2}, system_configuration("ring", 2));
+    // loads are tracked by the scheduler of the first Sys
+    OfflineGreedy scheduler(dim_size, dim_BW);
+    scheduler.sys = cluster.sys(0);
+    OfflineGreedy* original = cluster.sys(0)->offline_greedy;
+    cluster.sys(0)->offline_greedy = &scheduler;
+    std::vector<int> involved_NPUs(ranks);
+    std::iota(involved_NPUs.begin(), involved_NPUs.end(), 0);
+    std::shared_ptr<const RingTopology::Table> group =
+        RingTopology::get_table(involved_NPUs);
+    std::vector<bool> dims_involved(dim_size.size(), true);
+    std::shared_ptr<const CollectiveSchedule> first;
+    for (int rank = 0; rank < ranks; rank++) {
+        std::shared_ptr<const CollectiveSchedule> schedule =
+            scheduler.get_collective_schedule(
+                group.get(), 0, 4 * chunk_size, chunk_size, dims_involved,
+                InterDimensionScheduling::OfflineGreedy, ComType::All_Reduce);
+        if (rank == 0) {
+            first = schedule;
+        }
+        EXPECT_EQ(schedule, first);
+        EXPECT_EQ(OfflineGreedy::collective_schedule.empty(),
+                  rank == ranks - 1);
+    }
+    cluster.sys(0)->offline_greedy = original;
+}
+
+}  // namespace
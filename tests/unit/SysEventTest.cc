@@ -0,0 +1,102 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "astra-sim/system/Callable.hh"
+#include "astra-sim/system/MemBus.hh"
+#include "astra-sim/system/SharedBusStat.hh"
+#include "tests/harness/LoopbackCluster.hh"
+
+using namespace AstraSim;
+using namespace AstraSimTest;
+
+namespace {
+
+// Counts LogGP completions, which hand over a SharedBusStat.
+class TransferSink : public Callable {
+  public:
+    void call(EventType event, CallData* data) override {
+        delete static_cast<SharedBusStat*>(data);
+        finished++;
+    }
+    uint64_t finished = 0;
+};
+
+TEST(SysEventTest, EveryLogGPTransferFinishes) {
+    SysCluster cluster({1}, system_configuration("ring", 1));
+    MemBus bus("NPU", "MA", cluster.sys(0), 10, 5, 5, 0.01, true, 10, true);
+    TransferSink sink;
+    for (int i = 0; i < 64; i++) {
+        bus.send_from_NPU_to_MA(MemBus::Transmition::Usual, 4096, false, false,
+                                &sink);
+    }
+    cluster.run();
+    EXPECT_EQ(sink.finished, 64u);
+}
+
+// Outcome of one run of a workload on the loopback network.
+struct WorkloadRun {
+    std::vector<Tick> finish_ticks;
+    std::vector<LoopbackNetwork::Message> trace;
+};
+
+WorkloadRun run_workload(const std::string& workload,
+                         int npus,
+                         bool coalesce_backend_events) {
+    Sys::coalesce_backend_events = coalesce_backend_events;
+    WorkloadRun result;
+    {
+        SysCluster cluster({npus}, system_configuration("ring", 1), 500,
+                           workload);
+        cluster.get_network().trace_enabled = true;
+        cluster.fire();
+        cluster.run();
+        for (int i = 0; i < npus; i++) {
+            result.finish_ticks.push_back(cluster.finish_tick(i));
+        }
+        result.trace = std::move(cluster.get_network().trace);
+    }
+    Sys::coalesce_backend_events = true;
+    return result;
+}
+
+struct DispatchCase {
+    const char* name;
+    const char* workload;
+    int npus;
+};
+
+class EventDispatchTest : public testing::TestWithParam<DispatchCase> {};
+
+// Coalesced dispatch must issue the same sends and receives, in the same
+// order, and finish every NPU at the same tick as one backend event per Sys
+// and tick.
+TEST_P(EventDispatchTest, KeepsReferenceOrder) {
+    const DispatchCase& param = GetParam();
+    const WorkloadRun reference =
+        run_workload(param.workload, param.npus, false);
+    const WorkloadRun coalesced = run_workload(param.workload, param.npus, true);
+    ASSERT_GT(reference.finish_ticks.back(), 0u);
+    EXPECT_EQ(coalesced.finish_ticks, reference.finish_ticks);
+    EXPECT_TRUE(coalesced.trace == reference.trace);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Workloads,
+    EventDispatchTest,
+    testing::Values(
+        DispatchCase{"dp", "synthetic:dp,layers=4,iterations=2", 8},
+        DispatchCase{"tp_dp", "synthetic:tp_dp,tp=4,layers=4", 16},
+        DispatchCase{"pipeline", "synthetic:pipeline,layers=4,microbatches=4",
+                     8}),
+    [](const testing::TestParamInfo<DispatchCase>& info) {
+        return std::string(info.param.name);
+    });
+
+}  // namespace
@@ -0,0 +1,200 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "astra-sim/workload/TextWorkload.hh"
+#include "protoio.hh"
+#include "tests/harness/LoopbackCluster.hh"
+
+using namespace AstraSim;
+using namespace AstraSimTest;
+
+namespace {
+
+using Node = ChakraProtoMsg::Node;
+using Nodes = std::map<uint64_t, std::shared_ptr<Node>>;
+
+// Shipped examples in a parallelism TextWorkload supports.
+const std::vector<std::string> examples = {
+    "microAllReduce",
+    "microAllToAll",
+    "Resnet50_DataParallel",
+    "MLP_ModelParallel",
+    "MLP_HybridParallel_Data_Model",
+    "MLP_HybridParallel_Model_Data",
+    "DLRM_HybridParallel",
+};
+
+std::string example_path(const std::string& example) {
+    return std::string(ASTRASIM_SOURCE_DIR) +
+           "/examples/text_converter/text_workloads/" + example + ".txt";
+}
+
+// Graph of one NPU, built by TextWorkload on a two-dimensional topology.
+Nodes text_workload_nodes(const std::string& example) {
+    TextWorkload text(example_path(example), 2);
+    std::unique_ptr<InMemoryGraphFeeder> feeder(text.generate());
+    Nodes nodes;
+    for (uint64_t id = 0;; id++) {
+        auto node = feeder->lookupNode(id);
+        if (node == nullptr) {
+            break;
+        }
+        nodes[id] = node->getChakraNode();
+    }
+    return nodes;
+}
+
+// Graph of one NPU as written by the Chakra text converter.
+Nodes converter_nodes(const std::string& path) {
+    ProtoInputStream input(path);
+    ChakraProtoMsg::GlobalMetadata metadata;
+    Nodes nodes;
+    if (!input.read(metadata)) {
+        return nodes;
+    }
+    while (true) {
+        auto node = std::make_shared<Node>();
+        if (!input.read(*node)) {
+            break;
+        }
+        nodes[node->id()] = node;
+    }
+    return nodes;
+}
+
+const ChakraProtoMsg::AttributeProto* find_attribute(const Node& node,
+                                                     const std::string& name) {
+    for (const auto& attr : node.attr()) {
+        if (attr.name() == name) {
+            return &attr;
+        }
+    }
+    return nullptr;
+}
+
+int64_t integer_attribute(const Node& node, const std::string& name) {
+    const ChakraProtoMsg::AttributeProto* attr = find_attribute(node, name);
+    if (attr == nullptr) {
+        return -1;
+    }
+    if (attr->has_uint64_val()) {
+        return static_cast<int64_t>(attr->uint64_val());
+    }
+    return attr->int64_val();
+}
+
+// The converter emits a node for a zero-size communication; TextWorkload
+// makes its children depend on the parent instead.
+bool dropped_by_text_workload(const Node& node) {
+    return node.type() == ChakraProtoMsg::COMM_COLL_NODE &&
+           integer_attribute(node, "comm_size") == 0 &&
+           node.data_deps_size() == 1;
+}
+
+// Maps every converter node to the TextWorkload node id it corresponds to.
+std::map<uint64_t, uint64_t> match_converter_nodes(const Nodes& converted) {
+    std::map<uint64_t, uint64_t> matched;
+    uint64_t next_id = 0;
+    for (const auto& [id, node] : converted) {
+        if (dropped_by_text_workload(*node)) {
+            matched[id] = matched.at(node->data_deps(0));
+        } else {
+            matched[id] = next_id++;
+        }
+    }
+    return matched;
+}
+
+std::set<uint64_t> dependencies(const Node& node) {
+    return std::set<uint64_t>(node.data_deps().begin(),
+                              node.data_deps().end());
+}
+
+TEST(TextWorkloadTest, ExamplesFormValidGraphs) {
+    for (const std::string& example : examples) {
+        SCOPED_TRACE(example);
+        Nodes nodes = text_workload_nodes(example);
+        ASSERT_FALSE(nodes.empty());
+        for (const auto& [id, node] : nodes) {
+            // parents come first and every edge is added once
+            EXPECT_EQ(dependencies(*node).size(), node->data_deps_size())
+                << node->name();
+            for (uint64_t dep : node->data_deps()) {
+                EXPECT_LT(dep, id) << node->name();
+            }
+        }
+    }
+}
+
+TEST(TextWorkloadTest, ExamplesRunToCompletion) {
+    for (const std::string& example : examples) {
+        SCOPED_TRACE(example);
+        SysCluster cluster({2, 4}, system_configuration("ring", 2), 500,
+                           TextWorkload::prefix + example_path(example));
+        cluster.fire();
+        cluster.run();
+        for (int i = 0; i < cluster.npus_count(); i++) {
+            EXPECT_GT(cluster.finish_tick(i), 0u) << "NPU " << i;
+        }
+    }
+}
+
+// Compares with the output of
+//   chakra_converter Text --input=<example>.txt --output=<dir>/<example>
+//       --num-npus=8 --num-passes=1
+// for every example, where <dir> is given by ASTRASIM_TEXT_CONVERTER_OUTPUT.
+// involved_dim is not compared: TextWorkload restricts it to the dimensions
+// of each hybrid parallelism, the converter does not.
+TEST(TextWorkloadTest, MatchesTextConverter) {
+    const char* output = std::getenv("ASTRASIM_TEXT_CONVERTER_OUTPUT");
+    if (output == nullptr) {
+        GTEST_SKIP() << "ASTRASIM_TEXT_CONVERTER_OUTPUT is not set";
+    }
+    for (const std::string& example : examples) {
+        SCOPED_TRACE(example);
+        Nodes converted =
+            converter_nodes(std::string(output) + "/" + example + ".0.et");
+        ASSERT_FALSE(converted.empty());
+        Nodes nodes = text_workload_nodes(example);
+        std::map<uint64_t, uint64_t> matched = match_converter_nodes(converted);
+        uint64_t compared = 0;
+        for (const auto& [id, expected] : converted) {
+            if (dropped_by_text_workload(*expected)) {
+                continue;
+            }
+            auto it = nodes.find(matched.at(id));
+            ASSERT_NE(it, nodes.end()) << expected->name();
+            const Node& node = *it->second;
+            compared++;
+            EXPECT_EQ(node.name(), expected->name());
+            EXPECT_EQ(node.type(), expected->type()) << expected->name();
+            EXPECT_EQ(node.duration_micros(), expected->duration_micros())
+                << expected->name();
+            EXPECT_EQ(integer_attribute(node, "comm_type"),
+                      integer_attribute(*expected, "comm_type"))
+                << expected->name();
+            EXPECT_EQ(integer_attribute(node, "comm_size"),
+                      integer_attribute(*expected, "comm_size"))
+                << expected->name();
+            std::set<uint64_t> expected_deps;
+            for (uint64_t dep : expected->data_deps()) {
+                expected_deps.insert(matched.at(dep));
+            }
+            EXPECT_EQ(dependencies(node), expected_deps) << expected->name();
+        }
+        EXPECT_EQ(compared, nodes.size());
+    }
+}
+
+}  // namespace